@@ -1,7 +1,18 @@
 #include "EngineMinimal.hpp"
+#include "debug/Profiler.hpp"
+#include "core/Metrics.hpp"
+#include "core/FrameArena.hpp"
+#include "core/Replay.hpp"
+#include "world/WorldOrigin.hpp"
 #include <thread>
 #include <chrono>
 #include <string>
+#include <algorithm>
+
+namespace {
+    // Keys 1-9 pick a slot on the page that holds the current selection
+    constexpr int MENU_PAGE_SIZE = 9;
+}
 
 Engine::Engine()
     : m_running(false)
@@ -19,7 +30,10 @@ Engine::Engine()
     , m_cities(std::make_unique<SiberianCities>())
     , m_renderer(nullptr)
     , m_menuSelectedSlot(0)
+    , m_activeSlot(-1)
     , m_selectedCityIndex(0)
+    , m_captureKeyDown(false)
+    , m_originListener(0)
 {
 }
 
@@ -34,6 +48,7 @@ bool Engine::Initialize() {
         m_startTime = std::chrono::steady_clock::now();
         m_lastTime = 0.0f;
         m_running = true;
+        Metrics::StartDump();
         Logger::Log("Engine initialized successfully");
         return true;
     } catch (const std::exception& e) {
@@ -55,20 +70,31 @@ void Engine::InitializeSystems() {
     m_cities->Load();
     UpdateLoadingProgress(0.4f);
 
-    // Terrain
+    // Новая сессия начинается в начале координат мира; при воспроизведении переносы повторятся так же
+    WorldOrigin::Reset();
+
+    // Terrain: рельеф от зерна сессии, чтобы запись воспроизводилась на том же ландшафте
     m_terrain = std::make_unique<Terrain>();
-    m_terrain->Initialize();
+    m_terrain->Initialize(Replay::GetSeed());
     UpdateLoadingProgress(0.6f);
 
     // Character
     m_character = std::make_unique<CharacterController>();
     m_character->Initialize();
+    m_character->SetTerrain(m_terrain.get());
+    // Перенос начала координат сдвигает всё, что хранит локальные позиции; камера следует за персонажем
+    m_originListener = WorldOrigin::AddListener([this](const Vector3& shift) {
+        if (m_character) m_character->ShiftOrigin(shift);
+        if (m_terrain) m_terrain->ShiftOrigin(shift);
+    });
     UpdateLoadingProgress(0.8f);
 
-    // Renderer
-    m_renderer = std::make_unique<Renderer>();
-    if (!m_renderer->Initialize()) {
-        Logger::Error("Failed to initialize renderer");
+    // Renderer; a session replay runs headless
+    if (!Replay::IsReplaying()) {
+        m_renderer = std::make_unique<Renderer>();
+        if (!m_renderer->Initialize()) {
+            Logger::Error("Failed to initialize renderer");
+        }
     }
     UpdateLoadingProgress(1.0f);
 
@@ -92,18 +118,14 @@ void Engine::CompleteLoading() {
 
 void Engine::EnterWorldCreationFromSlot(int slotIndex) {
     // Lazy create slot if not exist yet
-    auto slot = m_worldSlots.GetSlot(slotIndex);
-    if (!slot.used) {
+    if (!m_worldSlots.IsSlotUsed(slotIndex)) {
         std::string name = "World Slot " + std::to_string(slotIndex + 1);
         m_worldSlots.CreateSlot(slotIndex, name);
-        slot.worldName = name;
-        slot.used = true;
     }
-    m_worldSettings = WorldConfig::WorldSettings(slot.worldName, slot.mapSize, slot.terrainType, slot.climateType, slot.season, slot.cityDensity, slot.waterLevel, slot.mountainHeight, slot.generateRoads, slot.generateVegetation, slot.seed, slot.scale);
-    // Fallback: if constructor above doesn't exist, just set basics
-    m_worldSettings.worldName = slot.worldName;
-    m_worldSettings.scale = slot.scale;
-    m_worldSettings.seed = slot.seed;
+    // The catalog keeps the full settings, nothing else to load here
+    m_worldSettings = m_worldSlots.GetSlot(slotIndex).settings;
+    m_menuSelectedSlot = slotIndex;
+    m_activeSlot = slotIndex;
     m_state = State::WORLD_CREATION;
     Logger::Log("World creation started for slot ", slotIndex + 1);
 }
@@ -111,12 +133,16 @@ void Engine::EnterWorldCreationFromSlot(int slotIndex) {
 void Engine::EnterWorldCreation() {
     m_worldSettings = WorldConfig::WorldSettings();
     m_worldSettings.worldName = "Мой Мир";
+    m_activeSlot = -1;
     Logger::Log("Entered world creation menu");
 }
 
 void Engine::CreateWorld() {
     Logger::Log("Creating new world...");
     Logger::Log("World name: ", m_worldSettings.worldName);
+    if (m_worldSettings.seed == 0) {
+        m_worldSettings.seed = static_cast<int>(Replay::GetSeed() & 0x7FFFFFFF);
+    }
     m_worldGenerator = std::make_unique<WorldConfig::WorldGenerator>(m_worldSettings);
     m_worldGenerator->Generate();
     if (!m_worldGenerator->GetCities().empty()) {
@@ -124,6 +150,16 @@ void Engine::CreateWorld() {
         if (m_character) m_character->SetPosition(firstCity);
         Logger::Log("Character positioned at first city");
     }
+    if (m_activeSlot >= 0) {
+        // The seed may have just been filled in: the slot must regenerate the same world
+        const auto& cities = m_worldGenerator->GetCities();
+        const auto& roads = m_worldGenerator->GetRoads();
+        const auto& vegetation = m_worldGenerator->GetVegetation();
+        uint64_t hash = Replay::Hash(cities.data(), cities.size() * sizeof(Vector3));
+        hash = Replay::Hash(roads.data(), roads.size() * sizeof(Vector3), hash);
+        hash = Replay::Hash(vegetation.data(), vegetation.size() * sizeof(Vector3), hash);
+        m_worldSlots.SetGenerated(m_activeSlot, m_worldSettings, hash);
+    }
     Logger::Log("World creation complete");
 }
 
@@ -135,8 +171,11 @@ void Engine::BackToMenuFromWorldCreation() {
 
 void Engine::Run() {
     Logger::Log("=== Starting Game Loop ===");
+    Profiler::SetThreadName("Главный поток");
+    MetricHistogram& frameTimeMetric = Metrics::GetHistogram("rtgc_frame_time_us", "Время кадра, мкс");
     int frameCount = 0;
     while (m_running) {
+        Profiler::BeginFrame();
         try {
             auto currentTime = std::chrono::steady_clock::now();
             auto elapsed = std::chrono::duration<float>(currentTime - m_startTime).count();
@@ -144,6 +183,7 @@ void Engine::Run() {
             m_frameTime = elapsed - m_lastTime;
             m_lastTime = elapsed;
             m_totalTime += m_frameTime;
+            if (frameCount > 0) frameTimeMetric.Record(static_cast<uint64_t>(m_frameTime * 1e6f));
 
             if (m_frameTime > 0.1f) m_frameTime = 0.1f;
             if (m_frameTime < 0.016f) m_frameTime = 0.016f;
@@ -161,26 +201,40 @@ void Engine::Run() {
                     m_running = false;
                     break;
                 }
+                PROFILE_ZONE("Engine::PollEvents");
                 m_renderer->GetWindow()->PollEvents();
+
+                // F9 - записать трассу профайлера за следующие кадры
+                bool captureKey = m_renderer->GetWindow()->IsKeyPressed(VK_F9);
+                if (captureKey && !m_captureKeyDown) Profiler::StartCapture();
+                m_captureKeyDown = captureKey;
             }
 
-            // Input
-            // We will handle input in its own function below
-            // but keep structure for compatibility
-            // HandleInput(m_frameTime);
-            // We'll process inputs in the next step
+            // Тик симуляции: при записи сессии dt и клавиши уходят в файл,
+            // при воспроизведении берутся из него
+            if (!Replay::BeginTick(m_frameTime)) {
+                m_running = false;
+                break;
+            }
+            for (const Replay::KeyEvent& key : Replay::GetTickKeys()) {
+                InputManager::SetKeyState(key.key, key.pressed);
+            }
 
-            // Update systems
+            HandleInput(m_frameTime);
             UpdateSystems(m_frameTime);
+            Replay::EndTick(HashSimulationState());
+            InputManager::Update();
 
             if (m_renderer) {
+                PROFILE_ZONE("Engine::Render");
                 m_renderer->BeginFrame();
                 m_renderer->Clear();
                 switch (m_state) {
                 case State::LOADING:
                     m_renderer->RenderLoading(m_loadingProgress);
                     break;
-                case State::MENU:\n                    m_renderer->RenderMenuSlots(m_worldSlots, m_menuSelectedSlot);
+                case State::MENU:
+                    m_renderer->RenderMenuSlots(m_worldSlots, m_menuSelectedSlot);
                     break;
                 case State::WORLD_CREATION:
                     m_renderer->RenderWorldCreation(m_worldSettings);
@@ -202,10 +256,15 @@ void Engine::Run() {
 
             // Simple input poll
             if (m_renderer && m_renderer->GetWindow()) {
+                PROFILE_ZONE("Engine::PollEvents");
                 m_renderer->GetWindow()->PollEvents();
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            // Воспроизведение идёт с полной скоростью
+            if (!Replay::IsReplaying()) {
+                PROFILE_ZONE("Engine::Sleep");
+                std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            }
             frameCount++;
         } catch (const std::exception& e) {
             Logger::Error("Exception in game loop: ", e.what());
@@ -214,51 +273,103 @@ void Engine::Run() {
             Logger::Error("Unknown exception in game loop");
             m_running = false;
         }
+        Profiler::EndFrame();
+        FrameArena::Reset();
     }
+    Replay::StopRecording();
     Logger::Log("=== Game Loop Ended ===");
+    Profiler::PrintResults();
 }
 
 void Engine::HandleInput(float dt) {
-    if (!m_renderer || !m_renderer->GetWindow()) return;
-    Window* window = m_renderer->GetWindow();
+    // Keys come through InputManager: from the window or from a session replay
     if (m_state == State::MENU) {
-        // 1-5 slots
-        for (int i = 0; i < 5; ++i) {
-            if (window->IsKeyPressed('1' + i)) {
-                EnterWorldCreationFromSlot(i);
+        // Up/Down and PageUp/PageDown move the selection over the whole catalog,
+        // Insert takes a free slot (growing the catalog), Delete clears the selected one
+        if (InputManager::IsKeyPressed(VK_DOWN)) m_menuSelectedSlot++;
+        if (InputManager::IsKeyPressed(VK_UP)) m_menuSelectedSlot--;
+        if (InputManager::IsKeyPressed(VK_NEXT)) m_menuSelectedSlot += MENU_PAGE_SIZE;
+        if (InputManager::IsKeyPressed(VK_PRIOR)) m_menuSelectedSlot -= MENU_PAGE_SIZE;
+        if (InputManager::IsKeyPressed(VK_INSERT)) {
+            int added = m_worldSlots.AddSlot("World Slot " + std::to_string(m_worldSlots.GetSlotCount() + 1));
+            if (added >= 0) m_menuSelectedSlot = added;
+        }
+        m_menuSelectedSlot = std::clamp(m_menuSelectedSlot, 0, std::max(0, m_worldSlots.GetSlotCount() - 1));
+        if (InputManager::IsKeyPressed(VK_DELETE)) m_worldSlots.ClearSlot(m_menuSelectedSlot);
+
+        int pageStart = m_menuSelectedSlot / MENU_PAGE_SIZE * MENU_PAGE_SIZE;
+        int chosen = InputManager::IsKeyPressed(VK_RETURN) ? m_menuSelectedSlot : -1;
+        for (int i = 0; i < MENU_PAGE_SIZE && pageStart + i < m_worldSlots.GetSlotCount(); ++i) {
+            if (InputManager::IsKeyPressed('1' + i)) {
+                chosen = pageStart + i;
                 break;
             }
         }
+        if (chosen >= 0) EnterWorldCreationFromSlot(chosen);
     } else if (m_state == State::WORLD_CREATION) {
         // No detailed handling yet
-        if (window->IsKeyPressed(VK_ESCAPE)) {
+        if (InputManager::IsKeyPressed(VK_ESCAPE)) {
             BackToMenuFromWorldCreation();
         }
-        if (window->IsKeyPressed(VK_RETURN)) {
+        if (InputManager::IsKeyPressed(VK_RETURN)) {
             CreateWorld();
             m_state = State::GAME;
         }
-    } else if (m_state == State::GAME) {
-        // Basic movement handled in RenderGame path
+    } else if (m_state == State::GAME && m_character) {
+        Vector3 direction;
+        if (InputManager::IsKeyDown("forward")) direction.z -= 1.0f;
+        if (InputManager::IsKeyDown("backward")) direction.z += 1.0f;
+        if (InputManager::IsKeyDown("left")) direction.x -= 1.0f;
+        if (InputManager::IsKeyDown("right")) direction.x += 1.0f;
+        if (!direction.IsZero()) m_character->Move(direction.Normalize(), dt);
+        if (InputManager::IsKeyPressed("jump")) m_character->Jump();
     }
 
-    window->UpdateInput();
+    if (m_renderer && m_renderer->GetWindow()) m_renderer->GetWindow()->UpdateInput();
 }
 
 void Engine::UpdateSystems(float dt) {
-    if (m_character) m_character->Update(dt);
-    if (m_terrain) m_terrain->Update(dt);
+    PROFILE_ZONE("Engine::UpdateSystems");
+    if (m_character) {
+        PROFILE_ZONE("CharacterController::Update");
+        m_character->Update(dt);
+    }
+    if (m_terrain) {
+        PROFILE_ZONE("Terrain::Update");
+        m_terrain->Update(dt);
+    }
+    // После симуляции: перенос начала входит в тик и в хэш состояния
+    if (m_state == State::GAME && m_character) {
+        WorldOrigin::Update(m_character->GetPosition());
+    }
+}
+
+// Состояние, которое должно совпасть при воспроизведении записи сессии
+uint64_t Engine::HashSimulationState() const {
+    uint64_t hash = Replay::Hash(&m_state, sizeof(m_state));
+    if (m_character) {
+        Vector3 position = m_character->GetPosition();
+        bool onGround = m_character->IsOnGround();
+        hash = Replay::Hash(&position, sizeof(position), hash);
+        hash = Replay::Hash(&onGround, sizeof(onGround), hash);
+    }
+    const WorldPosition& origin = WorldOrigin::Get();
+    hash = Replay::Hash(&origin, sizeof(origin), hash);
+    return hash;
 }
 
 void Engine::Shutdown() {
     if (!m_running) return;
     m_running = false;
     ShutdownSystems();
+    Metrics::StopDump();
     Logger::Log("Engine shutdown complete");
 }
 
 void Engine::ShutdownSystems() {
     Logger::Log("Shutting down systems...");
+    WorldOrigin::RemoveListener(m_originListener);
+    m_originListener = 0;
     if (m_renderer) {
         m_renderer->Shutdown();
         m_renderer.reset();
@@ -27,7 +27,10 @@ private:
 
     WorldSlotsManager m_worldSlots;
     int m_menuSelectedSlot;
+    int m_activeSlot; // slot the world is being created for, -1 = none
     int m_selectedCityIndex;
+    bool m_captureKeyDown;
+    int m_originListener; // WorldOrigin::AddListener
 
     WorldConfig::WorldSettings m_worldSettings;
     std::unique_ptr<WorldConfig::WorldGenerator> m_worldGenerator;
@@ -37,6 +40,7 @@ private:
     void HandleInput(float dt);
     void CompleteLoading();
     void EnterWorldCreationFromSlot(int slotIndex);
+    uint64_t HashSimulationState() const;
 
 public:
     Engine();
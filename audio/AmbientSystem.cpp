@@ -3,7 +3,7 @@
 #include <random>
 
 AmbientSystem::AmbientSystem(AudioSystem* sys) : audioSystem(sys) {
-    LOG(L"Система амбиентного звука инициализирована");
+    LOG_INFO(Audio, "Система амбиентного звука инициализирована");
 
     // Добавление слоёв
     AmbientLayer wind;
@@ -12,7 +12,7 @@ AudioEventManager::AudioEventManager(AudioSystem* sys) : audioSystem(sys) {
     RegisterEvent("Explosion", [](AudioSystem& sys) {
         sys.PlayAt("explosion", {0,0,0});
     });
-    LOG(L"Система аудио-событий инициализирована");
+    LOG_INFO(Audio, "Система аудио-событий инициализирована");
 }
 
 void AudioEventManager::RegisterEvent(const std::string& eventName, std::function<void(AudioSystem&)> callback) {
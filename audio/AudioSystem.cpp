@@ -52,7 +52,7 @@ bool AudioSystem::Initialize() {
 void AudioSystem::Shutdown() {
     StopAllSounds();
     for (auto sound : sounds) {
-        delete sound;
+        soundPool.Delete(sound);
     }
     sounds.clear();
     Logger::Log("AudioSystem выключен");
@@ -63,13 +63,13 @@ void AudioSystem::Update() {
 }
 
 AudioSound* AudioSystem::LoadSound(const std::string& filename) {
-    auto sound = new AudioSound(filename);
+    auto sound = soundPool.New(filename);
     if (sound->Load()) {
         sounds.push_back(sound);
         Logger::Log("Звук загружен в AudioSystem: ", filename);
         return sound;
     } else {
-        delete sound;
+        soundPool.Delete(sound);
         Logger::Error("Не удалось загрузить звук: ", filename);
         return nullptr;
     }
@@ -1,5 +1,6 @@
 #pragma once
 #include "../math/Vector3.hpp"
+#include "../core/Allocators.hpp"
 #include <vector>
 #include <string>
 
@@ -30,6 +31,7 @@ public:
 class AudioSystem {
 private:
     std::vector<AudioSound*> sounds;
+    ObjectPool<AudioSound> soundPool{MemoryTag::Audio, 32};
     bool enabled;
     float masterVolume;
     
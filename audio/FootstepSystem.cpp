@@ -2,7 +2,7 @@
 #include "../core/Logger.hpp"
 
 FootstepSystem::FootstepSystem(AudioSystem* sys) : audioSystem(sys) {
-    LOG(L"Система аудио-шагов инициализирована");
+    LOG_INFO(Audio, "Система аудио-шагов инициализирована");
 }
 
 void FootstepSystem::Update(float dt, const glm::vec3& playerPosition) {
@@ -0,0 +1,86 @@
+#include "AllocationCounter.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Счётчики потока: без атомиков, чтобы подсчёт не менял картину, которую измеряет
+    thread_local uint64_t threadAllocations = 0;
+    thread_local uint64_t threadBytes = 0;
+
+    void* CountedAlloc(std::size_t size, std::size_t alignment) {
+        ++threadAllocations;
+        threadBytes += size;
+        if (size == 0) size = 1;
+        void* p = nullptr;
+        if (alignment > alignof(std::max_align_t)) {
+#ifdef _WIN32
+            p = _aligned_malloc(size, alignment);
+#else
+            std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+            p = std::aligned_alloc(alignment, rounded);
+#endif
+        } else {
+            p = std::malloc(size);
+        }
+        return p;
+    }
+
+    void CountedFree(void* p, std::size_t alignment) {
+        if (!p) return;
+#ifdef _WIN32
+        if (alignment > alignof(std::max_align_t)) {
+            _aligned_free(p);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(p);
+    }
+}
+
+uint64_t AllocationCounter::GetThreadAllocations() {
+    return threadAllocations;
+}
+
+uint64_t AllocationCounter::GetThreadBytes() {
+    return threadBytes;
+}
+
+void* operator new(std::size_t size) {
+    void* p = CountedAlloc(size, alignof(std::max_align_t));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* p = CountedAlloc(size, static_cast<std::size_t>(alignment));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAlloc(size, alignof(std::max_align_t));
+}
+
+void operator delete(void* p) noexcept { CountedFree(p, alignof(std::max_align_t)); }
+void operator delete[](void* p) noexcept { CountedFree(p, alignof(std::max_align_t)); }
+void operator delete(void* p, std::size_t) noexcept { CountedFree(p, alignof(std::max_align_t)); }
+void operator delete[](void* p, std::size_t) noexcept { CountedFree(p, alignof(std::max_align_t)); }
+void operator delete(void* p, std::align_val_t alignment) noexcept { CountedFree(p, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* p, std::align_val_t alignment) noexcept { CountedFree(p, static_cast<std::size_t>(alignment)); }
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept { CountedFree(p, static_cast<std::size_t>(alignment)); }
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept { CountedFree(p, static_cast<std::size_t>(alignment)); }
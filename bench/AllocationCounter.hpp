@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+// Счётчик выделений из кучи для бенчмарков: AllocationCounter.cpp заменяет глобальные
+// operator new/delete и считает вызовы в каждом потоке. Подключается только к бенчмаркам.
+namespace AllocationCounter {
+    // Выделений в текущем потоке с начала программы
+    uint64_t GetThreadAllocations();
+    uint64_t GetThreadBytes();
+}
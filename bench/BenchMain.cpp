@@ -0,0 +1,13 @@
+// RTGC_bench: горячие пути движка в одном исполняемом файле.
+// Запуск: RTGC_bench [--bench-filter=Physics] [--bench-baseline=bench/baseline.json] [--bench-threshold=10]
+// Ключи - см. Benchmark::Run. Код выхода 1 - есть регрессии относительно baseline.
+#include "Benchmark.hpp"
+#include "../core/Logger.hpp"
+
+int main(int argc, char** argv) {
+    // Лог подсистем идёт только в файл, чтобы не мешать таблице результатов
+    Logger::EnableConsole(false);
+    int result = Benchmark::Run(argc, argv);
+    Logger::Close();
+    return result;
+}
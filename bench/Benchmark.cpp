@@ -0,0 +1,327 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+    // Предел подбора: бенчмарк в одну инструкцию не должен крутиться вечно
+    constexpr uint64_t MAX_ITERATIONS = 1000000000;
+
+    std::vector<std::unique_ptr<BenchmarkRegistration>>& GetRegistry() {
+        static std::vector<std::unique_ptr<BenchmarkRegistration>> registry;
+        return registry;
+    }
+
+    struct Options {
+        std::string filter;
+        double minTime = Benchmark::DEFAULT_MIN_TIME;
+        int repetitions = Benchmark::DEFAULT_REPETITIONS;
+        std::string outputFile = Benchmark::DEFAULT_OUTPUT_FILE;
+        std::string baselineFile;
+        double threshold = Benchmark::DEFAULT_THRESHOLD;
+        bool listOnly = false;
+    };
+
+    struct Result {
+        std::string name;
+        uint64_t iterations = 0;
+        double ns = 0.0;    // медиана по повторам, нс на итерацию
+        double minNs = 0.0;
+        double maxNs = 0.0;
+        double itemsPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+    };
+
+    const char* ValueOf(const char* arg, const char* key) {
+        size_t length = std::strlen(key);
+        return std::strncmp(arg, key, length) == 0 ? arg + length : nullptr;
+    }
+
+    Options ParseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            const char* value = nullptr;
+            if ((value = ValueOf(argv[i], "--bench-filter="))) {
+                options.filter = value;
+            } else if ((value = ValueOf(argv[i], "--bench-min-time="))) {
+                options.minTime = std::max(0.001, std::atof(value));
+            } else if ((value = ValueOf(argv[i], "--bench-repetitions="))) {
+                options.repetitions = std::max(1, std::atoi(value));
+            } else if ((value = ValueOf(argv[i], "--bench-out="))) {
+                options.outputFile = value;
+            } else if ((value = ValueOf(argv[i], "--bench-baseline="))) {
+                options.baselineFile = value;
+            } else if ((value = ValueOf(argv[i], "--bench-threshold="))) {
+                options.threshold = std::atof(value);
+            } else if (std::strcmp(argv[i], "--bench-list") == 0) {
+                options.listOnly = true;
+            } else {
+                std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            }
+        }
+        return options;
+    }
+
+    std::string FormatTime(double ns) {
+        char buffer[32];
+        if (ns < 1e3) {
+            std::snprintf(buffer, sizeof(buffer), "%.1f ns", ns);
+        } else if (ns < 1e6) {
+            std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+        } else if (ns < 1e9) {
+            std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%.3f s", ns / 1e9);
+        }
+        return buffer;
+    }
+
+    std::string FormatRate(double perSecond, const char* unit) {
+        char buffer[32];
+        if (perSecond >= 1e9) {
+            std::snprintf(buffer, sizeof(buffer), "%.2fG %s/s", perSecond / 1e9, unit);
+        } else if (perSecond >= 1e6) {
+            std::snprintf(buffer, sizeof(buffer), "%.2fM %s/s", perSecond / 1e6, unit);
+        } else if (perSecond >= 1e3) {
+            std::snprintf(buffer, sizeof(buffer), "%.2fk %s/s", perSecond / 1e3, unit);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%.1f %s/s", perSecond, unit);
+        }
+        return buffer;
+    }
+
+    void WriteEscaped(std::FILE* f, const std::string& s) {
+        for (unsigned char c : s) {
+            if (c == '"' || c == '\\') {
+                std::fputc('\\', f);
+                std::fputc(c, f);
+            } else if (c < 0x20) {
+                std::fprintf(f, "\\u%04x", c);
+            } else {
+                std::fputc(c, f);
+            }
+        }
+    }
+
+    const char* CompilerName() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    bool WriteJson(const std::string& path, const Options& options, const std::vector<Result>& results) {
+        std::error_code ec;
+        std::filesystem::path target(path);
+        if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), ec);
+
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+
+        char date[32] = "";
+        std::time_t now = std::time(nullptr);
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &now);
+#else
+        localtime_r(&now, &tm);
+#endif
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &tm);
+
+#ifdef NDEBUG
+        const char* build = "release";
+#else
+        const char* build = "debug";
+#endif
+        std::fprintf(f, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"compiler\": \"", date);
+        WriteEscaped(f, CompilerName());
+        std::fprintf(f, "\",\n    \"build\": \"%s\",\n    \"hardware_threads\": %u,\n"
+                        "    \"min_time\": %g,\n    \"repetitions\": %d\n  },\n  \"benchmarks\": [",
+                     build, std::thread::hardware_concurrency(), options.minTime, options.repetitions);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::fprintf(f, "%s\n    {\"name\": \"", i == 0 ? "" : ",");
+            WriteEscaped(f, r.name);
+            std::fprintf(f, "\", \"iterations\": %llu, \"real_time_ns\": %.3f, \"min_time_ns\": %.3f, \"max_time_ns\": %.3f",
+                         static_cast<unsigned long long>(r.iterations), r.ns, r.minNs, r.maxNs);
+            if (r.itemsPerSecond > 0.0) std::fprintf(f, ", \"items_per_second\": %.1f", r.itemsPerSecond);
+            if (r.bytesPerSecond > 0.0) std::fprintf(f, ", \"bytes_per_second\": %.1f", r.bytesPerSecond);
+            std::fputc('}', f);
+        }
+        std::fprintf(f, "\n  ]\n}\n");
+        return std::fclose(f) == 0;
+    }
+
+    // Читает только то, что пишет WriteJson: пары "name" и "real_time_ns" внутри "benchmarks"
+    bool ReadBaseline(const std::string& path, std::unordered_map<std::string, double>& baseline) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string text = buffer.str();
+
+        size_t pos = text.find("\"benchmarks\"");
+        if (pos == std::string::npos) return false;
+        while ((pos = text.find("\"name\"", pos)) != std::string::npos) {
+            size_t quote = text.find('"', text.find(':', pos));
+            if (quote == std::string::npos) break;
+            std::string name;
+            size_t i = quote + 1;
+            for (; i < text.size() && text[i] != '"'; ++i) {
+                if (text[i] == '\\' && i + 1 < text.size()) ++i;
+                name += text[i];
+            }
+            size_t objectEnd = text.find('}', i);
+            size_t timePos = text.find("\"real_time_ns\"", i);
+            if (timePos != std::string::npos && timePos < objectEnd) {
+                baseline[name] = std::strtod(text.c_str() + text.find(':', timePos) + 1, nullptr);
+            }
+            pos = i;
+        }
+        return true;
+    }
+}
+
+double Benchmark::RunOnce(void (*function)(BenchmarkState&), uint64_t iterations, int64_t arg,
+                          uint64_t& items, uint64_t& bytes) {
+    BenchmarkState state(iterations, arg);
+    function(state);
+    items = state.itemsProcessed;
+    bytes = state.bytesProcessed;
+    return std::chrono::duration<double>(state.elapsed).count();
+}
+
+BenchmarkRegistration* Benchmark::Register(const char* name, void (*function)(BenchmarkState&)) {
+    GetRegistry().push_back(std::make_unique<BenchmarkRegistration>(name, function));
+    return GetRegistry().back().get();
+}
+
+int Benchmark::Run(int argc, char** argv) {
+    Options options = ParseOptions(argc, argv);
+
+    struct Case {
+        std::string name;
+        void (*function)(BenchmarkState&);
+        int64_t arg;
+    };
+    std::vector<Case> cases;
+    for (const auto& reg : GetRegistry()) {
+        if (reg->args.empty()) {
+            cases.push_back({reg->name, reg->function, 0});
+        }
+        for (int64_t arg : reg->args) {
+            cases.push_back({reg->name + "/" + std::to_string(arg), reg->function, arg});
+        }
+    }
+    if (!options.filter.empty()) {
+        cases.erase(std::remove_if(cases.begin(), cases.end(), [&](const Case& c) {
+            return c.name.find(options.filter) == std::string::npos;
+        }), cases.end());
+    }
+
+    if (options.listOnly) {
+        for (const Case& c : cases) std::printf("%s\n", c.name.c_str());
+        return 0;
+    }
+
+    std::unordered_map<std::string, double> baseline;
+    if (!options.baselineFile.empty() && !ReadBaseline(options.baselineFile, baseline)) {
+        std::fprintf(stderr, "Cannot read baseline: %s\n", options.baselineFile.c_str());
+        return 2;
+    }
+
+    std::printf("%-44s %14s %12s %18s", "Benchmark", "Time/iter", "Iterations", "Throughput");
+    if (!baseline.empty()) std::printf(" %12s", "vs baseline");
+    std::printf("\n");
+
+    std::vector<Result> results;
+    int regressions = 0;
+    for (const Case& c : cases) {
+        uint64_t items = 0;
+        uint64_t bytes = 0;
+
+        // Подбор числа итераций, как в google-benchmark: растим, пока прогон короче minTime.
+        // Прогон, достигший minTime, - первый повтор.
+        uint64_t iterations = 1;
+        double seconds = 0.0;
+        for (;;) {
+            seconds = RunOnce(c.function, iterations, c.arg, items, bytes);
+            if (seconds >= options.minTime || iterations >= MAX_ITERATIONS) break;
+            double multiplier = seconds > 0.0 ? options.minTime * 1.4 / seconds : 10.0;
+            if (seconds / options.minTime <= 0.1) multiplier = std::min(multiplier, 10.0);
+            uint64_t next = static_cast<uint64_t>(static_cast<double>(iterations) * multiplier);
+            iterations = std::min(MAX_ITERATIONS, std::max(iterations + 1, next));
+        }
+
+        std::vector<double> samples{seconds};
+        uint64_t totalItems = items;
+        uint64_t totalBytes = bytes;
+        double totalSeconds = seconds;
+        for (int r = 1; r < options.repetitions; ++r) {
+            samples.push_back(RunOnce(c.function, iterations, c.arg, items, bytes));
+            totalItems += items;
+            totalBytes += bytes;
+            totalSeconds += samples.back();
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = c.name;
+        result.iterations = iterations;
+        double toNs = 1e9 / static_cast<double>(iterations);
+        result.ns = samples[samples.size() / 2] * toNs;
+        result.minNs = samples.front() * toNs;
+        result.maxNs = samples.back() * toNs;
+        if (totalSeconds > 0.0) {
+            result.itemsPerSecond = static_cast<double>(totalItems) / totalSeconds;
+            result.bytesPerSecond = static_cast<double>(totalBytes) / totalSeconds;
+        }
+
+        std::string rate;
+        if (result.itemsPerSecond > 0.0) rate = FormatRate(result.itemsPerSecond, "items");
+        else if (result.bytesPerSecond > 0.0) rate = FormatRate(result.bytesPerSecond, "B");
+        std::printf("%-44s %14s %12llu %18s", result.name.c_str(), FormatTime(result.ns).c_str(),
+                    static_cast<unsigned long long>(iterations), rate.c_str());
+
+        if (!baseline.empty()) {
+            auto it = baseline.find(result.name);
+            if (it == baseline.end() || it->second <= 0.0) {
+                std::printf(" %12s", "new");
+            } else {
+                double change = (result.ns - it->second) / it->second * 100.0;
+                bool regressed = change > options.threshold;
+                if (regressed) ++regressions;
+                std::printf(" %+11.1f%%%s", change, regressed ? "  REGRESSION" : "");
+            }
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+        results.push_back(std::move(result));
+    }
+
+    if (!options.outputFile.empty()) {
+        if (WriteJson(options.outputFile, options, results)) {
+            std::printf("Results: %s\n", options.outputFile.c_str());
+        } else {
+            std::fprintf(stderr, "Cannot write %s\n", options.outputFile.c_str());
+        }
+    }
+
+    if (!baseline.empty()) {
+        std::printf("Regressions over %.1f%%: %d\n", options.threshold, regressions);
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Набор бенчмарков горячих путей движка (цель RTGC_bench), по образцу google-benchmark:
+//     static void BM_Terrain_GetHeightAt(BenchmarkState& state) {
+//         Terrain terrain; terrain.Initialize();
+//         while (state.KeepRunning()) Benchmark::DoNotOptimize(terrain.GetHeightAt(10.0f, 20.0f));
+//     }
+//     RTGC_BENCHMARK(BM_Terrain_GetHeightAt);
+//     RTGC_BENCHMARK(BM_Physics_Update)->Arg(1000)->Arg(10000);
+// Число итераций подбирается так, чтобы замер шёл не меньше --bench-min-time.
+// Результаты - JSON, сравнение с сохранённым прогоном - --bench-baseline (см. Benchmark::Run).
+class BenchmarkState {
+    friend class Benchmark;
+
+    uint64_t iterations;
+    uint64_t remaining;
+    int64_t arg;
+    bool started = false;
+    bool paused = false;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::duration elapsed{0};
+    uint64_t itemsProcessed = 0;
+    uint64_t bytesProcessed = 0;
+
+    BenchmarkState(uint64_t iterationCount, int64_t argument)
+        : iterations(iterationCount), remaining(iterationCount), arg(argument) {}
+
+public:
+    // Цикл замера: while (state.KeepRunning()) { ... }. Подготовка до цикла в замер не входит.
+    bool KeepRunning() {
+        if (!started) {
+            started = true;
+            startTime = std::chrono::steady_clock::now();
+        }
+        if (remaining > 0) {
+            --remaining;
+            return true;
+        }
+        if (!paused) elapsed += std::chrono::steady_clock::now() - startTime;
+        paused = true;
+        return false;
+    }
+
+    // Исключить часть итерации из замера (перестройка данных и т.п.)
+    void PauseTiming() {
+        if (paused) return;
+        elapsed += std::chrono::steady_clock::now() - startTime;
+        paused = true;
+    }
+
+    void ResumeTiming() {
+        if (!paused) return;
+        startTime = std::chrono::steady_clock::now();
+        paused = false;
+    }
+
+    int64_t GetArg() const { return arg; }
+    uint64_t GetIterations() const { return iterations; }
+
+    // Сколько элементов/байт обработано за все итерации: в отчёте станет пропускной способностью
+    void SetItemsProcessed(uint64_t items) { itemsProcessed = items; }
+    void SetBytesProcessed(uint64_t bytes) { bytesProcessed = bytes; }
+};
+
+class BenchmarkRegistration {
+    friend class Benchmark;
+
+    std::string name;
+    void (*function)(BenchmarkState&);
+    std::vector<int64_t> args;
+
+public:
+    BenchmarkRegistration(const char* benchName, void (*fn)(BenchmarkState&)) : name(benchName), function(fn) {}
+
+    // Каждый аргумент - отдельный замер с именем "<имя>/<аргумент>"
+    BenchmarkRegistration* Arg(int64_t value) {
+        args.push_back(value);
+        return this;
+    }
+};
+
+class Benchmark {
+    // Один прогон: iterations итераций, возвращает замеренное время в секундах
+    static double RunOnce(void (*function)(BenchmarkState&), uint64_t iterations, int64_t arg,
+                          uint64_t& items, uint64_t& bytes);
+
+public:
+    static constexpr double DEFAULT_MIN_TIME = 0.5;      // секунд на замер
+    static constexpr int DEFAULT_REPETITIONS = 3;        // в отчёт идёт медиана
+    static constexpr double DEFAULT_THRESHOLD = 10.0;    // % замедления, считающийся регрессией
+    static constexpr const char* DEFAULT_OUTPUT_FILE = "logs/bench_results.json";
+
+    static BenchmarkRegistration* Register(const char* name, void (*function)(BenchmarkState&));
+
+    // Запускает зарегистрированные бенчмарки. Ключи:
+    //   --bench-filter=подстрока     только бенчмарки, в имени которых есть подстрока
+    //   --bench-min-time=секунд      минимальное время одного замера
+    //   --bench-repetitions=N        повторов замера, в отчёт идёт медиана
+    //   --bench-out=путь.json        куда записать результаты (пусто - не писать)
+    //   --bench-baseline=путь.json   сравнить с прошлыми результатами того же формата
+    //   --bench-threshold=процентов  замедление сверх порога - регрессия
+    //   --bench-list                 только перечислить бенчмарки
+    // Возвращает код выхода: 1, если есть регрессии относительно baseline.
+    static int Run(int argc, char** argv);
+
+    // Не даёт компилятору выбросить вычисление, результат которого не используется
+    template<typename T>
+    static void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+
+    // Запись в память, видимую компилятору: вычисления до барьера не переносятся за него
+    static void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+};
+
+#define RTGC_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define RTGC_BENCHMARK_CONCAT(a, b) RTGC_BENCHMARK_CONCAT_IMPL(a, b)
+#define RTGC_BENCHMARK(function) \
+    static BenchmarkRegistration* RTGC_BENCHMARK_CONCAT(rtgcBenchmark_, __LINE__) = \
+        Benchmark::Register(#function, function)
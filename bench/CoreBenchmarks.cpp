@@ -0,0 +1,218 @@
+// Logger, накладные расходы профайлера, математика Vector3, пакетные SIMD-операции MathBatch
+// и пересчёт мировых матриц TransformHierarchy
+#include "Benchmark.hpp"
+#include "../core/Logger.hpp"
+#include "../debug/Profiler.hpp"
+#include "../math/Vector3.hpp"
+#include "../math/MathBatch.hpp"
+#include "../systems/TransformHierarchy.hpp"
+#include <vector>
+
+namespace {
+    // Вызывающая сторона асинхронного логгера: форматирование в поток записи, не ожидание диска
+    void BM_Logger_Log(BenchmarkState& state) {
+        uint64_t i = 0;
+        while (state.KeepRunning()) {
+            LOG_INFO(Core, "Бенчмарк логгера: итерация ", i, ", значение ", 3.25, ", имя ", "RTGC");
+            ++i;
+        }
+        state.SetItemsProcessed(state.GetIterations());
+        Logger::Flush();
+    }
+    RTGC_BENCHMARK(BM_Logger_Log);
+
+    // Сообщение ниже уровня логгера: цена проверки маски
+    void BM_Logger_LogFiltered(BenchmarkState& state) {
+        Logger::Level previous = Logger::GetLevel();
+        Logger::SetLevel(Logger::Level::Warning);
+        uint64_t i = 0;
+        while (state.KeepRunning()) {
+            LOG_INFO(Core, "Отфильтровано: ", i);
+            ++i;
+        }
+        Logger::SetLevel(previous);
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    RTGC_BENCHMARK(BM_Logger_LogFiltered);
+
+    // Кадр на каждые FRAME_ZONES зон: сбор событий в EndFrame входит в замер
+    constexpr uint64_t FRAME_ZONES = 4096;
+
+    void BM_Profiler_Zone(BenchmarkState& state) {
+        Profiler::BeginFrame();
+        uint64_t i = 0;
+        while (state.KeepRunning()) {
+            {
+                PROFILE_ZONE("Bench::Zone");
+                Benchmark::ClobberMemory();
+            }
+            if (++i % FRAME_ZONES == 0) {
+                Profiler::EndFrame();
+                Profiler::BeginFrame();
+            }
+        }
+        Profiler::EndFrame();
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    RTGC_BENCHMARK(BM_Profiler_Zone);
+
+    void BM_Profiler_ZoneDisabled(BenchmarkState& state) {
+        Profiler::SetEnabled(false);
+        while (state.KeepRunning()) {
+            PROFILE_ZONE("Bench::DisabledZone");
+            Benchmark::ClobberMemory();
+        }
+        Profiler::SetEnabled(true);
+        state.SetItemsProcessed(state.GetIterations());
+    }
+    RTGC_BENCHMARK(BM_Profiler_ZoneDisabled);
+
+    constexpr size_t VECTOR_COUNT = 1024;
+
+    std::vector<Vector3> MakeVectors(float seed) {
+        std::vector<Vector3> v(VECTOR_COUNT);
+        for (size_t i = 0; i < VECTOR_COUNT; ++i) {
+            float f = static_cast<float>(i) + seed;
+            v[i] = Vector3(f * 0.37f - 100.0f, f * 0.11f + 1.0f, 50.0f - f * 0.23f);
+        }
+        return v;
+    }
+
+    void BM_Vector3_Normalize(BenchmarkState& state) {
+        std::vector<Vector3> in = MakeVectors(0.5f);
+        std::vector<Vector3> out(VECTOR_COUNT);
+        while (state.KeepRunning()) {
+            for (size_t i = 0; i < VECTOR_COUNT; ++i) out[i] = in[i].Normalize();
+            Benchmark::DoNotOptimize(out.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_Vector3_Normalize);
+
+    void BM_Vector3_CrossDot(BenchmarkState& state) {
+        std::vector<Vector3> a = MakeVectors(0.5f);
+        std::vector<Vector3> b = MakeVectors(7.0f);
+        while (state.KeepRunning()) {
+            float sum = 0.0f;
+            for (size_t i = 0; i < VECTOR_COUNT; ++i) sum += a[i].Cross(b[i]).Dot(a[i]);
+            Benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_Vector3_CrossDot);
+
+    // Интегрирование как в PhysicsBody::Update: v += a*dt, p += v*dt
+    void BM_Vector3_Integrate(BenchmarkState& state) {
+        std::vector<Vector3> position = MakeVectors(0.5f);
+        std::vector<Vector3> velocity = MakeVectors(3.0f);
+        const Vector3 gravity(0.0f, -9.81f, 0.0f);
+        const float dt = 1.0f / 60.0f;
+        while (state.KeepRunning()) {
+            for (size_t i = 0; i < VECTOR_COUNT; ++i) {
+                velocity[i] += gravity * dt;
+                position[i] += velocity[i] * dt;
+            }
+            Benchmark::DoNotOptimize(position.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_Vector3_Integrate);
+
+    // Те же данные в раскладке SoA для сравнения с поэлементными циклами по Vector3
+    struct SoaVectors {
+        std::vector<float> x, y, z;
+
+        explicit SoaVectors(const std::vector<Vector3>& v) : x(v.size()), y(v.size()), z(v.size()) {
+            for (size_t i = 0; i < v.size(); ++i) {
+                x[i] = v[i].x;
+                y[i] = v[i].y;
+                z[i] = v[i].z;
+            }
+        }
+
+        Vec3Soa View() { return Vec3Soa{x.data(), y.data(), z.data()}; }
+    };
+
+    void BM_MathBatch_NormalizeMany(BenchmarkState& state) {
+        SoaVectors in(MakeVectors(0.5f));
+        SoaVectors out(MakeVectors(0.0f));
+        while (state.KeepRunning()) {
+            MathBatch::NormalizeMany(in.View(), out.View(), VECTOR_COUNT);
+            Benchmark::DoNotOptimize(out.x.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_MathBatch_NormalizeMany);
+
+    void BM_MathBatch_DotMany(BenchmarkState& state) {
+        SoaVectors a(MakeVectors(0.5f));
+        SoaVectors b(MakeVectors(7.0f));
+        std::vector<float> out(VECTOR_COUNT);
+        while (state.KeepRunning()) {
+            MathBatch::DotMany(a.View(), b.View(), out.data(), VECTOR_COUNT);
+            Benchmark::DoNotOptimize(out.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_MathBatch_DotMany);
+
+    // Поэлементно через Mat4::TransformPoint и пакетом через MathBatch::TransformPoints
+    void BM_Mat4_TransformPoint(BenchmarkState& state) {
+        std::vector<Vector3> in = MakeVectors(0.5f);
+        std::vector<Vector3> out(VECTOR_COUNT);
+        const Mat4 m = Mat4::TRS(Vec3(1.0f, 2.0f, 3.0f), Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 0.5f), Vec3(2.0f, 2.0f, 2.0f));
+        while (state.KeepRunning()) {
+            for (size_t i = 0; i < VECTOR_COUNT; ++i) out[i] = m.TransformPoint(Vec3(in[i])).ToVector3();
+            Benchmark::DoNotOptimize(out.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_Mat4_TransformPoint);
+
+    void BM_MathBatch_TransformPoints(BenchmarkState& state) {
+        SoaVectors in(MakeVectors(0.5f));
+        SoaVectors out(MakeVectors(0.0f));
+        const Mat4 m = Mat4::TRS(Vec3(1.0f, 2.0f, 3.0f), Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 0.5f), Vec3(2.0f, 2.0f, 2.0f));
+        while (state.KeepRunning()) {
+            MathBatch::TransformPoints(m, in.View(), out.View(), VECTOR_COUNT);
+            Benchmark::DoNotOptimize(out.x.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * VECTOR_COUNT);
+    }
+    RTGC_BENCHMARK(BM_MathBatch_TransformPoints);
+
+    // Сцена из корней с четырьмя потомками; аргумент - сколько узлов из 100 меняется каждый кадр
+    void BM_TransformHierarchy_Update(BenchmarkState& state) {
+        constexpr uint32_t NODE_COUNT = 10000;
+        const uint32_t dirtyPercent = static_cast<uint32_t>(state.GetArg());
+        TransformHierarchy hierarchy;
+        std::vector<uint32_t> nodes;
+        nodes.reserve(NODE_COUNT);
+        for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+            uint32_t parent = i % 5 == 0 ? TransformHierarchy::INVALID : nodes[i - i % 5];
+            nodes.push_back(hierarchy.Create(parent));
+            hierarchy.SetLocal(nodes.back(), Vector3(static_cast<float>(i), 0.0f, 1.0f), Quat(), Vector3(1.0f, 1.0f, 1.0f));
+        }
+        hierarchy.Update();
+
+        float t = 0.0f;
+        while (state.KeepRunning()) {
+            t += 0.01f;
+            for (uint32_t i = 0; i < NODE_COUNT; ++i) {
+                if (i % 100 < dirtyPercent) {
+                    hierarchy.SetLocal(nodes[i], Vector3(static_cast<float>(i), t, 1.0f), Quat(), Vector3(1.0f, 1.0f, 1.0f));
+                }
+            }
+            Benchmark::DoNotOptimize(hierarchy.Update());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * NODE_COUNT);
+    }
+    RTGC_BENCHMARK(BM_TransformHierarchy_Update)->Arg(0)->Arg(10)->Arg(100);
+}
@@ -0,0 +1,121 @@
+// Временные данные кадра: куча против FrameArena.
+// Кадр - вершины ландшафта, поиск объектов по тегу и профайлер, как в Engine::Run.
+// В режиме арены после прогрева не должно быть ни одного выделения из кучи на кадр;
+// иначе бенчмарк завершается с кодом 1.
+// Запуск: FrameArenaBench [кадров=2000]
+#include "AllocationCounter.hpp"
+#include "../core/FrameArena.hpp"
+#include "../core/Logger.hpp"
+#include "../debug/Profiler.hpp"
+#include "../world/Terrain.hpp"
+#include "../world/WorldManager.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    constexpr int WARMUP_FRAMES = 16;
+
+    struct Result {
+        double avgUs = 0.0;
+        uint64_t steadyAllocations = 0;
+        uint64_t steadyBytes = 0;
+        uint64_t worstFrameAllocations = 0;
+    };
+
+    template<typename FrameFn>
+    Result Run(int frames, FrameFn&& frame) {
+        Result result;
+        double totalUs = 0.0;
+        for (int i = 0; i < WARMUP_FRAMES + frames; ++i) {
+            uint64_t allocationsBefore = AllocationCounter::GetThreadAllocations();
+            uint64_t bytesBefore = AllocationCounter::GetThreadBytes();
+            auto start = std::chrono::steady_clock::now();
+
+            Profiler::BeginFrame();
+            frame();
+            Profiler::EndFrame();
+            FrameArena::Reset();
+
+            auto end = std::chrono::steady_clock::now();
+            if (i < WARMUP_FRAMES) continue;
+            uint64_t allocations = AllocationCounter::GetThreadAllocations() - allocationsBefore;
+            result.steadyAllocations += allocations;
+            result.steadyBytes += AllocationCounter::GetThreadBytes() - bytesBefore;
+            if (allocations > result.worstFrameAllocations) result.worstFrameAllocations = allocations;
+            totalUs += std::chrono::duration<double, std::micro>(end - start).count();
+        }
+        result.avgUs = totalUs / frames;
+        return result;
+    }
+
+    void Print(const char* name, const Result& r, int frames) {
+        std::printf("%-6s %.1f us/frame, heap allocations/frame %.2f (worst %llu), heap bytes/frame %.0f\n",
+                    name, r.avgUs, static_cast<double>(r.steadyAllocations) / frames,
+                    static_cast<unsigned long long>(r.worstFrameAllocations),
+                    static_cast<double>(r.steadyBytes) / frames);
+    }
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (frames < 1) frames = 1;
+
+    Logger::EnableConsole(false);
+    Profiler::SetThreadName("Главный поток");
+
+    Terrain terrain;
+    terrain.Initialize();
+    World world("Bench");
+    for (int i = 0; i < 2000; ++i) {
+        GameObject* obj = world.CreateObject("Объект");
+        if (i % 10 == 0) obj->SetTag("enemy");
+    }
+
+    float checksum = 0.0f;
+    size_t found = 0;
+
+    Result heap = Run(frames, [&]() {
+        {
+            PROFILE_ZONE("Terrain::GetVertices");
+            std::vector<float> vertices;
+            terrain.GetVertices(vertices);
+            checksum += vertices[vertices.size() / 2];
+        }
+        {
+            PROFILE_ZONE("World::FindObjectsByTag");
+            std::pmr::vector<GameObject*> enemies = world.FindObjectsByTag("enemy");
+            found += enemies.size();
+        }
+    });
+
+    Result arena = Run(frames, [&]() {
+        {
+            PROFILE_ZONE("Terrain::GetVertices");
+            std::pmr::vector<float> vertices(FrameArena::GetResource());
+            terrain.GetVertices(vertices);
+            checksum += vertices[vertices.size() / 2];
+        }
+        {
+            PROFILE_ZONE("World::FindObjectsByTag");
+            std::pmr::vector<GameObject*> enemies = world.FindObjectsByTag("enemy", FrameArena::GetResource());
+            found += enemies.size();
+        }
+    });
+
+    std::printf("Frame scratch data: %d frames after %d warm-up (checksum %.1f, found %zu)\n",
+                frames, WARMUP_FRAMES, checksum, found);
+    Print("heap", heap, frames);
+    Print("arena", arena, frames);
+    std::printf("frame arena: %zu KiB in %zu blocks\n",
+                FrameArena::GetAllocator().GetCapacity() / 1024, FrameArena::GetAllocator().GetBlockCount());
+
+    Logger::Close();
+    if (arena.steadyAllocations != 0) {
+        std::printf("FAIL: %llu heap allocations in steady-state frames with the frame arena\n",
+                    static_cast<unsigned long long>(arena.steadyAllocations));
+        return 1;
+    }
+    std::printf("OK: zero heap allocations per frame with the frame arena\n");
+    return 0;
+}
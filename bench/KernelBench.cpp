@@ -0,0 +1,206 @@
+// AVX2-ядра против скалярных эталонов из CpuKernels.
+// Каждое ядро считается на диапазоне с невыровненными краями (проверяется хвост и то,
+// что элементы вне диапазона не тронуты), затем CpuKernelBackend целиком - куски по пулу потоков.
+// Ветер и ландшафт идут через полиномиальный sin, допуск KERNEL_TOLERANCE;
+// подвеска и сцепление должны совпасть точно. Отдельно проверяется расписание KernelContext
+// на CPU: GetResult в кадре N+1 отдаёт результат кадра N, вход копируется при Launch.
+// При расхождении бенчмарк завершается с кодом 1.
+// Запуск: KernelBench [элементов=65536]
+#include "../cuda/CpuKernels.h"
+#include "../core/Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr float KERNEL_TOLERANCE = 1e-4f;
+    constexpr int REPEATS = 20;
+
+    int failures = 0;
+
+    // Наибольшее расхождение; вне [begin, end) массивы обязаны совпадать точно
+    void Compare(const char* name, const std::vector<float>& expected, const std::vector<float>& actual, float tolerance) {
+        float maxError = 0.0f;
+        size_t worst = 0;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            float error = std::fabs(expected[i] - actual[i]);
+            if (!(error <= maxError)) {
+                maxError = error;
+                worst = i;
+            }
+        }
+        bool ok = maxError <= tolerance;
+        std::printf("%-22s max error %.3g%s\n", name, maxError, ok ? "" : "  <- FAIL");
+        if (!ok) {
+            std::printf("  element %zu: expected %.9g, got %.9g\n", worst, expected[worst], actual[worst]);
+            ++failures;
+        }
+    }
+
+    std::vector<float> MakeInput(int size, float base, float spread) {
+        std::vector<float> data(size);
+        for (int i = 0; i < size; ++i) data[i] = base + spread * static_cast<float>((i * 37) % 101) / 100.0f;
+        return data;
+    }
+
+    using RangeKernel = void (*)(float*, float, int, int);
+
+    void CheckRange(const char* name, RangeKernel scalar, RangeKernel simd, std::vector<float> input,
+                    float dt, int begin, int end, float tolerance) {
+        std::vector<float> expected = input;
+        scalar(expected.data(), dt, begin, end);
+        simd(input.data(), dt, begin, end);
+        Compare(name, expected, input, tolerance);
+    }
+
+    std::vector<float> Copy(const float* data, int size) {
+        return data ? std::vector<float>(data, data + size) : std::vector<float>(size, NAN);
+    }
+
+    // Несколько кадров подряд: вход кадра k зависит от k, в кадре k+1 ждём результат кадра k
+    void CheckContext(CpuKernelBackend& backend, int size) {
+        constexpr int FRAMES = 6;
+        KernelContextDesc desc;
+        desc.windSize = size;
+        desc.suspensionSize = size;
+        desc.terrainSize = size;
+        std::unique_ptr<KernelContext> context = backend.CreateContext(desc);
+
+        std::vector<float> expectedWind[FRAMES];
+        std::vector<float> expectedSuspension[FRAMES];
+        bool ok = true;
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            float time = 12.0f + 0.5f * frame;
+            float dt = 1.0f / 60.0f * (frame + 1);
+            std::vector<float> input = MakeInput(size, 0.01f * frame, 0.05f);
+
+            // Эталон кадра - скалярный код на тех же данных
+            expectedWind[frame].assign(size * 3, 0.0f);
+            CpuKernels::WindScalar(expectedWind[frame].data(), size, time, 0, size);
+            expectedSuspension[frame] = input;
+            CpuKernels::SuspensionScalar(expectedSuspension[frame].data(), dt, 0, size);
+
+            float* in = context->GetInputBuffer(KernelId::Suspension);
+            std::copy(input.begin(), input.end(), in);
+            context->Launch(KernelId::Suspension, dt);
+            // Вход уже скопирован: запись следующего кадра не должна попасть в этот запуск
+            std::fill(in, in + size, -1.0f);
+            context->Launch(KernelId::Wind, time);
+
+            int seen = frame == 0 ? 0 : frame - 1;
+            char name[48];
+            std::snprintf(name, sizeof(name), "Context frame %d", frame);
+            int before = failures;
+            Compare(name, expectedWind[seen], Copy(context->GetResult(KernelId::Wind), size * 3), 0.0f);
+            Compare(name, expectedSuspension[seen], Copy(context->GetResult(KernelId::Suspension), size), 0.0f);
+            ok &= failures == before;
+        }
+        if (context->GetLaunchCount(KernelId::Wind) != FRAMES || context->GetResult(KernelId::Terrain) != nullptr ||
+            context->GetResult(KernelId::Traction) != nullptr || context->GetSize(KernelId::Traction) != 0) {
+            std::printf("Context: launch count or unused channels are wrong  <- FAIL\n");
+            ++failures;
+            ok = false;
+        }
+        context->Synchronize();
+        std::printf("Context (%s): frame N+1 %s frame N results\n", backend.GetName(), ok ? "sees" : "does NOT see");
+    }
+
+    template<typename Fn>
+    double MeasureNs(int elements, Fn&& fn) {
+        fn();
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r) fn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(REPEATS) * elements);
+    }
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 256 * 256;
+    if (size < 64) size = 64;
+
+    Logger::EnableConsole(false);
+
+    // Расписание контекста не зависит от AVX2: скалярный бэкенд даёт точное сравнение
+    CpuKernelBackend scalarBackend(false);
+    CheckContext(scalarBackend, size);
+
+    if (!CpuKernels::HasAvx2()) {
+        std::printf("AVX2 is not available: the CPU backend runs the scalar kernels, nothing to compare\n");
+        Logger::Close();
+        return failures != 0 ? 1 : 0;
+    }
+
+    // Края диапазона не кратны 8: AVX2-путь дописывает хвост скалярным кодом
+    const int begin = 3;
+    const int end = size - 5;
+    const float time = 12.5f;
+    const float dt = 1.0f / 60.0f;
+    std::printf("Scalar vs AVX2 kernels: %d elements, range [%d, %d)\n", size, begin, end);
+
+    {
+        std::vector<float> expected(size * 3, -7.0f), actual(size * 3, -7.0f);
+        CpuKernels::WindScalar(expected.data(), size, time, begin, end);
+        CpuKernels::WindAvx2(actual.data(), size, time, begin, end);
+        Compare("Wind", expected, actual, KERNEL_TOLERANCE);
+    }
+    {
+        // Точки по обе стороны от нуля и далеко от него: проверяется редукция аргумента
+        std::vector<float> xs = MakeInput(size, -300.0f, 600.0f);
+        std::vector<float> zs = MakeInput(size, -250.0f, 400.0f);
+        std::vector<float> expectedX(size, -7.0f), expectedZ(size, -7.0f), actualX(size, -7.0f), actualZ(size, -7.0f);
+        CpuKernels::WindPointsScalar(xs.data(), zs.data(), expectedX.data(), expectedZ.data(), time, begin, end);
+        CpuKernels::WindPointsAvx2(xs.data(), zs.data(), actualX.data(), actualZ.data(), time, begin, end);
+        Compare("WindPoints X", expectedX, actualX, KERNEL_TOLERANCE);
+        Compare("WindPoints Z", expectedZ, actualZ, KERNEL_TOLERANCE);
+    }
+    // Часть значений ниже/выше ограничения, часть нет
+    CheckRange("Suspension", CpuKernels::SuspensionScalar, CpuKernels::SuspensionAvx2, MakeInput(size, 0.0f, 0.05f), dt, begin, end, 0.0f);
+    CheckRange("Traction", CpuKernels::TractionScalar, CpuKernels::TractionAvx2, MakeInput(size, 0.95f, 0.1f), dt, begin, end, 0.0f);
+    CheckRange("Terrain", CpuKernels::TerrainScalar, CpuKernels::TerrainAvx2, MakeInput(size, -5.0f, 10.0f), dt, begin, end, KERNEL_TOLERANCE);
+
+    // Весь бэкенд: разбиение по пулу потоков не должно менять результат
+    CpuKernelBackend simdBackend(true);
+    {
+        std::vector<float> expected(size * 3), actual(size * 3);
+        scalarBackend.ComputeWind(expected.data(), size, time);
+        simdBackend.ComputeWind(actual.data(), size, time);
+        Compare("Backend Wind", expected, actual, KERNEL_TOLERANCE);
+    }
+    {
+        std::vector<float> xs = MakeInput(size, -300.0f, 600.0f);
+        std::vector<float> zs = MakeInput(size, -250.0f, 400.0f);
+        std::vector<float> expectedX(size), expectedZ(size), actualX(size), actualZ(size);
+        scalarBackend.ComputeWindPoints(xs.data(), zs.data(), expectedX.data(), expectedZ.data(), size, time);
+        simdBackend.ComputeWindPoints(xs.data(), zs.data(), actualX.data(), actualZ.data(), size, time);
+        Compare("Backend WindPoints X", expectedX, actualX, KERNEL_TOLERANCE);
+        Compare("Backend WindPoints Z", expectedZ, actualZ, KERNEL_TOLERANCE);
+    }
+    {
+        std::vector<float> expected = MakeInput(size, -5.0f, 10.0f);
+        std::vector<float> actual = expected;
+        scalarBackend.ComputeTerrain(expected.data(), size, dt);
+        simdBackend.ComputeTerrain(actual.data(), size, dt);
+        Compare("Backend Terrain", expected, actual, KERNEL_TOLERANCE);
+    }
+
+    std::vector<float> wind(size * 3);
+    double windScalarNs = MeasureNs(size, [&]() { CpuKernels::WindScalar(wind.data(), size, time, 0, size); });
+    double windSimdNs = MeasureNs(size, [&]() { CpuKernels::WindAvx2(wind.data(), size, time, 0, size); });
+    double windBackendNs = MeasureNs(size, [&]() { simdBackend.ComputeWind(wind.data(), size, time); });
+    std::printf("wind scalar:         %.2f ns/element\n", windScalarNs);
+    std::printf("wind AVX2:           %.2f ns/element (x%.1f)\n", windSimdNs, windScalarNs / windSimdNs);
+    std::printf("wind backend:        %.2f ns/element (%s, thread pool)\n", windBackendNs, simdBackend.GetName());
+
+    Logger::Close();
+    if (failures != 0) {
+        std::printf("FAIL: %d kernel results differ from the scalar reference\n", failures);
+        return 1;
+    }
+    std::printf("OK: AVX2 kernels match the scalar reference, context returns the previous frame\n");
+    return 0;
+}
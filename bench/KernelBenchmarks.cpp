@@ -0,0 +1,112 @@
+// Вычислительные ядра на CPU: скалярные эталоны против AVX2 на одном потоке
+// и CpuKernelBackend целиком (AVX2 + пул потоков)
+#include "Benchmark.hpp"
+#include "../cuda/CpuKernels.h"
+#include <vector>
+
+namespace {
+    // Полная сетка ветра прежнего WeatherSystem
+    constexpr int GRID_SIZE = 256 * 256;
+
+    using RangeKernel = void (*)(float*, float, int, int);
+
+    template<RangeKernel Kernel>
+    void RunRangeKernel(BenchmarkState& state, float initial) {
+        const int size = static_cast<int>(state.GetArg());
+        std::vector<float> data(size, initial);
+        while (state.KeepRunning()) {
+            Kernel(data.data(), 1.0f / 60.0f, 0, size);
+            Benchmark::DoNotOptimize(data.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * static_cast<uint64_t>(size));
+    }
+
+    void BM_Kernels_WindScalar(BenchmarkState& state) {
+        const int size = static_cast<int>(state.GetArg());
+        std::vector<float> wind(size * 3);
+        float time = 0.0f;
+        while (state.KeepRunning()) {
+            CpuKernels::WindScalar(wind.data(), size, time, 0, size);
+            time += 1.0f / 60.0f;
+            Benchmark::DoNotOptimize(wind.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * static_cast<uint64_t>(size));
+    }
+    RTGC_BENCHMARK(BM_Kernels_WindScalar)->Arg(GRID_SIZE);
+
+    void BM_Kernels_WindAvx2(BenchmarkState& state) {
+        const int size = static_cast<int>(state.GetArg());
+        std::vector<float> wind(size * 3);
+        float time = 0.0f;
+        while (state.KeepRunning()) {
+            CpuKernels::WindAvx2(wind.data(), size, time, 0, size);
+            time += 1.0f / 60.0f;
+            Benchmark::DoNotOptimize(wind.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * static_cast<uint64_t>(size));
+    }
+    RTGC_BENCHMARK(BM_Kernels_WindAvx2)->Arg(GRID_SIZE);
+
+    // Пакетный ветер для частиц: точки разбросаны по 2 км вокруг начала координат
+    void RunWindPoints(BenchmarkState& state, bool simd) {
+        const int count = static_cast<int>(state.GetArg());
+        std::vector<float> xs(count), zs(count), outX(count), outZ(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = static_cast<float>(i % 2000 - 1000) * 0.1f;
+            zs[i] = static_cast<float>((i * 7) % 2000 - 1000) * 0.1f;
+        }
+        auto kernel = simd ? CpuKernels::WindPointsAvx2 : CpuKernels::WindPointsScalar;
+        float time = 0.0f;
+        while (state.KeepRunning()) {
+            kernel(xs.data(), zs.data(), outX.data(), outZ.data(), time, 0, count);
+            time += 1.0f / 60.0f;
+            Benchmark::DoNotOptimize(outX.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * static_cast<uint64_t>(count));
+    }
+
+    void BM_Kernels_WindPointsScalar(BenchmarkState& state) { RunWindPoints(state, false); }
+    RTGC_BENCHMARK(BM_Kernels_WindPointsScalar)->Arg(4096);
+
+    void BM_Kernels_WindPointsAvx2(BenchmarkState& state) { RunWindPoints(state, true); }
+    RTGC_BENCHMARK(BM_Kernels_WindPointsAvx2)->Arg(4096);
+
+    // Подвеска и сцепление быстро упираются в ограничение, дальше меряется тот же путь
+    void BM_Kernels_SuspensionScalar(BenchmarkState& state) { RunRangeKernel<CpuKernels::SuspensionScalar>(state, 1.0f); }
+    RTGC_BENCHMARK(BM_Kernels_SuspensionScalar)->Arg(GRID_SIZE);
+
+    void BM_Kernels_SuspensionAvx2(BenchmarkState& state) { RunRangeKernel<CpuKernels::SuspensionAvx2>(state, 1.0f); }
+    RTGC_BENCHMARK(BM_Kernels_SuspensionAvx2)->Arg(GRID_SIZE);
+
+    void BM_Kernels_TractionScalar(BenchmarkState& state) { RunRangeKernel<CpuKernels::TractionScalar>(state, 0.5f); }
+    RTGC_BENCHMARK(BM_Kernels_TractionScalar)->Arg(GRID_SIZE);
+
+    void BM_Kernels_TractionAvx2(BenchmarkState& state) { RunRangeKernel<CpuKernels::TractionAvx2>(state, 0.5f); }
+    RTGC_BENCHMARK(BM_Kernels_TractionAvx2)->Arg(GRID_SIZE);
+
+    void BM_Kernels_TerrainScalar(BenchmarkState& state) { RunRangeKernel<CpuKernels::TerrainScalar>(state, 0.0f); }
+    RTGC_BENCHMARK(BM_Kernels_TerrainScalar)->Arg(GRID_SIZE);
+
+    void BM_Kernels_TerrainAvx2(BenchmarkState& state) { RunRangeKernel<CpuKernels::TerrainAvx2>(state, 0.0f); }
+    RTGC_BENCHMARK(BM_Kernels_TerrainAvx2)->Arg(GRID_SIZE);
+
+    // Бэкенд, который выбирается без GPU: AVX2 при наличии, куски по пулу потоков
+    void BM_Kernels_BackendWind(BenchmarkState& state) {
+        CpuKernelBackend backend;
+        const int size = static_cast<int>(state.GetArg());
+        std::vector<float> wind(size * 3);
+        float time = 0.0f;
+        while (state.KeepRunning()) {
+            backend.ComputeWind(wind.data(), size, time);
+            time += 1.0f / 60.0f;
+            Benchmark::DoNotOptimize(wind.data());
+            Benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.GetIterations() * static_cast<uint64_t>(size));
+    }
+    RTGC_BENCHMARK(BM_Kernels_BackendWind)->Arg(GRID_SIZE);
+}
@@ -0,0 +1,143 @@
+// Задержка вызова Logger::Log при конкуренции потоков.
+// Сравнивает асинхронный логгер с прежней схемой (мьютекс, put_time, flush на каждой строке).
+// Очередь не теряет сообщений: при заполнении вызов ждёт места, и это входит в задержку.
+// Если в лог попало не всё отправленное, бенчмарк завершается с кодом 1.
+// Запуск: LoggerBench [потоков=8] [сообщений на поток=20000]
+#include "../core/Logger.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+    // Прежний Logger::LogMessage, оставлен только для сравнения
+    class SyncLogger {
+        std::mutex logMutex;
+        std::ofstream logFile;
+
+    public:
+        explicit SyncLogger(const char* filename) : logFile(filename, std::ios::out | std::ios::trunc) {}
+
+        template<typename... Args>
+        void Log(const Args&... args) {
+            std::ostringstream message;
+            (message << ... << args);
+
+            std::lock_guard<std::mutex> lock(logMutex);
+            auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            std::tm tm;
+#ifdef _WIN32
+            localtime_s(&tm, &time);
+#else
+            localtime_r(&time, &tm);
+#endif
+            std::ostringstream threadId;
+            threadId << std::this_thread::get_id();
+
+            std::ostringstream oss;
+            oss << "[" << std::put_time(&tm, "%H:%M:%S") << "] [" << threadId.str() << "] [ИНФО] " << message.str();
+            logFile << oss.str() << std::endl;
+            logFile.flush();
+        }
+    };
+
+    struct Result {
+        double totalMs = 0.0;
+        std::vector<int64_t> latenciesNs;
+    };
+
+    Result Run(int threadCount, int perThread, const std::function<void(int, int)>& logCall) {
+        Result result;
+        std::vector<std::vector<int64_t>> perThreadLatency(threadCount);
+        std::vector<std::thread> threads;
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                std::vector<int64_t>& lat = perThreadLatency[t];
+                lat.reserve(perThread);
+                ready.fetch_add(1);
+                while (!go.load()) std::this_thread::yield();
+                for (int i = 0; i < perThread; ++i) {
+                    auto t0 = std::chrono::steady_clock::now();
+                    logCall(t, i);
+                    auto t1 = std::chrono::steady_clock::now();
+                    lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+                }
+            });
+        }
+        while (ready.load() < threadCount) std::this_thread::yield();
+        start = std::chrono::steady_clock::now();
+        go.store(true);
+        for (auto& th : threads) th.join();
+        result.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for (auto& lat : perThreadLatency) {
+            result.latenciesNs.insert(result.latenciesNs.end(), lat.begin(), lat.end());
+        }
+        std::sort(result.latenciesNs.begin(), result.latenciesNs.end());
+        return result;
+    }
+
+    void Print(const char* name, const Result& r) {
+        const std::vector<int64_t>& l = r.latenciesNs;
+        if (l.empty()) return;
+        auto at = [&](double q) { return l[std::min(l.size() - 1, static_cast<size_t>(q * l.size()))]; };
+        double mean = 0.0;
+        for (int64_t v : l) mean += static_cast<double>(v);
+        mean /= static_cast<double>(l.size());
+        std::printf("%-8s calls=%zu total=%.1f ms mean=%.0f ns p50=%lld ns p99=%lld ns p99.9=%lld ns max=%lld ns\n",
+                    name, l.size(), r.totalMs, mean,
+                    static_cast<long long>(at(0.5)), static_cast<long long>(at(0.99)),
+                    static_cast<long long>(at(0.999)), static_cast<long long>(l.back()));
+    }
+}
+
+int main(int argc, char** argv) {
+    int threadCount = argc > 1 ? std::atoi(argv[1]) : 8;
+    int perThread = argc > 2 ? std::atoi(argv[2]) : 20000;
+    if (threadCount < 1) threadCount = 1;
+    if (perThread < 1) perThread = 1;
+
+    std::printf("Logger contention: %d threads x %d messages\n", threadCount, perThread);
+
+    {
+        SyncLogger sync("logger_bench_sync.txt");
+        Result r = Run(threadCount, perThread, [&](int t, int i) {
+            sync.Log("Создан объект ", i, " в потоке ", t, " позиция (", i * 0.5f, ", 0, ", t * 2.0f, ")");
+        });
+        Print("sync", r);
+    }
+
+    Logger::EnableConsole(false);
+    // Запуск писателя и открытие файла - не часть замера
+    Logger::Log("LoggerBench: начало замера");
+    Logger::Flush();
+    uint64_t writtenBefore = Logger::GetWrittenCount();
+    uint64_t blockedBefore = Logger::GetBlockedCount();
+
+    Result r = Run(threadCount, perThread, [](int t, int i) {
+        Logger::Log("Создан объект ", i, " в потоке ", t, " позиция (", i * 0.5f, ", 0, ", t * 2.0f, ")");
+    });
+    auto flushStart = std::chrono::steady_clock::now();
+    Logger::Flush();
+    double flushMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - flushStart).count();
+    uint64_t sent = static_cast<uint64_t>(threadCount) * static_cast<uint64_t>(perThread);
+    uint64_t written = Logger::GetWrittenCount() - writtenBefore;
+    uint64_t blocked = Logger::GetBlockedCount() - blockedBefore;
+    Print("async", r);
+    std::printf("async drain after producers: %.1f ms, calls that waited for queue space: %llu\n",
+                flushMs, static_cast<unsigned long long>(blocked));
+    Logger::Close();
+
+    if (written != sent) {
+        std::printf("FAIL: %llu of %llu records reached the log\n",
+                    static_cast<unsigned long long>(written), static_cast<unsigned long long>(sent));
+        return 1;
+    }
+    std::printf("OK: all %llu records written\n", static_cast<unsigned long long>(sent));
+    return 0;
+}
@@ -0,0 +1,35 @@
+// Шаг PhysicsWorld на 1k, 10k и 100k тел
+#include "Benchmark.hpp"
+#include "../physics/PhysicsWorld.hpp"
+#include "../world/Terrain.hpp"
+#include <cmath>
+
+namespace {
+    // Тела сеткой с шагом 1.5 м над ландшафтом, разной высоты; соседние ряды касаются при отскоке.
+    // Сон выключен: иначе через полсекунды модели все тела уснут и шаг перестанет что-либо считать.
+    void BM_PhysicsWorld_Update(BenchmarkState& state) {
+        Terrain terrain;
+        terrain.Initialize();
+        PhysicsWorld world;
+        world.SetTerrain(&terrain);
+        world.SetTimeToSleep(1e9f);
+
+        int count = static_cast<int>(state.GetArg());
+        int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+        for (int i = 0; i < count; ++i) {
+            float x = static_cast<float>(i % side) * 1.5f;
+            float z = static_cast<float>(i / side) * 1.5f;
+            world.CreateBody(Vector3(x, 3.0f + static_cast<float>(i % 7) * 0.5f, z), 1.0f);
+        }
+
+        const float dt = 1.0f / 60.0f;
+        // Тела успевают упасть: замеряется установившийся режим с контактами о землю
+        for (int i = 0; i < 60; ++i) world.Update(dt);
+
+        while (state.KeepRunning()) {
+            world.Update(dt);
+        }
+        state.SetItemsProcessed(state.GetIterations() * static_cast<uint64_t>(count));
+    }
+    RTGC_BENCHMARK(BM_PhysicsWorld_Update)->Arg(1000)->Arg(10000)->Arg(100000);
+}
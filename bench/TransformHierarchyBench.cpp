@@ -0,0 +1,233 @@
+// Проверка и замер TransformHierarchy.
+// Проверяется: мировая матрица = родитель * локальная (точки сверяются с ручным применением TRS
+// по цепочке), неизменённый кадр пересчитывает 0 узлов, изменение узла пересчитывает только его
+// поддерево, Destroy переносит последний узел на место удалённого без дыр в буфере матриц,
+// SetParent не создаёт циклов. При любой ошибке бенчмарк завершается с кодом 1.
+// Запуск: TransformHierarchyBench [узлов=10000]
+#include "../systems/TransformHierarchy.hpp"
+#include "../core/Logger.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr float TOLERANCE = 1e-4f;
+    constexpr int FRAMES = 200;
+
+    int failures = 0;
+
+    void Check(bool ok, const char* what) {
+        if (ok) return;
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+
+    struct Trs {
+        Vector3 position;
+        Quat rotation;
+        Vector3 scale;
+    };
+
+    // Локальная трансформация точки без Mat4: масштаб, поворот, перенос
+    Vec3 Apply(const Trs& t, const Vec3& p) {
+        Vec3 scaled(p.x * t.scale.x, p.y * t.scale.y, p.z * t.scale.z);
+        return t.rotation.Rotate(scaled) + Vec3(t.position);
+    }
+
+    bool Near(const Vec3& a, const Vec3& b) {
+        return std::fabs(a.x - b.x) <= TOLERANCE && std::fabs(a.y - b.y) <= TOLERANCE && std::fabs(a.z - b.z) <= TOLERANCE;
+    }
+
+    bool SameMatrix(const Mat4& a, const Mat4& b) {
+        for (int c = 0; c < 4; ++c) {
+            const Vec4& x = a.columns[c];
+            const Vec4& y = b.columns[c];
+            if (std::fabs(x.x - y.x) > TOLERANCE || std::fabs(x.y - y.y) > TOLERANCE ||
+                std::fabs(x.z - y.z) > TOLERANCE || std::fabs(x.w - y.w) > TOLERANCE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Mat4 LocalMatrix(const Trs& t) {
+        return Mat4::TRS(Vec3(t.position), t.rotation, Vec3(t.scale));
+    }
+
+    void CheckComposition() {
+        const Trs root{Vector3(10.0f, 0.0f, -5.0f), Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 0.7f), Vector3(2.0f, 2.0f, 2.0f)};
+        const Trs mid{Vector3(0.0f, 3.0f, 1.0f), Quat::FromAxisAngle(Vec3(1.0f, 0.0f, 0.0f), -0.4f), Vector3(1.0f, 0.5f, 1.0f)};
+        const Trs leaf{Vector3(-1.0f, 0.0f, 2.0f), Quat::FromAxisAngle(Vec3(0.0f, 0.0f, 1.0f), 1.2f), Vector3(3.0f, 1.0f, 1.0f)};
+
+        TransformHierarchy h;
+        // Дети создаются раньше родителей: порядок пересчёта не должен зависеть от порядка в буфере
+        uint32_t leafNode = h.Create();
+        uint32_t midNode = h.Create();
+        uint32_t rootNode = h.Create();
+        h.SetParent(leafNode, midNode);
+        h.SetParent(midNode, rootNode);
+        h.SetLocal(rootNode, root.position, root.rotation, root.scale);
+        h.SetLocal(midNode, mid.position, mid.rotation, mid.scale);
+        h.SetLocal(leafNode, leaf.position, leaf.rotation, leaf.scale);
+        h.Update();
+
+        const Vec3 points[] = {Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 2.0f, 3.0f), Vec3(-4.0f, 0.5f, 7.0f)};
+        bool ok = true;
+        for (const Vec3& p : points) {
+            ok &= Near(h.GetWorld(leafNode).TransformPoint(p), Apply(root, Apply(mid, Apply(leaf, p))));
+            ok &= Near(h.GetWorld(midNode).TransformPoint(p), Apply(root, Apply(mid, p)));
+            ok &= Near(h.GetWorld(rootNode).TransformPoint(p), Apply(root, p));
+        }
+        Check(ok, "world matrix differs from parent * local applied by hand");
+        Check(SameMatrix(h.GetWorld(leafNode), LocalMatrix(root) * LocalMatrix(mid) * LocalMatrix(leaf)),
+              "world matrix differs from TRS(root) * TRS(mid) * TRS(leaf)");
+    }
+
+    void CheckDirtyPropagation() {
+        // Два поддерева: root -> a -> a1, a2 и root -> b -> b1
+        TransformHierarchy h;
+        uint32_t root = h.Create();
+        uint32_t a = h.Create(root);
+        uint32_t a1 = h.Create(a);
+        uint32_t a2 = h.Create(a);
+        uint32_t b = h.Create(root);
+        uint32_t b1 = h.Create(b);
+        const Vector3 one(1.0f, 1.0f, 1.0f);
+
+        Check(h.Update() == 6, "first Update must compute every node");
+        Check(h.Update() == 0, "unchanged frame must update 0 nodes");
+
+        h.SetLocal(a, Vector3(0.0f, 0.0f, 0.0f), Quat(), one);
+        Check(h.Update() == 0, "SetLocal with the same values must not mark the node dirty");
+
+        Mat4 b1Before = h.GetWorld(b1);
+        h.SetLocal(a, Vector3(1.0f, 2.0f, 3.0f), Quat(), one);
+        Check(h.Update() == 3, "changing a node must update exactly it and its descendants");
+        Check(Near(h.GetWorld(a2).TransformPoint(Vec3()), Vec3(1.0f, 2.0f, 3.0f)), "descendant did not follow its parent");
+        Check(SameMatrix(h.GetWorld(b1), b1Before), "sibling subtree changed");
+        Check(h.Update() == 0, "frame after a change must update 0 nodes");
+
+        h.SetLocal(root, Vector3(0.0f, 10.0f, 0.0f), Quat(), one);
+        Check(h.Update() == 6, "changing the root must update the whole tree");
+        Check(Near(h.GetWorld(a1).TransformPoint(Vec3()), Vec3(1.0f, 12.0f, 3.0f)), "grandchild did not follow the root");
+
+        h.SetParent(b1, a);
+        Check(h.Update() == 1, "reparenting must update only the moved node");
+        Check(Near(h.GetWorld(b1).TransformPoint(Vec3()), Vec3(1.0f, 12.0f, 3.0f)), "reparented node ignores its new parent");
+    }
+
+    void CheckDestroy() {
+        TransformHierarchy h;
+        const Vector3 one(1.0f, 1.0f, 1.0f);
+        uint32_t first = h.Create();
+        uint32_t parent = h.Create();
+        uint32_t child = h.Create(parent);
+        uint32_t last = h.Create();
+        h.SetLocal(parent, Vector3(5.0f, 0.0f, 0.0f), Quat(), one);
+        h.SetLocal(child, Vector3(0.0f, 1.0f, 0.0f), Quat(), one);
+        h.SetLocal(last, Vector3(0.0f, 0.0f, 7.0f), Quat(), one);
+        h.Update();
+
+        // Последний узел занимает освободившийся индекс, остальные индексы не меняются
+        uint32_t childIndex = h.GetMatrixIndex(child);
+        h.Destroy(first);
+        Check(!h.IsValid(first), "destroyed node is still valid");
+        Check(h.GetMatrixCount() == 3, "matrix buffer must shrink by one");
+        Check(h.GetMatrixIndex(last) == 0, "last node must move into the freed index");
+        Check(h.GetMatrixIndex(child) == childIndex, "untouched node changed its index");
+        Check(Near(h.GetWorld(last).TransformPoint(Vec3()), Vec3(0.0f, 0.0f, 7.0f)), "moved node lost its world matrix");
+        Check(h.Update() == 0, "swap-remove alone must not dirty other nodes");
+
+        bool dense = true;
+        for (uint32_t node : {parent, child, last}) {
+            dense &= SameMatrix(h.GetMatrices()[h.GetMatrixIndex(node)], h.GetWorld(node));
+        }
+        Check(dense, "GetMatrices()[GetMatrixIndex(node)] differs from GetWorld(node)");
+
+        // Дети уничтоженного узла становятся корневыми
+        h.Destroy(parent);
+        Check(h.GetParent(child) == TransformHierarchy::INVALID, "child of a destroyed node must become a root");
+        h.Update();
+        Check(Near(h.GetWorld(child).TransformPoint(Vec3()), Vec3(0.0f, 1.0f, 0.0f)), "orphan must use its local transform as world");
+
+        // Освобождённый дескриптор переиспользуется, новый узел начинается с единичной трансформации
+        uint32_t reused = h.Create();
+        h.Update();
+        Check(reused == parent || reused == first, "freed handle must be reused");
+        Check(SameMatrix(h.GetWorld(reused), Mat4::Identity()), "new node must start with an identity transform");
+        Check(h.GetMatrixCount() == 3, "matrix buffer must grow by one after Create");
+    }
+
+    void CheckCycles() {
+        TransformHierarchy h;
+        uint32_t root = h.Create();
+        uint32_t child = h.Create(root);
+        uint32_t grandchild = h.Create(child);
+
+        h.SetParent(root, grandchild);
+        Check(h.GetParent(root) == TransformHierarchy::INVALID, "node became a descendant of its own grandchild");
+        h.SetParent(child, child);
+        Check(h.GetParent(child) == root, "node became its own parent");
+        h.SetParent(root, child);
+        Check(h.GetParent(root) == TransformHierarchy::INVALID, "node became a descendant of its own child");
+
+        // После отклонённых вызовов иерархия по-прежнему считается
+        Check(h.Update() == 3, "hierarchy must still update after rejected cycles");
+    }
+
+    template<typename Fn>
+    double MeasureUs(Fn&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < FRAMES; ++i) fn(i);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / FRAMES;
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t nodeCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 10000;
+    if (nodeCount < 5) nodeCount = 5;
+
+    // Отклонённые циклы пишут предупреждение в лог, в консоли оно не нужно
+    Logger::EnableConsole(false);
+
+    CheckComposition();
+    CheckDirtyPropagation();
+    CheckDestroy();
+    CheckCycles();
+
+    // Та же сцена, что в BM_TransformHierarchy_Update: корни с четырьмя потомками
+    TransformHierarchy h;
+    std::vector<uint32_t> nodes;
+    nodes.reserve(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        uint32_t parent = i % 5 == 0 ? TransformHierarchy::INVALID : nodes[i - i % 5];
+        nodes.push_back(h.Create(parent));
+        h.SetLocal(nodes.back(), Vector3(static_cast<float>(i), 0.0f, 1.0f), Quat(), Vector3(1.0f, 1.0f, 1.0f));
+    }
+    h.Update();
+
+    size_t idleUpdated = 0;
+    double idleUs = MeasureUs([&](int) { idleUpdated += h.Update(); });
+    double rootsUs = MeasureUs([&](int frame) {
+        for (uint32_t i = 0; i < nodeCount; i += 5) {
+            h.SetLocal(nodes[i], Vector3(static_cast<float>(i), static_cast<float>(frame), 1.0f), Quat(), Vector3(1.0f, 1.0f, 1.0f));
+        }
+        h.Update();
+    });
+    Check(idleUpdated == 0, "unchanged frames of the large scene updated nodes");
+
+    std::printf("TransformHierarchy: %u nodes, %d frames\n", nodeCount, FRAMES);
+    std::printf("unchanged frame:     %.1f us (%zu nodes updated)\n", idleUs, idleUpdated);
+    std::printf("all roots moved:     %.1f us (%zu nodes updated)\n", rootsUs, h.GetLastUpdatedCount());
+
+    Logger::Close();
+    if (failures != 0) {
+        std::printf("FAIL: %d TransformHierarchy checks failed\n", failures);
+        return 1;
+    }
+    std::printf("OK: composition, dirty propagation, swap-remove and cycle rejection\n");
+    return 0;
+}
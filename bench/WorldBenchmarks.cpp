@@ -0,0 +1,122 @@
+// Генерация мира, ландшафт и разбор OSM
+#include "Benchmark.hpp"
+#include "../world/WorldConfig.hpp"
+#include "../world/Terrain.hpp"
+#include "../world/OSMParser.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    // Аргумент - WorldConfig::MapSize: 0 - 256x256, 1 - 512x512, 2 - 1024x1024, 3 - 2048x2048
+    void BM_WorldGenerator_Generate(BenchmarkState& state) {
+        WorldConfig::WorldSettings settings;
+        settings.mapSize = static_cast<WorldConfig::MapSize>(state.GetArg());
+        settings.seed = 12345;
+        WorldConfig::WorldGenerator generator(settings);
+        while (state.KeepRunning()) {
+            generator.Generate();
+            Benchmark::DoNotOptimize(generator.GetVegetation().data());
+        }
+    }
+    RTGC_BENCHMARK(BM_WorldGenerator_Generate)->Arg(0)->Arg(1)->Arg(2)->Arg(3);
+
+    void BM_Terrain_GetVertices(BenchmarkState& state) {
+        Terrain terrain;
+        terrain.Initialize();
+        std::vector<float> vertices;
+        while (state.KeepRunning()) {
+            terrain.GetVertices(vertices);
+            Benchmark::DoNotOptimize(vertices.data());
+        }
+        state.SetBytesProcessed(state.GetIterations() * vertices.size() * sizeof(float));
+    }
+    RTGC_BENCHMARK(BM_Terrain_GetVertices);
+
+    // Точки вразброс по карте и немного за её краем, как у тел физики
+    constexpr size_t QUERY_COUNT = 1024;
+
+    void MakeQueryPoints(std::vector<float>& xs, std::vector<float>& zs) {
+        xs.resize(QUERY_COUNT);
+        zs.resize(QUERY_COUNT);
+        uint32_t s = 2463534242u;
+        for (size_t i = 0; i < QUERY_COUNT; ++i) {
+            s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+            xs[i] = static_cast<float>(s % 7000) / 100.0f - 3.0f;
+            s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+            zs[i] = static_cast<float>(s % 7000) / 100.0f - 3.0f;
+        }
+    }
+
+    void BM_Terrain_GetHeightAt(BenchmarkState& state) {
+        Terrain terrain;
+        terrain.Initialize();
+        std::vector<float> xs, zs;
+        MakeQueryPoints(xs, zs);
+        while (state.KeepRunning()) {
+            float sum = 0.0f;
+            for (size_t i = 0; i < QUERY_COUNT; ++i) sum += terrain.GetHeightAt(xs[i], zs[i]);
+            Benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.GetIterations() * QUERY_COUNT);
+    }
+    RTGC_BENCHMARK(BM_Terrain_GetHeightAt);
+
+    void BM_Terrain_GetHeightsAt(BenchmarkState& state) {
+        Terrain terrain;
+        terrain.Initialize();
+        std::vector<float> xs, zs;
+        MakeQueryPoints(xs, zs);
+        std::vector<float> heights(QUERY_COUNT);
+        while (state.KeepRunning()) {
+            terrain.GetHeightsAt(xs.data(), zs.data(), heights.data(), QUERY_COUNT);
+            Benchmark::DoNotOptimize(heights.data());
+        }
+        state.SetItemsProcessed(state.GetIterations() * QUERY_COUNT);
+    }
+    RTGC_BENCHMARK(BM_Terrain_GetHeightsAt);
+
+    // Синтетическая выгрузка OSM: сетка side x side узлов, дорога вдоль каждой строки
+    // и здание (путь без highway) на каждую вторую строку
+    std::string MakeOsmSample(int side) {
+        std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<osm version=\"0.6\">\n";
+        char line[160];
+        for (int row = 0; row < side; ++row) {
+            for (int col = 0; col < side; ++col) {
+                std::snprintf(line, sizeof(line), "  <node id=\"%d\" lat=\"%.7f\" lon=\"%.7f\"/>\n",
+                              row * side + col + 1, 55.0 + row * 0.0001, 82.9 + col * 0.0001);
+                xml += line;
+            }
+        }
+        int wayId = 1;
+        for (int row = 0; row < side; ++row) {
+            std::snprintf(line, sizeof(line), "  <way id=\"%d\">\n", wayId++);
+            xml += line;
+            for (int col = 0; col < side; ++col) {
+                std::snprintf(line, sizeof(line), "    <nd ref=\"%d\"/>\n", row * side + col + 1);
+                xml += line;
+            }
+            xml += "    <tag k=\"highway\" v=\"residential\"/>\n  </way>\n";
+            if (row % 2 == 0 && side >= 2) {
+                std::snprintf(line, sizeof(line),
+                              "  <way id=\"%d\">\n    <nd ref=\"%d\"/>\n    <nd ref=\"%d\"/>\n"
+                              "    <tag k=\"building\" v=\"yes\"/>\n  </way>\n",
+                              wayId++, row * side + 1, row * side + 2);
+                xml += line;
+            }
+        }
+        xml += "</osm>\n";
+        return xml;
+    }
+
+    // Аргумент - сторона сетки узлов
+    void BM_OSMParser_ParseRoadsFromXML(BenchmarkState& state) {
+        std::string xml = MakeOsmSample(static_cast<int>(state.GetArg()));
+        while (state.KeepRunning()) {
+            auto roads = OSMParser::ParseRoadsFromXML(xml);
+            Benchmark::DoNotOptimize(roads.data());
+        }
+        state.SetBytesProcessed(state.GetIterations() * xml.size());
+    }
+    RTGC_BENCHMARK(BM_OSMParser_ParseRoadsFromXML)->Arg(16)->Arg(64);
+}
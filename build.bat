@@ -1,6 +1,6 @@
 @echo off
 set INCLUDES=-Iinclude -Iinclude/glm -Iinclude/entt/include -Iinclude/enet/include -Iinclude/tinyobjloader -Iinclude/miniaudio -Iinclude/stb
-set FLAGS=-std=c++20 -O2 %INCLUDES% -DGLFW_INCLUDE_NONE -fopenmp
+set FLAGS=-std=c++20 -O2 %INCLUDES% -DGLFW_INCLUDE_NONE -DRTGC_WITH_CUDA -fopenmp
 echo [CUDA] Компиляция ядер...
 nvcc -c src/cuda/WindCuda.cu -o WindCuda.obj -arch=sm_50
 nvcc -c src/cuda/SuspensionCuda.cu -o SuspensionCuda.obj -arch=sm_50
@@ -0,0 +1,2 @@
+// Пустой файл для заголовка TransformParentComponent.hpp
+// Структура TransformParentComponent не содержит методов, только данные.
\ No newline at end of file
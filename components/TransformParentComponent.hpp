@@ -0,0 +1,8 @@
+#pragma once
+#include <entt/entt.hpp>
+
+// Родитель в иерархии трансформаций: TransformComponent сущности задаётся относительно родителя.
+// Мировые матрицы считает TransformSystem; entt::null или уничтоженный родитель - корневая сущность.
+struct TransformParentComponent {
+    entt::entity parent = entt::null;
+};
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "Allocators.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+ArenaAllocator::ArenaAllocator(MemoryTag ownerTag, size_t initialBlockSize)
+    : blockSize(std::max<size_t>(initialBlockSize, 256)), tag(ownerTag) {
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    Release();
+}
+
+void* ArenaAllocator::Allocate(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+    while (true) {
+        // Текущий блок, затем следующие уже выделенные; новый - только если ни один не подошёл
+        for (; currentBlock < blocks.size(); ++currentBlock, offset = 0) {
+            const Block& block = blocks[currentBlock];
+            uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            size_t start = static_cast<size_t>(aligned - base);
+            if (start + size <= block.size) {
+                offset = start + size;
+                usedBytes += size;
+                peakBytes = std::max(peakBytes, usedBytes);
+                return reinterpret_cast<void*>(aligned);
+            }
+        }
+
+        size_t newSize = std::max(blockSize, size + alignment);
+        void* data = MemoryTracker::Allocate(newSize, tag, alignof(std::max_align_t), "ArenaAllocator");
+        blocks.push_back(Block{static_cast<uint8_t*>(data), newSize});
+        currentBlock = blocks.size() - 1;
+        offset = 0;
+    }
+}
+
+void ArenaAllocator::Reset() {
+    currentBlock = 0;
+    offset = 0;
+    usedBytes = 0;
+}
+
+void ArenaAllocator::Release() {
+    for (const Block& block : blocks) {
+        MemoryTracker::Free(block.data, block.size, tag, alignof(std::max_align_t));
+    }
+    blocks.clear();
+    Reset();
+}
+
+size_t ArenaAllocator::GetCapacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks) total += block.size;
+    return total;
+}
+
+PoolAllocator::PoolAllocator(MemoryTag ownerTag, size_t objectSize, size_t objectAlignment, size_t objectsPerChunk)
+    : alignment(std::max(objectAlignment, alignof(FreeNode))),
+      slotsPerChunk(std::max<size_t>(objectsPerChunk, 1)),
+      tag(ownerTag) {
+    // Свободный слот хранит указатель на следующий, поэтому слот не меньше указателя
+    size_t size = std::max(objectSize, sizeof(FreeNode));
+    slotSize = (size + alignment - 1) / alignment * alignment;
+}
+
+PoolAllocator::~PoolAllocator() {
+    if (liveCount > 0) {
+        Logger::Warning("Пул [", MemoryTracker::GetTagName(tag), "] удалён, не освобождено объектов: ", liveCount);
+    }
+    for (void* chunk : chunks) {
+        MemoryTracker::Free(chunk, slotSize * slotsPerChunk, tag, alignment);
+    }
+}
+
+void PoolAllocator::AddChunk() {
+    uint8_t* chunk = static_cast<uint8_t*>(MemoryTracker::Allocate(slotSize * slotsPerChunk, tag, alignment, "PoolAllocator"));
+    chunks.push_back(chunk);
+    // Слоты связываются в обратном порядке, чтобы выдавались с начала пачки
+    for (size_t i = slotsPerChunk; i-- > 0;) {
+        FreeNode* node = reinterpret_cast<FreeNode*>(chunk + i * slotSize);
+        node->next = freeList;
+        freeList = node;
+    }
+}
+
+void* PoolAllocator::Allocate() {
+    if (!freeList) AddChunk();
+    FreeNode* node = freeList;
+    freeList = node->next;
+    ++liveCount;
+    return node;
+}
+
+void PoolAllocator::Free(void* p) {
+    if (!p) return;
+    FreeNode* node = static_cast<FreeNode*>(p);
+    node->next = freeList;
+    freeList = node;
+    --liveCount;
+}
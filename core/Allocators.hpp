@@ -0,0 +1,113 @@
+#pragma once
+#include "MemoryTracker.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Линейный аллокатор: выделение - сдвиг указателя, освобождение - только всё разом через Reset.
+// Блоки берутся у MemoryTracker с тегом владельца и после Reset переиспользуются,
+// поэтому в установившемся режиме куча не трогается. Не потокобезопасен.
+class ArenaAllocator {
+    struct Block {
+        uint8_t* data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t currentBlock = 0;
+    size_t offset = 0;
+    size_t usedBytes = 0;
+    size_t peakBytes = 0;
+    size_t blockSize;
+    MemoryTag tag;
+
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit ArenaAllocator(MemoryTag ownerTag, size_t initialBlockSize = DEFAULT_BLOCK_SIZE);
+    ~ArenaAllocator();
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Деструкторы объектов арены не вызываются: только для типов, которым это не нужно
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Всё выделенное становится недействительным; блоки остаются для следующего круга
+    void Reset();
+    // Отдать блоки обратно в кучу
+    void Release();
+
+    size_t GetUsedBytes() const { return usedBytes; }
+    size_t GetPeakBytes() const { return peakBytes; }
+    size_t GetCapacity() const;
+    size_t GetBlockCount() const { return blocks.size(); }
+    MemoryTag GetTag() const { return tag; }
+};
+
+// Пул блоков одного размера: выделение и освобождение - операции со списком свободных.
+// Память берётся пачками у MemoryTracker и возвращается только в деструкторе. Не потокобезопасен.
+class PoolAllocator {
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    std::vector<void*> chunks;
+    FreeNode* freeList = nullptr;
+    size_t slotSize;
+    size_t alignment;
+    size_t slotsPerChunk;
+    size_t liveCount = 0;
+    MemoryTag tag;
+
+    void AddChunk();
+
+public:
+    PoolAllocator(MemoryTag ownerTag, size_t objectSize, size_t objectAlignment, size_t objectsPerChunk = 64);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* Allocate();
+    void Free(void* p);
+
+    size_t GetLiveCount() const { return liveCount; }
+    size_t GetCapacity() const { return chunks.size() * slotsPerChunk; }
+    MemoryTag GetTag() const { return tag; }
+};
+
+// Пул объектов типа T поверх PoolAllocator
+template<typename T>
+class ObjectPool {
+    PoolAllocator pool;
+
+public:
+    explicit ObjectPool(MemoryTag ownerTag, size_t objectsPerChunk = 64)
+        : pool(ownerTag, sizeof(T), alignof(T), objectsPerChunk) {}
+
+    template<typename... Args>
+    T* New(Args&&... args) {
+        void* p = pool.Allocate();
+        try {
+            return new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool.Free(p);
+            throw;
+        }
+    }
+
+    void Delete(T* p) {
+        if (!p) return;
+        p->~T();
+        pool.Free(p);
+    }
+
+    size_t GetLiveCount() const { return pool.GetLiveCount(); }
+};
@@ -0,0 +1,120 @@
+#include "AutosaveService.hpp"
+#include "SnapshotSystem.hpp"
+#include <chrono>
+#include <filesystem>
+
+AutosaveService::AutosaveService() {
+    ioThread = std::thread([this]() { IoLoop(); });
+}
+
+AutosaveService::~AutosaveService() {
+    Shutdown(true);
+}
+
+void AutosaveService::Start(float intervalSeconds, const std::string& filename) {
+    interval = intervalSeconds;
+    defaultFile = filename;
+    timer = 0.0f;
+    enabled = true;
+}
+
+void AutosaveService::Update(float dt, const GameLevel& level, const WeatherSystem& weather) {
+    if (!enabled) return;
+    timer += dt;
+    if (timer < interval) return;
+    timer = 0.0f;
+    SaveNow(level, weather);
+}
+
+void AutosaveService::SaveNow(const GameLevel& level, const WeatherSystem& weather, const std::string& filename) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<SnapshotState> state;
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (stopping) return;
+        state = std::move(spare);
+    }
+    if (!state) state = std::make_unique<SnapshotState>();
+
+    SnapshotSystem::Capture(level, weather, *state);
+    lastCaptureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    auto job = std::make_unique<Job>();
+    job->filename = filename.empty() ? defaultFile : filename;
+    job->state = std::move(state);
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (pending) {
+            Logger::Warning("Автосохранение: предыдущее ещё не записано, заменяем его новым");
+        }
+        pending = std::move(job);
+    }
+    jobCv.notify_one();
+    LOG_DEBUG(Core, "Автосохранение: захват ", lastCaptureMs, " мс");
+}
+
+void AutosaveService::Cancel() {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    pending.reset();
+    if (writing) cancelRequested.store(true);
+}
+
+void AutosaveService::Shutdown(bool flush) {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (stopping && !ioThread.joinable()) return;
+        stopping = true;
+        enabled = false;
+        if (!flush) {
+            pending.reset();
+            if (writing) cancelRequested.store(true);
+        }
+    }
+    jobCv.notify_all();
+    if (ioThread.joinable()) ioThread.join();
+}
+
+bool AutosaveService::IsBusy() const {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    return writing || pending != nullptr;
+}
+
+void AutosaveService::IoLoop() {
+    while (true) {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCv.wait(lock, [this]() { return stopping || pending != nullptr; });
+            if (!pending) return; // остановка и очередь пуста
+            job = std::move(pending);
+            writing = true;
+            cancelRequested.store(false);
+        }
+
+        std::error_code ec;
+        std::filesystem::path parent = std::filesystem::path(job->filename).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+
+        // Другой файл - другой журнал, начинаем с контрольной точки
+        if (job->filename != journalName) {
+            journal.SetFile(job->filename);
+            journalName = job->filename;
+            base.reset();
+        }
+
+        bool ok = journal.Write(*job->state, base.get(), &cancelRequested);
+        if (ok) {
+            savesWritten.fetch_add(1);
+            lastSaveBytes.store(journal.GetLastWriteBytes());
+            // Записанное состояние - база следующей дельты, старая база идёт под захват
+            std::swap(base, job->state);
+        } else if (!cancelRequested.load()) {
+            savesFailed.fetch_add(1);
+        }
+
+        std::lock_guard<std::mutex> lock(jobMutex);
+        writing = false;
+        if (job->state) spare = std::move(job->state);
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include "SnapshotJournal.hpp"
+
+class GameLevel;
+class WeatherSystem;
+struct SnapshotState;
+
+// Автосохранение без остановки игры: на главном потоке состояние уровня
+// копируется в SnapshotState (плоские массивы, буферы переиспользуются),
+// сериализация, сжатие и запись с атомарным переименованием идут в I/O-потоке.
+// Пишется дельта к прошлому сохранению в журнал, периодически - полная точка.
+class AutosaveService {
+    struct Job {
+        std::string filename;
+        std::unique_ptr<SnapshotState> state;
+    };
+
+    std::thread ioThread;
+    mutable std::mutex jobMutex;
+    std::condition_variable jobCv;
+    std::unique_ptr<Job> pending;          // новый захват заменяет ещё не начатый
+    std::unique_ptr<SnapshotState> spare;  // отработавшее состояние для следующего захвата
+    std::unique_ptr<SnapshotState> base;   // записанное прошлым сохранением (только I/O-поток)
+    SnapshotJournal journal;               // только I/O-поток
+    std::string journalName;
+    bool writing = false;
+    bool stopping = false;
+    std::atomic<bool> cancelRequested{false};
+
+    std::string defaultFile = "save/autosave.dat";
+    float interval = 300.0f;
+    float timer = 0.0f;
+    bool enabled = false;
+
+    double lastCaptureMs = 0.0;
+    std::atomic<uint64_t> savesWritten{0};
+    std::atomic<uint64_t> savesFailed{0};
+    std::atomic<uint64_t> lastSaveBytes{0};
+
+    void IoLoop();
+
+public:
+    AutosaveService();
+    ~AutosaveService();
+
+    AutosaveService(const AutosaveService&) = delete;
+    AutosaveService& operator=(const AutosaveService&) = delete;
+
+    // Сохранение каждые intervalSeconds игрового времени в filename
+    void Start(float intervalSeconds = 300.0f, const std::string& filename = "save/autosave.dat");
+    void Stop() { enabled = false; }
+
+    // Главный поток, между шагами физики
+    void Update(float dt, const GameLevel& level, const WeatherSystem& weather);
+    void SaveNow(const GameLevel& level, const WeatherSystem& weather, const std::string& filename = "");
+
+    // Снимает ожидающее сохранение и прерывает текущее; прежний файл остаётся целым
+    void Cancel();
+    // flush = true: дописать ожидающее сохранение перед остановкой потока
+    void Shutdown(bool flush = true);
+
+    bool IsBusy() const;
+    double GetLastCaptureMs() const { return lastCaptureMs; }
+    uint64_t GetSavesWritten() const { return savesWritten.load(); }
+    uint64_t GetSavesFailed() const { return savesFailed.load(); }
+    uint64_t GetLastSaveBytes() const { return lastSaveBytes.load(); }
+    // Каждые deltas сохранений - полная контрольная точка. До первого сохранения.
+    void SetCheckpointInterval(uint32_t deltas) { journal.SetCheckpointInterval(deltas); }
+};
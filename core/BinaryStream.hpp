@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Запись и чтение простых типов в байтовый буфер (little-endian, как на целевых платформах).
+// Структуры пишутся по полям, чтобы формат не зависел от выравнивания компилятора.
+class ByteWriter {
+    std::vector<uint8_t>& out;
+
+public:
+    explicit ByteWriter(std::vector<uint8_t>& buffer) : out(buffer) {}
+
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteWriter::Write: только тривиальные типы");
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        size_t offset = out.size();
+        out.resize(offset + size);
+        if (size > 0) std::memcpy(out.data() + offset, data, size);
+    }
+
+    void WriteString(const std::string& s) {
+        Write<uint32_t>(static_cast<uint32_t>(s.size()));
+        WriteBytes(s.data(), s.size());
+    }
+
+    void Reserve(size_t bytes) { out.reserve(out.size() + bytes); }
+    size_t GetSize() const { return out.size(); }
+};
+
+// Любое чтение за концом буфера переводит читатель в состояние ошибки,
+// дальнейшие чтения возвращают false и нули.
+class ByteReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool failed = false;
+
+public:
+    ByteReader(const uint8_t* d, size_t s) : data(d), size(s) {}
+    explicit ByteReader(const std::vector<uint8_t>& buffer) : data(buffer.data()), size(buffer.size()) {}
+
+    template<typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteReader::Read: только тривиальные типы");
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    T Read() {
+        T value{};
+        Read(value);
+        return value;
+    }
+
+    bool ReadBytes(void* dst, size_t n) {
+        if (failed || n > size - pos) {
+            failed = true;
+            std::memset(dst, 0, n);
+            return false;
+        }
+        if (n > 0) std::memcpy(dst, data + pos, n);
+        pos += n;
+        return true;
+    }
+
+    bool Skip(size_t n) {
+        if (failed || n > size - pos) {
+            failed = true;
+            return false;
+        }
+        pos += n;
+        return true;
+    }
+
+    bool ReadString(std::string& s) {
+        uint32_t length = 0;
+        if (!Read(length) || length > size - pos) {
+            failed = true;
+            s.clear();
+            return false;
+        }
+        s.assign(reinterpret_cast<const char*>(data + pos), length);
+        pos += length;
+        return true;
+    }
+
+    bool IsOk() const { return !failed; }
+    size_t GetRemaining() const { return failed ? 0 : size - pos; }
+};
@@ -0,0 +1,137 @@
+#include "BlockCompressor.hpp"
+#include <cstring>
+#include <vector>
+
+namespace {
+    constexpr int HASH_BITS = 14;
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+    // Последние байты блока всегда идут литералами: декодер не читает за концом
+    constexpr size_t LAST_LITERALS = 5;
+    constexpr size_t MATCH_LIMIT = 12;
+
+    inline uint32_t Read32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint32_t Hash(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Длины >= 15 продолжаются байтами 255 и остатком
+    inline bool WriteLength(uint8_t*& out, const uint8_t* end, size_t length) {
+        while (length >= 255) {
+            if (out >= end) return false;
+            *out++ = 255;
+            length -= 255;
+        }
+        if (out >= end) return false;
+        *out++ = static_cast<uint8_t>(length);
+        return true;
+    }
+
+    inline bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+        uint8_t b;
+        do {
+            if (in >= end) return false;
+            b = *in++;
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+
+    bool EmitSequence(uint8_t*& out, const uint8_t* outEnd, const uint8_t* literals, size_t literalCount,
+                      size_t offset, size_t matchLength) {
+        if (out >= outEnd) return false;
+        uint8_t* token = out++;
+        size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+        *token = static_cast<uint8_t>(((literalCount < 15 ? literalCount : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+        if (literalCount >= 15 && !WriteLength(out, outEnd, literalCount - 15)) return false;
+        if (static_cast<size_t>(outEnd - out) < literalCount) return false;
+        if (literalCount) std::memcpy(out, literals, literalCount);
+        out += literalCount;
+
+        if (matchLength == 0) return true; // последняя последовательность - только литералы
+        if (outEnd - out < 2) return false;
+        *out++ = static_cast<uint8_t>(offset & 0xFF);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+        if (matchCode >= 15 && !WriteLength(out, outEnd, matchCode - 15)) return false;
+        return true;
+    }
+}
+
+size_t BlockCompressor::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t capacity) {
+    uint8_t* out = dst;
+    const uint8_t* outEnd = dst + capacity;
+    size_t anchor = 0;
+
+    if (srcSize > MATCH_LIMIT) {
+        std::vector<int32_t> table(size_t(1) << HASH_BITS, -1);
+        size_t limit = srcSize - MATCH_LIMIT;
+        size_t i = 0;
+        while (i < limit) {
+            uint32_t sequence = Read32(src + i);
+            uint32_t h = Hash(sequence);
+            int32_t candidate = table[h];
+            table[h] = static_cast<int32_t>(i);
+
+            if (candidate >= 0 && i - candidate <= MAX_OFFSET && Read32(src + candidate) == sequence) {
+                size_t length = MIN_MATCH;
+                size_t maxLength = srcSize - LAST_LITERALS - i;
+                while (length < maxLength && src[candidate + length] == src[i + length]) ++length;
+
+                if (!EmitSequence(out, outEnd, src + anchor, i - anchor, i - candidate, length)) return 0;
+                i += length;
+                anchor = i;
+            } else {
+                // В несжимаемых данных шагаем быстрее
+                i += 1 + ((i - anchor) >> 6);
+            }
+        }
+    }
+
+    if (!EmitSequence(out, outEnd, src + anchor, srcSize - anchor, 0, 0)) return 0;
+    return static_cast<size_t>(out - dst);
+}
+
+bool BlockCompressor::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t rawSize) {
+    const uint8_t* in = src;
+    const uint8_t* inEnd = src + srcSize;
+    uint8_t* out = dst;
+    uint8_t* outEnd = dst + rawSize;
+
+    while (in < inEnd) {
+        uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !ReadLength(in, inEnd, literalCount)) return false;
+        if (static_cast<size_t>(inEnd - in) < literalCount || static_cast<size_t>(outEnd - out) < literalCount) return false;
+        if (literalCount) std::memcpy(out, in, literalCount);
+        in += literalCount;
+        out += literalCount;
+
+        if (in == inEnd) break; // последняя последовательность
+
+        if (inEnd - in < 2) return false;
+        size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !ReadLength(in, inEnd, matchLength)) return false;
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > static_cast<size_t>(out - dst)) return false;
+        if (static_cast<size_t>(outEnd - out) < matchLength) return false;
+        const uint8_t* match = out - offset;
+        if (offset >= matchLength) {
+            std::memcpy(out, match, matchLength);
+            out += matchLength;
+        } else {
+            // Перекрывающееся совпадение (повтор короткого шаблона)
+            for (size_t k = 0; k < matchLength; ++k) *out++ = match[k];
+        }
+    }
+    return out == outEnd;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Быстрое LZ77-сжатие блоков в формате последовательностей LZ4:
+// [токен][длина литералов][литералы][смещение 2 байта][длина совпадения].
+// Рассчитано на скорость сохранения, а не на максимальную степень сжатия.
+class BlockCompressor {
+public:
+    static size_t GetMaxCompressedSize(size_t rawSize) { return rawSize + rawSize / 255 + 16; }
+
+    // Возвращает размер сжатых данных или 0, если не поместилось в capacity
+    static size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t capacity);
+
+    // Ожидает ровно rawSize байт на выходе; false при повреждённых данных
+    static bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t rawSize);
+};
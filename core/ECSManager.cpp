@@ -1,11 +1,11 @@
 #include "ECSManager.hpp"
 
 ECSManager::ECSManager() {
-    LOG(L"ECSManager инициализирован");
+    LOG_INFO(Core, "ECSManager инициализирован");
 }
 
 ECSManager::~ECSManager() {
-    LOG(L"ECSManager уничтожен");
+    LOG_INFO(Core, "ECSManager уничтожен");
 }
 
 void ECSManager::Update(float dt) {
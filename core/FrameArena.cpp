@@ -0,0 +1,31 @@
+#include "FrameArena.hpp"
+#include "Metrics.hpp"
+
+namespace {
+    struct FrameArenaState {
+        ArenaAllocator arena{MemoryTag::Frame, FrameArena::BLOCK_SIZE};
+        ArenaResource resource{arena};
+        MetricGauge& usedBytes = Metrics::GetGauge("rtgc_frame_arena_used_bytes", "Памяти кадра взято за последний кадр, байт");
+        MetricGauge& capacityBytes = Metrics::GetGauge("rtgc_frame_arena_capacity_bytes", "Блоков памяти кадра, байт");
+    };
+
+    FrameArenaState& GetState() {
+        static FrameArenaState state;
+        return state;
+    }
+}
+
+ArenaAllocator& FrameArena::GetAllocator() {
+    return GetState().arena;
+}
+
+std::pmr::memory_resource* FrameArena::GetResource() {
+    return &GetState().resource;
+}
+
+void FrameArena::Reset() {
+    FrameArenaState& s = GetState();
+    s.usedBytes.Set(static_cast<int64_t>(s.arena.GetUsedBytes()));
+    s.capacityBytes.Set(static_cast<int64_t>(s.arena.GetCapacity()));
+    s.arena.Reset();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "Allocators.hpp"
+#include <memory_resource>
+
+// std::pmr поверх ArenaAllocator: контейнер с этим ресурсом берёт память из арены,
+// освобождение - пустая операция, всё уходит разом при Reset арены.
+class ArenaResource : public std::pmr::memory_resource {
+    ArenaAllocator& arena;
+
+public:
+    explicit ArenaResource(ArenaAllocator& target) : arena(target) {}
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override { return arena.Allocate(bytes, alignment); }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Временная память кадра главного потока:
+//     std::pmr::vector<float> vertices(FrameArena::GetResource());
+// Всё взятое отсюда действительно до FrameArena::Reset в конце кадра (Engine::Run).
+// Только для потока кадра; рабочим потокам - своя ArenaAllocator.
+// Рост вектора оставляет старый буфер в арене до конца кадра, поэтому размер лучше резервировать заранее.
+class FrameArena {
+public:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    static ArenaAllocator& GetAllocator();
+    static std::pmr::memory_resource* GetResource();
+    static void Reset();
+};
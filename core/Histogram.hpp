@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Интервалы гистограмм в духе HDR Histogram: значения до 16 - точно, дальше
+// 8 под-интервалов на каждую степень двойки (ошибка до 12.5%) на весь диапазон uint64.
+// Общие для профайлера (длительности зон) и метрик.
+namespace HistogramBuckets {
+    constexpr int LINEAR = 16;
+    constexpr int COUNT = LINEAR + (64 - 4) * 8;
+
+    inline int HighestBit(uint64_t v) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, v);
+        return static_cast<int>(index);
+#elif defined(__GNUC__)
+        return 63 - __builtin_clzll(v);
+#else
+        int bit = 0;
+        while (v >>= 1) ++bit;
+        return bit;
+#endif
+    }
+
+    inline int Index(uint64_t value) {
+        if (value < LINEAR) return static_cast<int>(value);
+        int e = HighestBit(value);
+        int sub = static_cast<int>((value >> (e - 3)) & 7);
+        return LINEAR + (e - 4) * 8 + sub;
+    }
+
+    // Наибольшее значение, попадающее в интервал
+    inline uint64_t UpperBound(int bucket) {
+        if (bucket < LINEAR) return static_cast<uint64_t>(bucket);
+        int e = (bucket - LINEAR) / 8 + 4;
+        uint64_t sub = static_cast<uint64_t>((bucket - LINEAR) % 8);
+        uint64_t lower = (8 + sub) << (e - 3);
+        return lower + (uint64_t(1) << (e - 3)) - 1;
+    }
+
+    // Значение квантиля q по массиву счётчиков интервалов (верхняя граница интервала)
+    template<typename CountAt>
+    uint64_t Percentile(double q, uint64_t total, CountAt countAt) {
+        if (total == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(q * static_cast<double>(total));
+        if (target >= total) target = total - 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < COUNT; ++b) {
+            seen += countAt(b);
+            if (seen > target) return UpperBound(b);
+        }
+        return UpperBound(COUNT - 1);
+    }
+}
@@ -0,0 +1,369 @@
+#include "LogFormat.hpp"
+#include <cstring>
+#include <ctime>
+
+namespace {
+    std::tm LocalTime(std::time_t time) {
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
+    }
+
+    void WriteVarint(std::string& out, uint64_t v) {
+        while (v >= 0x80) {
+            out += static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        out += static_cast<char>(v);
+    }
+
+    uint64_t ZigZag(int64_t v) {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    int64_t UnZigZag(uint64_t v) {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    template<typename T>
+    void WriteRaw(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    T ReadRawAt(const uint8_t* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    // Размер значения аргумента в упакованных LogArgs (после тега); для строк - без длины
+    size_t PackedValueSize(uint8_t tag) {
+        switch (tag) {
+            case LogArgs::TAG_BOOL:
+            case LogArgs::TAG_CHAR: return 1;
+            case LogArgs::TAG_INT:
+            case LogArgs::TAG_UINT:
+            case LogArgs::TAG_DOUBLE: return 8;
+            case LogArgs::TAG_FLOAT: return 4;
+            case LogArgs::TAG_STRING:
+            case LogArgs::TAG_LITERAL: return 4;
+            default: return 0;
+        }
+    }
+
+    // Последовательное чтение с проверкой границ; после ошибки все чтения возвращают 0
+    class Cursor {
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+        bool failed = false;
+
+    public:
+        Cursor(const uint8_t* d, size_t s) : data(d), size(s) {}
+
+        bool IsOk() const { return !failed; }
+        bool AtEnd() const { return pos >= size; }
+        size_t GetPos() const { return pos; }
+
+        const uint8_t* Take(size_t n) {
+            if (failed || n > size - pos) {
+                failed = true;
+                return nullptr;
+            }
+            const uint8_t* p = data + pos;
+            pos += n;
+            return p;
+        }
+
+        uint8_t ReadByte() {
+            const uint8_t* p = Take(1);
+            return p ? *p : 0;
+        }
+
+        uint64_t ReadVarint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t b = ReadByte();
+                if (failed) return 0;
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if ((b & 0x80) == 0) return v;
+            }
+            failed = true;
+            return 0;
+        }
+    };
+}
+
+void LogTextFormatter::AppendLine(std::string& out, int64_t timeUs, uint32_t threadId, Logger::Level level,
+                                  Logger::Category category, const uint8_t* args, size_t size) {
+    // Метка времени форматируется заново только при смене секунды
+    int64_t second = timeUs / 1000000;
+    if (second != cachedSecond) {
+        cachedSecond = second;
+        std::tm tm = LocalTime(static_cast<std::time_t>(second));
+        std::strftime(cachedTime, sizeof(cachedTime), "%H:%M:%S", &tm);
+    }
+    out += '[';
+    out += cachedTime;
+    out += "] [";
+    out += std::to_string(threadId);
+    out += "] [";
+    out += Logger::GetLevelName(level);
+    out += "] ";
+    if (category != Logger::Category::General) {
+        out += '[';
+        out += Logger::GetCategoryName(category);
+        out += "] ";
+    }
+    LogArgs::Format(out, args, size);
+    out += '\n';
+}
+
+void BinaryLogEncoder::WriteHeader(std::string& out, int64_t startTimeUs) {
+    WriteRaw<uint32_t>(out, LogBinary::MAGIC);
+    WriteRaw<uint16_t>(out, LogBinary::VERSION);
+    WriteRaw<uint16_t>(out, 0);
+    WriteRaw<int64_t>(out, startTimeUs);
+    lastTimeUs = startTimeUs;
+}
+
+void BinaryLogEncoder::Reset() {
+    formatIds.clear();
+    lastTimeUs = 0;
+}
+
+void BinaryLogEncoder::Encode(std::string& out, int64_t timeUs, uint32_t threadId, Logger::Level level,
+                              Logger::Category category, const uint8_t* args, size_t size) {
+    // Ключ формы: уровень, категория, литералы целиком и теги аргументов
+    keyScratch.clear();
+    keyScratch += static_cast<char>(level);
+    keyScratch += static_cast<char>(category);
+    size_t argCount = 0;
+    for (size_t pos = 0; pos < size;) {
+        uint8_t tag = args[pos++];
+        size_t valueSize = PackedValueSize(tag);
+        if (valueSize == 0 || valueSize > size - pos) return; // повреждённая запись
+        if (tag == LogArgs::TAG_STRING || tag == LogArgs::TAG_LITERAL) {
+            uint32_t length = ReadRawAt<uint32_t>(args + pos);
+            pos += 4;
+            if (length > size - pos) return;
+            if (tag == LogArgs::TAG_LITERAL) {
+                keyScratch += static_cast<char>(LogBinary::ITEM_LITERAL);
+                WriteVarint(keyScratch, length);
+                keyScratch.append(reinterpret_cast<const char*>(args + pos), length);
+            } else {
+                keyScratch += static_cast<char>(LogBinary::ITEM_ARG);
+                keyScratch += static_cast<char>(tag);
+                ++argCount;
+            }
+            pos += length;
+        } else {
+            keyScratch += static_cast<char>(LogBinary::ITEM_ARG);
+            keyScratch += static_cast<char>(tag);
+            ++argCount;
+            pos += valueSize;
+        }
+    }
+
+    int64_t delta = timeUs - lastTimeUs;
+    lastTimeUs = timeUs;
+
+    auto it = formatIds.find(keyScratch);
+    if (it == formatIds.end()) {
+        if (formatIds.size() >= MAX_FORMATS) {
+            // Словарь полон (скорее всего, много разных локальных буферов) - пишем текст
+            std::string text;
+            LogArgs::Format(text, args, size);
+            out += static_cast<char>(LogBinary::RECORD_TEXT);
+            WriteVarint(out, threadId);
+            WriteVarint(out, ZigZag(delta));
+            out += static_cast<char>(level);
+            out += static_cast<char>(category);
+            WriteVarint(out, text.size());
+            out += text;
+            return;
+        }
+        uint32_t id = static_cast<uint32_t>(formatIds.size());
+        it = formatIds.emplace(keyScratch, id).first;
+
+        // Определение формы: ключ уже содержит всё нужное, кроме числа элементов
+        out += static_cast<char>(LogBinary::RECORD_FORMAT);
+        WriteVarint(out, id);
+        out += keyScratch;
+        out += static_cast<char>(0xFF); // конец элементов
+    }
+
+    out += static_cast<char>(LogBinary::RECORD_MESSAGE);
+    WriteVarint(out, it->second);
+    WriteVarint(out, threadId);
+    WriteVarint(out, ZigZag(delta));
+    if (argCount == 0) return;
+
+    for (size_t pos = 0; pos < size;) {
+        uint8_t tag = args[pos++];
+        switch (tag) {
+            case LogArgs::TAG_BOOL:
+            case LogArgs::TAG_CHAR:
+                out += static_cast<char>(args[pos]);
+                pos += 1;
+                break;
+            case LogArgs::TAG_INT:
+                WriteVarint(out, ZigZag(ReadRawAt<int64_t>(args + pos)));
+                pos += 8;
+                break;
+            case LogArgs::TAG_UINT:
+                WriteVarint(out, ReadRawAt<uint64_t>(args + pos));
+                pos += 8;
+                break;
+            case LogArgs::TAG_FLOAT:
+                out.append(reinterpret_cast<const char*>(args + pos), 4);
+                pos += 4;
+                break;
+            case LogArgs::TAG_DOUBLE:
+                out.append(reinterpret_cast<const char*>(args + pos), 8);
+                pos += 8;
+                break;
+            case LogArgs::TAG_STRING: {
+                uint32_t length = ReadRawAt<uint32_t>(args + pos);
+                pos += 4;
+                WriteVarint(out, length);
+                out.append(reinterpret_cast<const char*>(args + pos), length);
+                pos += length;
+                break;
+            }
+            case LogArgs::TAG_LITERAL:
+                pos += 4 + ReadRawAt<uint32_t>(args + pos);
+                break;
+        }
+    }
+}
+
+bool BinaryLogDecoder::Decode(const uint8_t* data, size_t size, const std::function<void(const Message&)>& onMessage) {
+    formats.clear();
+    decodedCount = 0;
+
+    Cursor in(data, size);
+    const uint8_t* header = in.Take(LogBinary::HEADER_SIZE);
+    if (!header || ReadRawAt<uint32_t>(header) != LogBinary::MAGIC ||
+        ReadRawAt<uint16_t>(header + 4) != LogBinary::VERSION) {
+        return false;
+    }
+    startTimeUs = ReadRawAt<int64_t>(header + 8);
+    int64_t timeUs = startTimeUs;
+
+    auto appendPacked = [this](uint8_t tag, const void* value, size_t n) {
+        packed.push_back(tag);
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        packed.insert(packed.end(), bytes, bytes + n);
+    };
+    auto appendPackedString = [this](uint8_t tag, const uint8_t* text, uint32_t length) {
+        packed.push_back(tag);
+        const uint8_t* len = reinterpret_cast<const uint8_t*>(&length);
+        packed.insert(packed.end(), len, len + 4);
+        packed.insert(packed.end(), text, text + length);
+    };
+
+    while (!in.AtEnd()) {
+        uint8_t type = in.ReadByte();
+        if (type == LogBinary::RECORD_FORMAT) {
+            uint64_t id = in.ReadVarint();
+            Format format;
+            format.level = static_cast<Logger::Level>(in.ReadByte());
+            format.category = static_cast<Logger::Category>(in.ReadByte());
+            for (;;) {
+                uint8_t item = in.ReadByte();
+                if (!in.IsOk() || item == 0xFF) break;
+                if (item == LogBinary::ITEM_LITERAL) {
+                    uint64_t length = in.ReadVarint();
+                    const uint8_t* text = in.Take(static_cast<size_t>(length));
+                    if (!text) break;
+                    format.items.push_back(LogArgs::TAG_LITERAL);
+                    format.literals.emplace_back(reinterpret_cast<const char*>(text), static_cast<size_t>(length));
+                } else {
+                    uint8_t tag = in.ReadByte();
+                    if (PackedValueSize(tag) == 0 || tag == LogArgs::TAG_LITERAL) return false;
+                    format.items.push_back(tag);
+                }
+            }
+            if (!in.IsOk() || id != formats.size()) return false;
+            formats.push_back(std::move(format));
+        } else if (type == LogBinary::RECORD_MESSAGE) {
+            uint64_t id = in.ReadVarint();
+            uint32_t threadId = static_cast<uint32_t>(in.ReadVarint());
+            timeUs += UnZigZag(in.ReadVarint());
+            if (!in.IsOk() || id >= formats.size()) return false;
+
+            const Format& format = formats[static_cast<size_t>(id)];
+            packed.clear();
+            size_t literal = 0;
+            for (uint8_t item : format.items) {
+                if (item == LogArgs::TAG_LITERAL) {
+                    const std::string& text = format.literals[literal++];
+                    appendPackedString(LogArgs::TAG_LITERAL, reinterpret_cast<const uint8_t*>(text.data()),
+                                       static_cast<uint32_t>(text.size()));
+                    continue;
+                }
+                switch (item) {
+                    case LogArgs::TAG_BOOL:
+                    case LogArgs::TAG_CHAR: {
+                        uint8_t v = in.ReadByte();
+                        appendPacked(item, &v, 1);
+                        break;
+                    }
+                    case LogArgs::TAG_INT: {
+                        int64_t v = UnZigZag(in.ReadVarint());
+                        appendPacked(item, &v, 8);
+                        break;
+                    }
+                    case LogArgs::TAG_UINT: {
+                        uint64_t v = in.ReadVarint();
+                        appendPacked(item, &v, 8);
+                        break;
+                    }
+                    case LogArgs::TAG_FLOAT:
+                    case LogArgs::TAG_DOUBLE: {
+                        size_t n = item == LogArgs::TAG_FLOAT ? 4 : 8;
+                        const uint8_t* v = in.Take(n);
+                        if (!v) return false;
+                        appendPacked(item, v, n);
+                        break;
+                    }
+                    case LogArgs::TAG_STRING: {
+                        uint64_t length = in.ReadVarint();
+                        const uint8_t* text = in.Take(static_cast<size_t>(length));
+                        if (!text) return false;
+                        appendPackedString(item, text, static_cast<uint32_t>(length));
+                        break;
+                    }
+                }
+            }
+            if (!in.IsOk()) return false;
+
+            Message message{timeUs, threadId, format.level, format.category, packed.data(), packed.size()};
+            onMessage(message);
+            ++decodedCount;
+        } else if (type == LogBinary::RECORD_TEXT) {
+            uint32_t threadId = static_cast<uint32_t>(in.ReadVarint());
+            timeUs += UnZigZag(in.ReadVarint());
+            Logger::Level level = static_cast<Logger::Level>(in.ReadByte());
+            Logger::Category category = static_cast<Logger::Category>(in.ReadByte());
+            uint64_t length = in.ReadVarint();
+            const uint8_t* text = in.Take(static_cast<size_t>(length));
+            if (!text) return false;
+
+            packed.clear();
+            appendPackedString(LogArgs::TAG_STRING, text, static_cast<uint32_t>(length));
+            Message message{timeUs, threadId, level, category, packed.data(), packed.size()};
+            onMessage(message);
+            ++decodedCount;
+        } else {
+            return false;
+        }
+    }
+    return in.IsOk();
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Logger.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+// Текстовая строка лога: "[ЧЧ:ММ:СС] [поток] [УРОВЕНЬ] [категория] текст\n".
+// Общая для фонового писателя и декодера бинарных логов, чтобы вывод совпадал байт в байт.
+class LogTextFormatter {
+    int64_t cachedSecond = -1;
+    char cachedTime[16] = {};
+
+public:
+    void AppendLine(std::string& out, int64_t timeUs, uint32_t threadId, Logger::Level level,
+                    Logger::Category category, const uint8_t* args, size_t size);
+};
+
+// Бинарный лог (.rtlog). Заголовок: "RTGL", версия, время начала.
+// Дальше записи, первая байта - тип:
+//   FORMAT  - id, уровень, категория, элементы (литерал с текстом или тег аргумента);
+//             пишется один раз при первой встрече формы сообщения
+//   MESSAGE - id формата, поток, дельта времени (zigzag varint), затем только значения аргументов
+//   TEXT    - готовый текст, если словарь форм переполнен
+// Литералы (строковые массивы у вызова) уходят в формат, числа - в varint, поэтому
+// типичная запись занимает 5-15 байт вместо 60-120 байт кириллического текста.
+namespace LogBinary {
+    constexpr uint32_t MAGIC = 0x4C475452; // "RTGL"
+    constexpr uint16_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = 16;
+
+    enum RecordType : uint8_t {
+        RECORD_FORMAT = 1,
+        RECORD_MESSAGE = 2,
+        RECORD_TEXT = 3
+    };
+
+    enum FormatItem : uint8_t {
+        ITEM_LITERAL = 0,
+        ITEM_ARG = 1
+    };
+}
+
+class BinaryLogEncoder {
+    std::unordered_map<std::string, uint32_t> formatIds;
+    std::string keyScratch;
+    int64_t lastTimeUs = 0;
+
+    static constexpr size_t MAX_FORMATS = 65536;
+
+public:
+    void WriteHeader(std::string& out, int64_t startTimeUs);
+    void Encode(std::string& out, int64_t timeUs, uint32_t threadId, Logger::Level level,
+                Logger::Category category, const uint8_t* args, size_t size);
+    // Новый файл: словарь форм начинается заново
+    void Reset();
+
+    size_t GetFormatCount() const { return formatIds.size(); }
+};
+
+class BinaryLogDecoder {
+public:
+    struct Message {
+        int64_t timeUs;
+        uint32_t threadId;
+        Logger::Level level;
+        Logger::Category category;
+        const uint8_t* args; // упакованные LogArgs, годятся для LogArgs::Format
+        size_t argsSize;
+    };
+
+    // Разбирает весь файл; false - повреждённый заголовок или обрыв записи
+    // (сообщения до места обрыва к этому моменту уже переданы в onMessage).
+    bool Decode(const uint8_t* data, size_t size, const std::function<void(const Message&)>& onMessage);
+
+    int64_t GetStartTimeUs() const { return startTimeUs; }
+    size_t GetDecodedCount() const { return decodedCount; }
+
+private:
+    struct Format {
+        Logger::Level level;
+        Logger::Category category;
+        std::vector<std::string> literals;
+        std::vector<uint8_t> items; // теги LogArgs; TAG_LITERAL берёт следующий из literals
+    };
+
+    std::vector<Format> formats;
+    std::vector<uint8_t> packed;
+    int64_t startTimeUs = 0;
+    size_t decodedCount = 0;
+};
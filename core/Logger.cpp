@@ -1,7 +1,549 @@
 #include "Logger.hpp"
+#include "LogFormat.hpp"
+#include "MemoryTracker.hpp"
+#include <condition_variable>
+#include <memory>
+#include <cstddef>
+#include <cstdio>
+#include <charconv>
 
-// Инициализация статических переменных
-std::mutex Logger::logMutex;
-std::ofstream Logger::logFile;
-bool Logger::fileOpened = false;
-bool Logger::consoleEnabled = true;
+// Инициализация статических переменных: по умолчанию включено всё, что скомпилировано
+std::atomic<uint32_t> Logger::enabledMasks[static_cast<size_t>(Logger::Level::Count)] = {
+    {~0u}, {~0u}, {~0u}, {~0u}
+};
+
+namespace {
+    constexpr size_t RING_CAPACITY = 8192; // степень двойки
+    constexpr size_t RING_MASK = RING_CAPACITY - 1;
+    constexpr size_t BATCH_BYTES = 64 * 1024;
+
+    // 256 байт на ячейку вместе с номером последовательности
+    struct LogRecord {
+        int64_t timeUs = 0; // system_clock
+        uint32_t threadId = 0;
+        Logger::Level level = Logger::Level::Info;
+        Logger::Category category = Logger::Category::General;
+        uint16_t argsSize = 0; // байт в args; 0 и непустой overflow - аргументы в overflow
+        uint8_t args[LogArgs::INLINE_BYTES];
+        std::string overflow;
+    };
+
+    // Ограниченная очередь Вьюкова: у каждой ячейки свой номер последовательности,
+    // писатели резервируют ячейку одним CAS, читатель один и работает без CAS.
+    class LogRing {
+        struct alignas(64) Cell {
+            std::atomic<size_t> sequence{0};
+            LogRecord record;
+        };
+
+        // ~2 МБ ячеек учитываются под тегом Logs (rtgc_memory_logs_*)
+        Cell* cells;
+        alignas(64) std::atomic<size_t> enqueuePos{0};
+        alignas(64) size_t dequeuePos = 0;
+
+    public:
+        LogRing() {
+            cells = static_cast<Cell*>(MemoryTracker::Allocate(sizeof(Cell) * RING_CAPACITY, MemoryTag::Logs, alignof(Cell), "LogRing"));
+            for (size_t i = 0; i < RING_CAPACITY; ++i) {
+                new (&cells[i]) Cell();
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~LogRing() {
+            for (size_t i = 0; i < RING_CAPACITY; ++i) cells[i].~Cell();
+            MemoryTracker::Free(cells, sizeof(Cell) * RING_CAPACITY, MemoryTag::Logs, alignof(Cell));
+        }
+
+        LogRing(const LogRing&) = delete;
+        LogRing& operator=(const LogRing&) = delete;
+
+        // fill заполняет запись прямо в зарезервированной ячейке
+        template<typename Fill>
+        bool TryPush(Fill&& fill) {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells[pos & RING_MASK];
+                size_t seq = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        fill(cell.record);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // кольцо заполнено
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Только фоновый поток
+        bool TryPop(LogRecord& out) {
+            Cell& cell = cells[dequeuePos & RING_MASK];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            if (seq != dequeuePos + 1) return false;
+            const LogRecord& in = cell.record;
+            out.timeUs = in.timeUs;
+            out.threadId = in.threadId;
+            out.level = in.level;
+            out.category = in.category;
+            out.argsSize = in.argsSize;
+            std::memcpy(out.args, in.args, in.argsSize);
+            // swap: обе строки сохраняют буферы и переиспользуются
+            std::swap(out.overflow, cell.record.overflow);
+            cell.sequence.store(dequeuePos + RING_CAPACITY, std::memory_order_release);
+            ++dequeuePos;
+            return true;
+        }
+
+        size_t GetEnqueuePos() const { return enqueuePos.load(std::memory_order_acquire); }
+        size_t GetDequeuePos() const { return dequeuePos; }
+    };
+
+    std::mutex settingsMutex;
+    Logger::Level runtimeLevel = Logger::Level::Debug;
+    uint32_t categoryMask = ~0u;
+
+    std::tm LocalTime(std::time_t time) {
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
+    }
+
+    uint32_t CurrentThreadId() {
+        // Короткий номер потока вместо std::thread::id: не нужен ostringstream на каждый вызов
+        static std::atomic<uint32_t> nextId{1};
+        thread_local uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    class LogWriter {
+        LogRing ring;
+
+        std::mutex wakeMutex;
+        std::condition_variable wakeCv;
+        std::condition_variable flushedCv;
+        std::atomic<bool> writerSleeping{false};
+        std::atomic<size_t> writtenPos{0};
+        std::atomic<uint64_t> blocked{0};
+        std::atomic<uint64_t> written{0};
+
+        std::mutex controlMutex;
+        std::thread thread;
+        std::atomic<bool> running{false};
+        bool stopRequested = false;
+
+        std::ofstream logFile;
+        bool fileOpened = false;
+        bool fileBinary = false;
+        LogTextFormatter textFormatter;
+        LogTextFormatter consoleFormatter;
+        BinaryLogEncoder encoder;
+
+        struct ConsoleBatch {
+            std::string text;
+            std::string errors;
+        };
+
+        void EnsureLogFile(bool binary) {
+            if (fileOpened && fileBinary == binary) return;
+            if (fileOpened) CloseLogFile();
+
+            try {
+                auto now = std::chrono::system_clock::now();
+                std::tm tm = LocalTime(std::chrono::system_clock::to_time_t(now));
+
+                std::ostringstream filename;
+                filename << "logs/log_"
+                        << std::put_time(&tm, "%Y%m%d_%H%M%S")
+                        << (binary ? ".rtlog" : ".txt");
+
+                if (binary) {
+                    logFile.open(filename.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                } else {
+                    logFile.open(filename.str(), std::ios::out | std::ios::app);
+                }
+                if (logFile.is_open()) {
+                    fileOpened = true;
+                    fileBinary = binary;
+                    if (binary) {
+                        std::string header;
+                        encoder.Reset();
+                        encoder.WriteHeader(header, std::chrono::duration_cast<std::chrono::microseconds>(
+                            now.time_since_epoch()).count());
+                        logFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+                    } else {
+                        logFile << "===== Лог начат " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " =====" << std::endl;
+                    }
+                } else {
+                    std::cerr << "Не удалось открыть файл лога: " << filename.str() << std::endl;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Ошибка при создании лог-файла: " << e.what() << std::endl;
+            }
+        }
+
+        void CloseLogFile() {
+            if (!fileOpened) return;
+            if (!fileBinary) {
+                std::tm tm = LocalTime(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+                logFile << "===== Лог завершен " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " =====" << std::endl;
+            }
+            logFile.close();
+            fileOpened = false;
+        }
+
+        void Process(const LogRecord& record, std::string& batch, ConsoleBatch& out, bool console, bool binary) {
+            const uint8_t* args = record.args;
+            size_t size = record.argsSize;
+            if (size == 0) {
+                args = reinterpret_cast<const uint8_t*>(record.overflow.data());
+                size = record.overflow.size();
+            }
+
+            if (binary) {
+                encoder.Encode(batch, record.timeUs, record.threadId, record.level, record.category, args, size);
+            } else {
+                textFormatter.AppendLine(batch, record.timeUs, record.threadId, record.level, record.category, args, size);
+            }
+            if (console) {
+                // Ошибки - в stderr, остальное - в stdout, как раньше
+                std::string& target = record.level == Logger::Level::Error ? out.errors : out.text;
+                consoleFormatter.AppendLine(target, record.timeUs, record.threadId, record.level, record.category, args, size);
+            }
+        }
+
+        // Забирает всё, что есть в кольце, и пишет одной пачкой. Возвращает false, если было пусто.
+        bool Drain(bool console) {
+            bool binary = binaryFile.load(std::memory_order_relaxed);
+            // Файл открывается до кодирования: бинарный словарь привязан к файлу
+            EnsureLogFile(binary);
+
+            std::string batch;
+            ConsoleBatch out;
+            LogRecord record;
+            bool any = false;
+            uint64_t count = 0;
+
+            while (ring.TryPop(record)) {
+                any = true;
+                ++count;
+                Process(record, batch, out, console, binary);
+                if (batch.size() >= BATCH_BYTES) {
+                    WriteBatch(batch, out);
+                    // Ячейки уже освобождены: ждущие места вызывающие продолжают, не дожидаясь конца пачки
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                    flushedCv.notify_all();
+                }
+            }
+            if (count > 0) written.fetch_add(count, std::memory_order_relaxed);
+
+            if (!batch.empty()) WriteBatch(batch, out);
+
+            writtenPos.store(ring.GetDequeuePos(), std::memory_order_release);
+            if (any) {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                flushedCv.notify_all();
+            }
+            return any;
+        }
+
+        void WriteBatch(std::string& batch, ConsoleBatch& out) {
+            if (!out.text.empty()) {
+                std::cout.write(out.text.data(), static_cast<std::streamsize>(out.text.size()));
+                std::cout.flush();
+            }
+            if (!out.errors.empty()) {
+                std::cerr.write(out.errors.data(), static_cast<std::streamsize>(out.errors.size()));
+            }
+
+            if (fileOpened) {
+                logFile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                logFile.flush();
+            }
+            batch.clear();
+            out.text.clear();
+            out.errors.clear();
+        }
+
+        void WriterLoop() {
+            for (;;) {
+                bool console = consoleEnabled.load(std::memory_order_relaxed);
+                if (Drain(console)) continue;
+
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                writerSleeping.store(true, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                bool pending = ring.GetEnqueuePos() != ring.GetDequeuePos();
+                if (!pending && !stopRequested) {
+                    wakeCv.wait_for(lock, std::chrono::milliseconds(100));
+                }
+                writerSleeping.store(false, std::memory_order_relaxed);
+                if (stopRequested && ring.GetEnqueuePos() == ring.GetDequeuePos()) break;
+            }
+        }
+
+        void Wake() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (writerSleeping.load(std::memory_order_seq_cst)) {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                wakeCv.notify_one();
+            }
+        }
+
+        void Start() {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            if (running.load(std::memory_order_relaxed)) return;
+            {
+                std::lock_guard<std::mutex> wakeLock(wakeMutex);
+                stopRequested = false;
+            }
+            thread = std::thread([this]() { WriterLoop(); });
+            running.store(true, std::memory_order_release);
+        }
+
+    public:
+        std::atomic<bool> consoleEnabled{true};
+        std::atomic<bool> binaryFile{false};
+
+        ~LogWriter() {
+            Close();
+        }
+
+        void Push(Logger::Level level, Logger::Category category, LogArgs& args) {
+            if (!running.load(std::memory_order_acquire)) Start();
+
+            int64_t timeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            uint32_t threadId = CurrentThreadId();
+            auto fill = [&](LogRecord& record) {
+                record.timeUs = timeUs;
+                record.threadId = threadId;
+                record.level = level;
+                record.category = category;
+                if (args.IsInline()) {
+                    record.argsSize = static_cast<uint16_t>(args.GetSize());
+                    std::memcpy(record.args, args.GetData(), args.GetSize());
+                    record.overflow.clear();
+                } else {
+                    record.argsSize = 0;
+                    record.overflow.swap(args.GetOverflow());
+                }
+            };
+
+            if (ring.TryPush(fill)) {
+                Wake();
+                return;
+            }
+
+            // Кольцо заполнено: вызывающий ждёт места (обратное давление), сообщения не теряются.
+            // Сначала несколько уступок процессора, потом сон до освобождения ячеек писателем.
+            blocked.fetch_add(1, std::memory_order_relaxed);
+            for (int attempt = 0; !ring.TryPush(fill); ++attempt) {
+                Wake();
+                if (attempt < 64) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                flushedCv.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            Wake();
+        }
+
+        void Flush() {
+            if (!running.load(std::memory_order_acquire)) return;
+            size_t target = ring.GetEnqueuePos();
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                wakeCv.notify_one();
+            }
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            while (writtenPos.load(std::memory_order_acquire) < target) {
+                flushedCv.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+
+        void Close() {
+            std::lock_guard<std::mutex> lock(controlMutex);
+            if (running.load(std::memory_order_acquire)) {
+                {
+                    std::lock_guard<std::mutex> wakeLock(wakeMutex);
+                    stopRequested = true;
+                    wakeCv.notify_one();
+                }
+                thread.join();
+                running.store(false, std::memory_order_release);
+            }
+
+            CloseLogFile();
+        }
+
+        uint64_t GetBlocked() const { return blocked.load(std::memory_order_relaxed); }
+        uint64_t GetWritten() const { return written.load(std::memory_order_relaxed); }
+    };
+
+    // Создаётся при первом обращении, поэтому логировать можно и из статических конструкторов;
+    // деструктор дописывает очередь при выходе из программы.
+    LogWriter& GetWriter() {
+        static LogWriter writer;
+        return writer;
+    }
+}
+
+void Logger::Push(Level level, Category category, LogArgs& args) {
+    GetWriter().Push(level, category, args);
+}
+
+// Вызывается под settingsMutex
+void Logger::RebuildMasks() {
+    for (size_t level = 0; level < static_cast<size_t>(Level::Count); ++level) {
+        bool levelOn = level >= static_cast<size_t>(runtimeLevel);
+        enabledMasks[level].store(levelOn ? categoryMask : 0u, std::memory_order_relaxed);
+    }
+}
+
+void Logger::SetLevel(Level minLevel) {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    runtimeLevel = minLevel;
+    RebuildMasks();
+}
+
+Logger::Level Logger::GetLevel() {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    return runtimeLevel;
+}
+
+void Logger::SetCategoryEnabled(Category category, bool enabled) {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    uint32_t bit = 1u << static_cast<unsigned>(category);
+    categoryMask = enabled ? (categoryMask | bit) : (categoryMask & ~bit);
+    RebuildMasks();
+}
+
+bool Logger::IsCategoryEnabled(Category category) {
+    std::lock_guard<std::mutex> lock(settingsMutex);
+    return (categoryMask >> static_cast<unsigned>(category)) & 1u;
+}
+
+void Logger::SetBinaryFile(bool enable) {
+    GetWriter().binaryFile.store(enable, std::memory_order_relaxed);
+}
+
+bool Logger::IsBinaryFile() {
+    return GetWriter().binaryFile.load(std::memory_order_relaxed);
+}
+
+const char* Logger::GetLevelName(Level level) {
+    switch (level) {
+        case Level::Debug: return "ОТЛАДКА";
+        case Level::Info: return "ИНФО";
+        case Level::Warning: return "ПРЕДУПРЕЖДЕНИЕ";
+        case Level::Error: return "ОШИБКА";
+        default: return "ИНФО";
+    }
+}
+
+const char* Logger::GetCategoryName(Category category) {
+    switch (category) {
+        case Category::General: return "Общее";
+        case Category::Core: return "Ядро";
+        case Category::Physics: return "Физика";
+        case Category::World: return "Мир";
+        case Category::Network: return "Сеть";
+        case Category::Game: return "Игра";
+        case Category::Audio: return "Звук";
+        case Category::Graphics: return "Графика";
+        default: return "?";
+    }
+}
+
+void Logger::EnableConsole(bool enable) {
+    GetWriter().consoleEnabled.store(enable, std::memory_order_relaxed);
+}
+
+void Logger::Flush() {
+    GetWriter().Flush();
+}
+
+void Logger::Close() {
+    GetWriter().Close();
+}
+
+uint64_t Logger::GetBlockedCount() {
+    return GetWriter().GetBlocked();
+}
+
+uint64_t Logger::GetWrittenCount() {
+    return GetWriter().GetWritten();
+}
+
+void LogArgs::Format(std::string& out, const uint8_t* data, size_t size) {
+    size_t pos = 0;
+    char buffer[32];
+    while (pos < size) {
+        uint8_t tag = data[pos++];
+        switch (tag) {
+            case TAG_BOOL:
+                out += data[pos] ? '1' : '0'; // как operator<< без boolalpha
+                pos += 1;
+                break;
+            case TAG_CHAR:
+                out += static_cast<char>(data[pos]);
+                pos += 1;
+                break;
+            case TAG_INT: {
+                int64_t v;
+                std::memcpy(&v, data + pos, sizeof(v));
+                pos += sizeof(v);
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+                out.append(buffer, result.ptr);
+                break;
+            }
+            case TAG_UINT: {
+                uint64_t v;
+                std::memcpy(&v, data + pos, sizeof(v));
+                pos += sizeof(v);
+                auto result = std::to_chars(buffer, buffer + sizeof(buffer), v);
+                out.append(buffer, result.ptr);
+                break;
+            }
+            case TAG_FLOAT: {
+                float v;
+                std::memcpy(&v, data + pos, sizeof(v));
+                pos += sizeof(v);
+                int n = std::snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(v));
+                if (n > 0) out.append(buffer, static_cast<size_t>(n) < sizeof(buffer) ? n : sizeof(buffer) - 1);
+                break;
+            }
+            case TAG_DOUBLE: {
+                double v;
+                std::memcpy(&v, data + pos, sizeof(v));
+                pos += sizeof(v);
+                // %g с точностью 6 - то же, что ostringstream по умолчанию
+                int n = std::snprintf(buffer, sizeof(buffer), "%g", v);
+                if (n > 0) out.append(buffer, static_cast<size_t>(n) < sizeof(buffer) ? n : sizeof(buffer) - 1);
+                break;
+            }
+            case TAG_STRING:
+            case TAG_LITERAL: {
+                uint32_t length;
+                std::memcpy(&length, data + pos, sizeof(length));
+                pos += sizeof(length);
+                if (length > size - pos) length = static_cast<uint32_t>(size - pos);
+                out.append(reinterpret_cast<const char*>(data + pos), length);
+                pos += length;
+                break;
+            }
+            default:
+                return; // повреждённая запись
+        }
+    }
+}
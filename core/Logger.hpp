@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <mutex>
 #include <chrono>
@@ -8,140 +9,226 @@
 #include <fstream>
 #include <ctime>
 #include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
-class Logger {
-private:
-    static std::mutex logMutex;
-    static std::ofstream logFile;
-    static bool fileOpened;
-    static bool consoleEnabled;
-    
-    static void EnsureLogFile() {
-        if (fileOpened) return;
-        
-        try {
-            auto now = std::chrono::system_clock::now();
-            auto time = std::chrono::system_clock::to_time_t(now);
-            std::tm tm;
-#ifdef _WIN32
-            localtime_s(&tm, &time);
+// Минимальный уровень, который вообще компилируется: 0 - отладка, 1 - инфо, 2 - предупреждения, 3 - ошибки.
+// В релизе отладочные сообщения вырезаются целиком вместе с вычислением аргументов (через макросы LOG_*).
+#ifndef RTGC_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define RTGC_LOG_MIN_LEVEL 1
 #else
-            localtime_r(&time, &tm);
+#define RTGC_LOG_MIN_LEVEL 0
 #endif
-            
-            std::ostringstream filename;
-            filename << "logs/log_"
-                    << std::put_time(&tm, "%Y%m%d_%H%M%S")
-                    << ".txt";
-            
-            logFile.open(filename.str(), std::ios::out | std::ios::app);
-            if (logFile.is_open()) {
-                fileOpened = true;
-                logFile << "===== Лог начат " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " =====" << std::endl;
-            } else {
-                std::cerr << "Не удалось открыть файл лога: " << filename.str() << std::endl;
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Ошибка при создании лог-файла: " << e.what() << std::endl;
+#endif
+
+// Аргументы сообщения в упакованном виде: [тег][значение]... Текст собирает фоновый поток,
+// вызывающий только копирует значения. Типы без прямой поддержки форматируются через
+// operator<< сразу (и только если сообщение включено).
+class LogArgs {
+public:
+    enum Tag : uint8_t {
+        TAG_BOOL,
+        TAG_CHAR,
+        TAG_INT,
+        TAG_UINT,
+        TAG_DOUBLE,
+        TAG_STRING,
+        TAG_LITERAL, // строковый массив у вызова; бинарный лог относит его к формату сообщения
+        TAG_FLOAT
+    };
+
+    static constexpr size_t INLINE_BYTES = 192;
+
+private:
+    uint8_t inlineData[INLINE_BYTES];
+    std::string overflow; // если аргументы не поместились в inlineData
+    size_t size = 0;
+
+    void Append(const void* data, size_t n) {
+        if (overflow.empty() && size + n <= INLINE_BYTES) {
+            std::memcpy(inlineData + size, data, n);
+        } else {
+            if (overflow.empty()) overflow.assign(reinterpret_cast<const char*>(inlineData), size);
+            overflow.append(static_cast<const char*>(data), n);
         }
+        size += n;
     }
-    
-    static std::string GetTimestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        std::tm tm;
-#ifdef _WIN32
-        localtime_s(&tm, &time);
-#else
-        localtime_r(&time, &tm);
-#endif
-        
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%H:%M:%S");
-        return oss.str();
+
+    template<typename T>
+    void AppendValue(Tag tag, T value) {
+        Append(&tag, 1);
+        Append(&value, sizeof(T));
     }
-    
-    static std::string GetThreadID() {
-        auto id = std::this_thread::get_id();
-        std::ostringstream oss;
-        oss << id;
-        return oss.str();
+
+    void AddString(std::string_view s, Tag tag = TAG_STRING) {
+        uint32_t length = static_cast<uint32_t>(s.size());
+        AppendValue(tag, length);
+        Append(s.data(), s.size());
     }
-    
+
+public:
     template<typename T>
-    static void LogMessage(const std::string& level, const T& message) {
-        std::lock_guard<std::mutex> lock(logMutex);
-        
-        std::ostringstream oss;
-        oss << "[" << GetTimestamp() << "] [" << GetThreadID() << "] [" << level << "] " << message;
-        
-        if (consoleEnabled) {
-            if (level == "ОШИБКА") {
-                std::cerr << oss.str() << std::endl;
-            } else {
-                std::cout << oss.str() << std::endl;
-            }
-        }
-        
-        EnsureLogFile();
-        if (fileOpened) {
-            logFile << oss.str() << std::endl;
-            logFile.flush();
+    void Add(const T& value) {
+        if constexpr (std::is_same<T, bool>::value) {
+            AppendValue<uint8_t>(TAG_BOOL, value ? 1 : 0);
+        } else if constexpr (std::is_same<T, char>::value || std::is_same<T, signed char>::value ||
+                             std::is_same<T, unsigned char>::value) {
+            AppendValue<char>(TAG_CHAR, static_cast<char>(value));
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            AppendValue<int64_t>(TAG_INT, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral<T>::value) {
+            AppendValue<uint64_t>(TAG_UINT, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_same<T, float>::value) {
+            AppendValue<float>(TAG_FLOAT, value);
+        } else if constexpr (std::is_floating_point<T>::value) {
+            AppendValue<double>(TAG_DOUBLE, static_cast<double>(value));
+        } else if constexpr (std::is_array<T>::value && std::is_same<typename std::remove_extent<T>::type, char>::value) {
+            // Литерал; у локального буфера длина - до первого нуля
+            const void* end = std::memchr(value, 0, std::extent<T>::value);
+            size_t length = end ? static_cast<size_t>(static_cast<const char*>(end) - value) : std::extent<T>::value;
+            AddString(std::string_view(value, length), TAG_LITERAL);
+        } else if constexpr (std::is_convertible<const T&, const char*>::value) {
+            const char* s = value;
+            AddString(s ? std::string_view(s) : std::string_view("(null)"));
+        } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+            AddString(std::string_view(value));
+        } else {
+            std::ostringstream oss;
+            oss << value;
+            AddString(oss.str());
         }
     }
-    
+
+    const uint8_t* GetData() const {
+        return overflow.empty() ? inlineData : reinterpret_cast<const uint8_t*>(overflow.data());
+    }
+    size_t GetSize() const { return size; }
+    bool IsInline() const { return overflow.empty(); }
+    std::string& GetOverflow() { return overflow; }
+
+    // Раскодирует упакованные аргументы и дописывает текст в out
+    static void Format(std::string& out, const uint8_t* data, size_t size);
+};
+
+class Logger {
 public:
-    static void EnableConsole(bool enable) { consoleEnabled = enable; }
-    static void Flush() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        if (fileOpened) {
-            logFile.flush();
-        }
+    enum class Level : uint8_t {
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Count
+    };
+
+    enum class Category : uint8_t {
+        General,
+        Core,
+        Physics,
+        World,
+        Network,
+        Game,
+        Audio,
+        Graphics,
+        Count
+    };
+
+private:
+    // Бит категории в маске уровня: включено ли сообщение. Проверка - одна загрузка и один переход.
+    static std::atomic<uint32_t> enabledMasks[static_cast<size_t>(Level::Count)];
+
+    static void Push(Level level, Category category, LogArgs& args);
+    static void RebuildMasks();
+
+public:
+    static constexpr bool IsCompiledIn(Level level) {
+#if RTGC_LOG_MIN_LEVEL <= 0
+        return ((void)level, true);
+#else
+        return static_cast<int>(level) >= RTGC_LOG_MIN_LEVEL;
+#endif
     }
-    
+
+    static bool IsEnabled(Level level, Category category) {
+        return (enabledMasks[static_cast<size_t>(level)].load(std::memory_order_relaxed) >>
+                static_cast<unsigned>(category)) & 1u;
+    }
+
+    // Порог и категории во время работы; уровни ниже RTGC_LOG_MIN_LEVEL не вернуть
+    static void SetLevel(Level minLevel);
+    static Level GetLevel();
+    static void SetCategoryEnabled(Category category, bool enabled);
+    static bool IsCategoryEnabled(Category category);
+
+    // Без проверки уровня: для макросов LOG_*, которые уже проверили IsEnabled
+    template<typename... Args>
+    static void Emit(Level level, Category category, const Args&... args) {
+        LogArgs packed;
+        (packed.Add(args), ...);
+        Push(level, category, packed);
+    }
+
+    static void EnableConsole(bool enable);
+    // Ждёт, пока всё отправленное до вызова не окажется в файле
+    static void Flush();
+
     template<typename... Args>
     static void Log(const Args&... args) {
-        std::ostringstream oss;
-        (oss << ... << args);
-        LogMessage("ИНФО", oss.str());
+        if (IsEnabled(Level::Info, Category::General)) Emit(Level::Info, Category::General, args...);
     }
-    
+
     template<typename... Args>
     static void Warning(const Args&... args) {
-        std::ostringstream oss;
-        (oss << ... << args);
-        LogMessage("ПРЕДУПРЕЖДЕНИЕ", oss.str());
+        if (IsEnabled(Level::Warning, Category::General)) Emit(Level::Warning, Category::General, args...);
     }
-    
+
     template<typename... Args>
     static void Error(const Args&... args) {
-        std::ostringstream oss;
-        (oss << ... << args);
-        LogMessage("ОШИБКА", oss.str());
+        if (IsEnabled(Level::Error, Category::General)) Emit(Level::Error, Category::General, args...);
     }
-    
+
     template<typename... Args>
     static void Debug(const Args&... args) {
-        std::ostringstream oss;
-        (oss << ... << args);
-        LogMessage("ОТЛАДКА", oss.str());
-    }
-    
-    static void Close() {
-        std::lock_guard<std::mutex> lock(logMutex);
-        if (fileOpened) {
-            auto now = std::chrono::system_clock::now();
-            auto time = std::chrono::system_clock::to_time_t(now);
-            std::tm tm;
-#ifdef _WIN32
-            localtime_s(&tm, &time);
+#if RTGC_LOG_MIN_LEVEL <= 0
+        if (IsEnabled(Level::Debug, Category::General)) Emit(Level::Debug, Category::General, args...);
 #else
-            localtime_r(&time, &tm);
+        ((void)args, ...);
 #endif
-            
-            logFile << "===== Лог завершен " << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << " =====" << std::endl;
-            logFile.close();
-            fileOpened = false;
-        }
     }
+
+    // Дописывает очередь, останавливает фоновый поток и закрывает файл.
+    // Следующий вызов Log снова запустит поток и откроет новый файл.
+    static void Close();
+
+    // Вызовы, которые ждали места в заполненной очереди (сообщения при этом не теряются)
+    static uint64_t GetBlockedCount();
+    // Сколько сообщений фоновый писатель уже вывел (для метрик объёма лога)
+    static uint64_t GetWrittenCount();
+
+    // Бинарный файл лога (.rtlog, см. LogFormat.hpp): меньше размер, текст восстанавливает
+    // утилита tools/LogDecoder. Переключение закрывает текущий файл и открывает новый.
+    static void SetBinaryFile(bool enable);
+    static bool IsBinaryFile();
+
+    static const char* GetLevelName(Level level);
+
+    static const char* GetCategoryName(Category category);
 };
+
+// Макросы не вычисляют аргументы, если сообщение выключено, а уровни ниже
+// RTGC_LOG_MIN_LEVEL убираются компилятором полностью.
+#define RTGC_LOG_AT(level, category, ...) \
+    do { \
+        if (Logger::IsCompiledIn(Logger::Level::level) && \
+            Logger::IsEnabled(Logger::Level::level, Logger::Category::category)) { \
+            Logger::Emit(Logger::Level::level, Logger::Category::category, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(category, ...) RTGC_LOG_AT(Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) RTGC_LOG_AT(Info, category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) RTGC_LOG_AT(Warning, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) RTGC_LOG_AT(Error, category, __VA_ARGS__)
+#define LOG(...) RTGC_LOG_AT(Info, General, __VA_ARGS__)
@@ -0,0 +1,200 @@
+#include "MemoryTracker.hpp"
+#include "Logger.hpp"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace {
+    constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+
+    const char* const TAG_NAMES[TAG_COUNT] = {
+        "general",
+        "terrain",
+        "meshes",
+        "ecs",
+        "physics",
+        "network",
+        "audio",
+        "game",
+        "logs",
+        "frame"
+    };
+
+    // Счётчики тега на своей строке кэша: подсистемы из разных потоков не мешают друг другу
+    struct alignas(64) TagCounters {
+        std::atomic<uint64_t> live{0};
+        std::atomic<uint64_t> peak{0};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+    };
+
+    // Без деструкторов: освобождения из статических деструкторов и последняя выгрузка метрик при выходе
+    // работают с этими счётчиками в любом порядке уничтожения
+    TagCounters tagCounters[TAG_COUNT];
+
+    struct LeakRecord {
+        size_t size;
+        MemoryTag tag;
+        const char* typeName;
+    };
+
+    struct LeakState {
+        std::mutex mutex;
+        std::unordered_map<void*, LeakRecord> live;
+    };
+
+    std::atomic<bool> leakTracking{false};
+
+    LeakState& GetLeakState() {
+        // Не уничтожается намеренно: объекты со статическим временем жизни освобождаются после main
+        static LeakState* state = new LeakState();
+        return *state;
+    }
+
+    // typeid().name() у GCC и Clang - искажённое имя
+    std::string ReadableTypeName(const char* name) {
+        if (!name) return "(контейнер)";
+#if defined(__GNUG__)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            std::string result = demangled;
+            std::free(demangled);
+            return result;
+        }
+#endif
+        return name;
+    }
+
+}
+
+// Метрики тегов регистрирует сам реестр метрик (MetricsState): Allocate вызывается и из
+// конструктора писателя лога, регистрация отсюда зациклила бы инициализацию Logger и Metrics
+void* MemoryTracker::Allocate(size_t size, MemoryTag tag, size_t alignment, const char* typeName) {
+    void* p = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? ::operator new(size, std::align_val_t(alignment))
+        : ::operator new(size);
+
+    TagCounters& c = tagCounters[static_cast<size_t>(tag)];
+    uint64_t live = c.live.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = c.peak.load(std::memory_order_relaxed);
+    while (live > peak && !c.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (leakTracking.load(std::memory_order_relaxed)) {
+        LeakState& leaks = GetLeakState();
+        std::lock_guard<std::mutex> lock(leaks.mutex);
+        leaks.live[p] = LeakRecord{size, tag, typeName};
+    }
+    return p;
+}
+
+void MemoryTracker::Free(void* p, size_t size, MemoryTag tag, size_t alignment) {
+    if (!p) return;
+
+    if (leakTracking.load(std::memory_order_relaxed)) {
+        LeakState& leaks = GetLeakState();
+        std::lock_guard<std::mutex> lock(leaks.mutex);
+        leaks.live.erase(p);
+    }
+
+    TagCounters& c = tagCounters[static_cast<size_t>(tag)];
+    c.live.fetch_sub(size, std::memory_order_relaxed);
+    c.frees.fetch_add(1, std::memory_order_relaxed);
+
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        ::operator delete(p, size, std::align_val_t(alignment));
+    } else {
+        ::operator delete(p, size);
+    }
+}
+
+MemoryTracker::TagStats MemoryTracker::GetStats(MemoryTag tag) {
+    const TagCounters& c = tagCounters[static_cast<size_t>(tag)];
+    TagStats stats;
+    stats.liveBytes = c.live.load(std::memory_order_relaxed);
+    stats.peakBytes = c.peak.load(std::memory_order_relaxed);
+    stats.allocations = c.allocations.load(std::memory_order_relaxed);
+    stats.frees = c.frees.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < TAG_COUNT ? TAG_NAMES[index] : "?";
+}
+
+void MemoryTracker::SetLeakTracking(bool enable) {
+    LeakState& leaks = GetLeakState();
+    std::lock_guard<std::mutex> lock(leaks.mutex);
+    leakTracking.store(enable, std::memory_order_relaxed);
+    if (!enable) leaks.live.clear();
+}
+
+bool MemoryTracker::IsLeakTracking() {
+    return leakTracking.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::ReportLeaks() {
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        TagStats stats = GetStats(static_cast<MemoryTag>(i));
+        if (stats.allocations == 0) continue;
+        Logger::Log("Память [", TAG_NAMES[i], "]: живых байт ", stats.liveBytes, ", пик ", stats.peakBytes,
+                    ", выделений ", stats.allocations, ", освобождений ", stats.frees);
+    }
+
+    if (!IsLeakTracking()) return;
+
+    struct Group {
+        MemoryTag tag;
+        const char* typeName;
+        size_t count;
+        size_t bytes;
+    };
+    std::vector<Group> groups;
+    {
+        LeakState& leaks = GetLeakState();
+        std::lock_guard<std::mutex> lock(leaks.mutex);
+        for (const auto& entry : leaks.live) {
+            const LeakRecord& r = entry.second;
+            auto it = std::find_if(groups.begin(), groups.end(), [&r](const Group& g) {
+                return g.tag == r.tag && g.typeName == r.typeName;
+            });
+            if (it == groups.end()) {
+                groups.push_back(Group{r.tag, r.typeName, 1, r.size});
+            } else {
+                ++it->count;
+                it->bytes += r.size;
+            }
+        }
+    }
+
+    if (groups.empty()) {
+        Logger::Log("Утечек памяти не найдено");
+        return;
+    }
+    std::sort(groups.begin(), groups.end(), [](const Group& a, const Group& b) { return a.bytes > b.bytes; });
+    constexpr size_t MAX_LINES = 32;
+    for (size_t i = 0; i < groups.size() && i < MAX_LINES; ++i) {
+        const Group& g = groups[i];
+        Logger::Warning("Не освобождено [", GetTagName(g.tag), "] ", ReadableTypeName(g.typeName),
+                        ": ", g.count, " шт., ", g.bytes, " байт");
+    }
+    if (groups.size() > MAX_LINES) {
+        Logger::Warning("... и ещё ", groups.size() - MAX_LINES, " типов");
+    }
+}
+
+void MemoryTracker::ParseCommandLine(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--memory-leaks") == 0) SetLeakTracking(true);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <typeinfo>
+
+// Подсистема, на которую записывается память
+enum class MemoryTag : uint8_t {
+    General,
+    Terrain,
+    Meshes,
+    ECS,
+    Physics,
+    Network,
+    Audio,
+    Game,
+    Logs,
+    Frame, // временная память кадра (FrameArena)
+    Count
+};
+
+// Учёт памяти по тегам: живые байты, пик и число выделений.
+// Значения попадают в метрики (rtgc_memory_<тег>_live_bytes, _peak_bytes, _allocations_total),
+// по желанию ведётся список живых выделений для отчёта об утечках при выходе.
+class MemoryTracker {
+public:
+    struct TagStats {
+        uint64_t liveBytes;
+        uint64_t peakBytes;
+        uint64_t allocations;
+        uint64_t frees;
+    };
+
+    static void* Allocate(size_t size, MemoryTag tag, size_t alignment = alignof(std::max_align_t),
+                          const char* typeName = nullptr);
+    // size и alignment - те же, что при выделении
+    static void Free(void* p, size_t size, MemoryTag tag, size_t alignment = alignof(std::max_align_t));
+
+    // Замена new/delete для объектов подсистем; Delete - только с тем же тегом и точным типом объекта
+    template<typename T, typename... Args>
+    static T* New(MemoryTag tag, Args&&... args) {
+        void* p = Allocate(sizeof(T), tag, alignof(T), typeid(T).name());
+        try {
+            return new (p) T(std::forward<Args>(args)...);
+        } catch (...) {
+            Free(p, sizeof(T), tag, alignof(T));
+            throw;
+        }
+    }
+
+    template<typename T>
+    static void Delete(MemoryTag tag, T* p) {
+        if (!p) return;
+        p->~T();
+        Free(p, sizeof(T), tag, alignof(T));
+    }
+
+    static TagStats GetStats(MemoryTag tag);
+    static const char* GetTagName(MemoryTag tag);
+
+    // Запоминать каждое выделение (адрес, размер, тип) для ReportLeaks. Дороже: мьютекс и хэш-таблица.
+    // Включать до того, как подсистемы начнут выделять память; выделения до включения в отчёт не попадут.
+    static void SetLeakTracking(bool enable);
+    static bool IsLeakTracking();
+    // Живая память по тегам в лог, а при SetLeakTracking - ещё и неосвобождённые выделения по типам
+    static void ReportLeaks();
+
+    // --memory-leaks включает SetLeakTracking. Остальные аргументы пропускаются.
+    static void ParseCommandLine(int argc, char** argv);
+};
+
+// Аллокатор для контейнеров STL с тегом подсистемы:
+//     std::vector<float, TaggedAllocator<float, MemoryTag::Terrain>> heights;
+template<typename T, MemoryTag Tag>
+class TaggedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() noexcept = default;
+    template<typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(MemoryTracker::Allocate(n * sizeof(T), Tag, alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        MemoryTracker::Free(p, n * sizeof(T), Tag, alignof(T));
+    }
+
+    template<typename U>
+    bool operator==(const TaggedAllocator<U, Tag>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const TaggedAllocator<U, Tag>&) const noexcept { return false; }
+};
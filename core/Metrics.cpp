@@ -0,0 +1,423 @@
+#include "Metrics.hpp"
+#include "Logger.hpp"
+#include "MemoryTracker.hpp"
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+MetricHistogram::MetricHistogram() {
+    for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::Record(uint64_t value) {
+    counts[HistogramBuckets::Index(value)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t current = minValue.load(std::memory_order_relaxed);
+    while (value < current && !minValue.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    current = maxValue.load(std::memory_order_relaxed);
+    while (value > current && !maxValue.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+MetricHistogram::Snapshot MetricHistogram::Take() const {
+    // Без блокировки: запись между чтениями полей даёт расхождение в единицы, для дашборда это не важно
+    Snapshot s;
+    s.counts.resize(HistogramBuckets::COUNT);
+    for (int b = 0; b < HistogramBuckets::COUNT; ++b) {
+        s.counts[b] = counts[b].load(std::memory_order_relaxed);
+        s.count += s.counts[b];
+    }
+    s.sum = sum.load(std::memory_order_relaxed);
+    s.min = s.count > 0 ? minValue.load(std::memory_order_relaxed) : 0;
+    s.max = maxValue.load(std::memory_order_relaxed);
+    return s;
+}
+
+uint64_t MetricHistogram::Snapshot::Percentile(double q) const {
+    uint64_t value = HistogramBuckets::Percentile(q, count, [this](int b) { return counts[b]; });
+    return value < max ? value : max;
+}
+
+namespace {
+    enum class MetricType {
+        Counter,
+        Gauge,
+        Histogram,
+        CounterSource,
+        GaugeSource
+    };
+
+    struct MetricEntry {
+        std::string name;
+        std::string help;
+        MetricType type;
+        std::unique_ptr<MetricCounter> counter;
+        std::unique_ptr<MetricGauge> gauge;
+        std::unique_ptr<MetricHistogram> histogram;
+        std::function<uint64_t()> source;
+        std::function<int64_t()> gaugeSource;
+        uint64_t lastValue = 0; // для скорости счётчика
+    };
+
+    struct MetricsState {
+        std::mutex registryMutex;
+        std::vector<std::unique_ptr<MetricEntry>> entries;
+        std::chrono::steady_clock::time_point lastFormat;
+        bool formattedOnce = false;
+
+        std::mutex dumpMutex;
+        std::condition_variable dumpCv;
+        std::thread dumpThread;
+        bool stopRequested = false;
+        bool dumping = false;
+        bool writeFailed = false;
+        std::string dumpPath = Metrics::DEFAULT_DUMP_FILE;
+        double dumpInterval = Metrics::DEFAULT_DUMP_INTERVAL;
+
+        MetricsState() {
+            // Писатель лога создаётся раньше и потому уничтожается позже реестра:
+            // последняя выгрузка при выходе ещё может читать его счётчики
+            Logger::GetBlockedCount();
+            // Объём лога считает фоновый писатель логгера, здесь только чтение
+            AddSource("rtgc_log_lines_total", "Строк записано в лог", []() { return Logger::GetWrittenCount(); });
+            AddSource("rtgc_log_blocked_total", "Вызовов лога, ждавших места в заполненной очереди",
+                      []() { return Logger::GetBlockedCount(); });
+            // Память по тегам MemoryTracker: его счётчики не уничтожаются, читать можно до самого выхода
+            for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+                MemoryTag tag = static_cast<MemoryTag>(i);
+                std::string prefix = std::string("rtgc_memory_") + MemoryTracker::GetTagName(tag);
+                AddGaugeSource(prefix + "_live_bytes", std::string("Живая память, байт: ") + MemoryTracker::GetTagName(tag),
+                               [tag]() { return static_cast<int64_t>(MemoryTracker::GetStats(tag).liveBytes); });
+                AddGaugeSource(prefix + "_peak_bytes", std::string("Пик памяти, байт: ") + MemoryTracker::GetTagName(tag),
+                               [tag]() { return static_cast<int64_t>(MemoryTracker::GetStats(tag).peakBytes); });
+                AddSource(prefix + "_allocations_total", std::string("Выделений памяти: ") + MemoryTracker::GetTagName(tag),
+                          [tag]() { return MemoryTracker::GetStats(tag).allocations; });
+            }
+        }
+
+        ~MetricsState() {
+            Stop();
+        }
+
+        void AddSource(const std::string& name, const std::string& help, std::function<uint64_t()> source) {
+            auto entry = std::make_unique<MetricEntry>();
+            entry->name = name;
+            entry->help = help;
+            entry->type = MetricType::CounterSource;
+            entry->source = std::move(source);
+            entries.push_back(std::move(entry));
+        }
+
+        void AddGaugeSource(const std::string& name, const std::string& help, std::function<int64_t()> source) {
+            auto entry = std::make_unique<MetricEntry>();
+            entry->name = name;
+            entry->help = help;
+            entry->type = MetricType::GaugeSource;
+            entry->gaugeSource = std::move(source);
+            entries.push_back(std::move(entry));
+        }
+
+        // Под registryMutex
+        MetricEntry* Find(const std::string& name) {
+            for (auto& entry : entries) {
+                if (entry->name == name) return entry.get();
+            }
+            return nullptr;
+        }
+
+        void Stop() {
+            {
+                std::lock_guard<std::mutex> lock(dumpMutex);
+                if (!dumping) return;
+                stopRequested = true;
+            }
+            dumpCv.notify_one();
+            dumpThread.join();
+            std::lock_guard<std::mutex> lock(dumpMutex);
+            dumping = false;
+            stopRequested = false;
+        }
+    };
+
+    MetricsState& GetState() {
+        static MetricsState state;
+        return state;
+    }
+
+    // Повторная регистрация с другим типом - ошибка в коде; метрика уходит в заглушку, а не роняет игру
+    template<typename T>
+    T& Mismatch(const std::string& name) {
+        LOG_WARNING(Core, "Метрика ", name, " уже зарегистрирована с другим типом");
+        static T dummy;
+        return dummy;
+    }
+
+    void AppendHeader(std::string& out, const std::string& name, const std::string& help, const char* type) {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        out += help;
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += type;
+        out += '\n';
+    }
+
+    void AppendValue(std::string& out, const std::string& name, const char* labels, uint64_t value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), " %llu\n", static_cast<unsigned long long>(value));
+        out += name;
+        out += labels;
+        out += buffer;
+    }
+
+    void AppendGauge(std::string& out, const MetricEntry& entry, int64_t value) {
+        AppendHeader(out, entry.name, entry.help, "gauge");
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), " %lld\n", static_cast<long long>(value));
+        out += entry.name;
+        out += buffer;
+    }
+
+    void AppendCounter(std::string& out, MetricEntry& entry, uint64_t value, double elapsedSeconds) {
+        AppendHeader(out, entry.name, entry.help, "counter");
+        AppendValue(out, entry.name, "", value);
+        if (elapsedSeconds > 0.0) {
+            std::string rateName = entry.name;
+            if (rateName.size() > 6 && rateName.compare(rateName.size() - 6, 6, "_total") == 0) {
+                rateName.resize(rateName.size() - 6);
+            }
+            rateName += "_per_second";
+            AppendHeader(out, rateName, entry.help + " в секунду", "gauge");
+            char buffer[64];
+            double rate = value >= entry.lastValue ? static_cast<double>(value - entry.lastValue) / elapsedSeconds : 0.0;
+            std::snprintf(buffer, sizeof(buffer), " %.3f\n", rate);
+            out += rateName;
+            out += buffer;
+        }
+        entry.lastValue = value;
+    }
+
+    void AppendHistogram(std::string& out, const MetricEntry& entry) {
+        MetricHistogram::Snapshot s = entry.histogram->Take();
+        AppendHeader(out, entry.name, entry.help, "summary");
+        AppendValue(out, entry.name, "{quantile=\"0.5\"}", s.Percentile(0.5));
+        AppendValue(out, entry.name, "{quantile=\"0.9\"}", s.Percentile(0.9));
+        AppendValue(out, entry.name, "{quantile=\"0.99\"}", s.Percentile(0.99));
+        AppendValue(out, entry.name + "_sum", "", s.sum);
+        AppendValue(out, entry.name + "_count", "", s.count);
+        AppendHeader(out, entry.name + "_min", entry.help + ", минимум", "gauge");
+        AppendValue(out, entry.name + "_min", "", s.min);
+        AppendHeader(out, entry.name + "_max", entry.help + ", максимум", "gauge");
+        AppendValue(out, entry.name + "_max", "", s.max);
+    }
+
+    std::string FormatAll(MetricsState& s) {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = s.formattedOnce ? std::chrono::duration<double>(now - s.lastFormat).count() : 0.0;
+        s.lastFormat = now;
+        s.formattedOnce = true;
+
+        std::string out;
+        out.reserve(s.entries.size() * 128);
+        for (auto& entry : s.entries) {
+            switch (entry->type) {
+            case MetricType::Counter:
+                AppendCounter(out, *entry, entry->counter->Get(), elapsed);
+                break;
+            case MetricType::CounterSource:
+                AppendCounter(out, *entry, entry->source ? entry->source() : 0, elapsed);
+                break;
+            case MetricType::Gauge:
+                AppendGauge(out, *entry, entry->gauge->Get());
+                break;
+            case MetricType::GaugeSource:
+                AppendGauge(out, *entry, entry->gaugeSource ? entry->gaugeSource() : 0);
+                break;
+            case MetricType::Histogram:
+                AppendHistogram(out, *entry);
+                break;
+            }
+        }
+        return out;
+    }
+
+    void WriteDump(MetricsState& s, const std::string& path) {
+        std::string text = FormatAll(s);
+        std::error_code ec;
+        std::filesystem::path target(path);
+        if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), ec);
+
+        // Читатель дашборда не должен увидеть наполовину записанный файл
+        std::string tempName = path + ".tmp";
+        bool ok = false;
+        {
+            std::ofstream file(tempName, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (file) {
+                file.write(text.data(), static_cast<std::streamsize>(text.size()));
+                ok = static_cast<bool>(file);
+            }
+        }
+        if (ok) {
+            std::filesystem::rename(tempName, path, ec);
+            ok = !ec;
+        }
+        if (!ok) {
+            std::filesystem::remove(tempName, ec);
+            if (!s.writeFailed) LOG_WARNING(Core, "Не удалось записать метрики в ", path);
+        }
+        s.writeFailed = !ok;
+    }
+
+    void DumpLoop(MetricsState& s, std::string path, double intervalSeconds) {
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(intervalSeconds));
+        std::unique_lock<std::mutex> lock(s.dumpMutex);
+        bool stop = false;
+        while (!stop) {
+            stop = s.dumpCv.wait_for(lock, interval, [&s]() { return s.stopRequested; });
+            lock.unlock();
+            WriteDump(s, path);
+            lock.lock();
+        }
+    }
+}
+
+MetricCounter& Metrics::GetCounter(const std::string& name, const std::string& help) {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    if (MetricEntry* existing = s.Find(name)) {
+        if (existing->type != MetricType::Counter) return Mismatch<MetricCounter>(name);
+        return *existing->counter;
+    }
+    auto entry = std::make_unique<MetricEntry>();
+    entry->name = name;
+    entry->help = help;
+    entry->type = MetricType::Counter;
+    entry->counter = std::make_unique<MetricCounter>();
+    MetricCounter& result = *entry->counter;
+    s.entries.push_back(std::move(entry));
+    return result;
+}
+
+MetricGauge& Metrics::GetGauge(const std::string& name, const std::string& help) {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    if (MetricEntry* existing = s.Find(name)) {
+        if (existing->type != MetricType::Gauge) return Mismatch<MetricGauge>(name);
+        return *existing->gauge;
+    }
+    auto entry = std::make_unique<MetricEntry>();
+    entry->name = name;
+    entry->help = help;
+    entry->type = MetricType::Gauge;
+    entry->gauge = std::make_unique<MetricGauge>();
+    MetricGauge& result = *entry->gauge;
+    s.entries.push_back(std::move(entry));
+    return result;
+}
+
+MetricHistogram& Metrics::GetHistogram(const std::string& name, const std::string& help) {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    if (MetricEntry* existing = s.Find(name)) {
+        if (existing->type != MetricType::Histogram) return Mismatch<MetricHistogram>(name);
+        return *existing->histogram;
+    }
+    auto entry = std::make_unique<MetricEntry>();
+    entry->name = name;
+    entry->help = help;
+    entry->type = MetricType::Histogram;
+    entry->histogram = std::make_unique<MetricHistogram>();
+    MetricHistogram& result = *entry->histogram;
+    s.entries.push_back(std::move(entry));
+    return result;
+}
+
+void Metrics::RegisterCounterSource(const std::string& name, const std::string& help, std::function<uint64_t()> source) {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    if (MetricEntry* existing = s.Find(name)) {
+        if (existing->type != MetricType::CounterSource) {
+            LOG_WARNING(Core, "Метрика ", name, " уже зарегистрирована с другим типом");
+            return;
+        }
+        existing->source = std::move(source);
+        return;
+    }
+    s.AddSource(name, help, std::move(source));
+}
+
+void Metrics::RegisterGaugeSource(const std::string& name, const std::string& help, std::function<int64_t()> source) {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    if (MetricEntry* existing = s.Find(name)) {
+        if (existing->type != MetricType::GaugeSource) {
+            LOG_WARNING(Core, "Метрика ", name, " уже зарегистрирована с другим типом");
+            return;
+        }
+        existing->gaugeSource = std::move(source);
+        return;
+    }
+    s.AddGaugeSource(name, help, std::move(source));
+}
+
+std::string Metrics::FormatText() {
+    return FormatAll(GetState());
+}
+
+void Metrics::StartDump() {
+    MetricsState& s = GetState();
+    std::string path;
+    double interval;
+    {
+        std::lock_guard<std::mutex> lock(s.dumpMutex);
+        path = s.dumpPath;
+        interval = s.dumpInterval;
+    }
+    if (interval > 0.0) StartDump(path, interval);
+}
+
+void Metrics::StartDump(const std::string& path, double intervalSeconds) {
+    MetricsState& s = GetState();
+    s.Stop();
+    if (intervalSeconds <= 0.0) return;
+    std::lock_guard<std::mutex> lock(s.dumpMutex);
+    s.dumpPath = path;
+    s.dumpInterval = intervalSeconds;
+    s.writeFailed = false;
+    s.dumping = true;
+    s.dumpThread = std::thread(DumpLoop, std::ref(s), path, intervalSeconds);
+    LOG_INFO(Core, "Метрики пишутся в ", path, " каждые ", intervalSeconds, " с");
+}
+
+void Metrics::StopDump() {
+    GetState().Stop();
+}
+
+bool Metrics::IsDumping() {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.dumpMutex);
+    return s.dumping;
+}
+
+void Metrics::ParseCommandLine(int argc, char** argv) {
+    MetricsState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.dumpMutex);
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--metrics-file=", 15) == 0) {
+            s.dumpPath = arg + 15;
+        } else if (std::strncmp(arg, "--metrics-interval=", 19) == 0) {
+            s.dumpInterval = std::atof(arg + 19);
+        }
+    }
+}
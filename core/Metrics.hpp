@@ -0,0 +1,86 @@
+#pragma once
+#include "Histogram.hpp"
+#include <atomic>
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+// Счётчик событий: только растёт. Один атомарный add, из любого потока.
+class MetricCounter {
+    std::atomic<uint64_t> value{0};
+
+public:
+    void Add(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t Get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Текущее значение: число тел, объектов, байт. Set или Add со знаком, из любого потока.
+class MetricGauge {
+    std::atomic<int64_t> value{0};
+
+public:
+    void Set(int64_t v) { value.store(v, std::memory_order_relaxed); }
+    void Add(int64_t delta) { value.fetch_add(delta, std::memory_order_relaxed); }
+    int64_t Get() const { return value.load(std::memory_order_relaxed); }
+};
+
+// Распределение значений (время кадра в мкс, размер пакета) с квантилями.
+// Интервалы - HistogramBuckets, запись - один атомарный add в интервал плюс сумма/мин/макс.
+class MetricHistogram {
+    std::atomic<uint64_t> counts[HistogramBuckets::COUNT];
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> minValue{UINT64_MAX};
+    std::atomic<uint64_t> maxValue{0};
+
+public:
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t min = 0;
+        uint64_t max = 0;
+        std::vector<uint64_t> counts;
+
+        uint64_t Percentile(double q) const;
+    };
+
+    MetricHistogram();
+
+    void Record(uint64_t value);
+    Snapshot Take() const;
+};
+
+// Реестр метрик и периодическая выгрузка в текстовый файл (формат Prometheus text exposition:
+// его читают node_exporter textfile collector, Telegraf и Grafana Agent).
+// Метрику получают по имени один раз и хранят ссылку, например в статической переменной:
+//     static MetricCounter& packets = Metrics::GetCounter("rtgc_net_packets_received_total", "...");
+// Ссылки живут до конца программы.
+class Metrics {
+public:
+    static constexpr const char* DEFAULT_DUMP_FILE = "logs/metrics.prom";
+    static constexpr double DEFAULT_DUMP_INTERVAL = 10.0;
+
+    static MetricCounter& GetCounter(const std::string& name, const std::string& help);
+    static MetricGauge& GetGauge(const std::string& name, const std::string& help);
+    static MetricHistogram& GetHistogram(const std::string& name, const std::string& help);
+    // Счётчик или текущее значение, которые ведёт сама подсистема: значение снимается при выгрузке.
+    // Источник вызывается из потока выгрузки и должен читать только атомарные данные.
+    static void RegisterCounterSource(const std::string& name, const std::string& help,
+                                      std::function<uint64_t()> source);
+    static void RegisterGaugeSource(const std::string& name, const std::string& help,
+                                    std::function<int64_t()> source);
+
+    // Все метрики текстом. Для счётчиков ещё и скорость (<имя>_per_second) с прошлого вызова.
+    static std::string FormatText();
+
+    // Фоновый поток пишет FormatText в файл раз в интервал (через временный файл и rename).
+    // Без аргументов - путь и интервал из ParseCommandLine или значения по умолчанию; интервал <= 0 - не запускать.
+    static void StartDump();
+    static void StartDump(const std::string& path, double intervalSeconds);
+    // Останавливает поток, записав последний снимок
+    static void StopDump();
+    static bool IsDumping();
+
+    // --metrics-file=путь, --metrics-interval=секунд (0 - выключить). Остальные аргументы пропускаются.
+    static void ParseCommandLine(int argc, char** argv);
+};
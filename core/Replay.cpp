@@ -0,0 +1,325 @@
+#include "Replay.hpp"
+#include "BinaryStream.hpp"
+#include "Logger.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+namespace {
+    // Сбрасывать файл записи раз в столько тиков: при падении теряется не больше
+    constexpr uint64_t FLUSH_TICKS = 64;
+
+    struct ReplayState {
+        uint32_t seed = 0;
+
+        // Запись
+        bool recording = false;
+        std::ofstream file;
+        std::string path;
+        std::vector<uint8_t> buffer;
+        std::vector<Replay::KeyEvent> pendingKeys;
+        std::vector<std::string> pendingPackets;
+        float tickDt = 0.0f;
+
+        // Воспроизведение
+        bool replaying = false;
+        std::vector<uint8_t> data;
+        size_t readPos = 0;
+        uint64_t recordedHash = 0;
+        uint64_t firstDivergence = UINT64_MAX;
+        std::chrono::steady_clock::time_point replayStart;
+
+        // Тик, начатый BeginTick
+        std::vector<Replay::KeyEvent> tickKeys;
+        std::vector<std::string> tickPackets;
+        uint64_t tick = 0;
+        bool inTick = false;
+    };
+
+    ReplayState& GetState() {
+        static ReplayState state;
+        return state;
+    }
+
+    std::string DefaultRecordPath() {
+        char name[64];
+        std::time_t now = std::time(nullptr);
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &now);
+#else
+        localtime_r(&now, &tm);
+#endif
+        std::strftime(name, sizeof(name), "logs/replay_%Y%m%d_%H%M%S.rtgr", &tm);
+        return name;
+    }
+
+    void FinishReplay(ReplayState& s) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - s.replayStart).count();
+        if (s.firstDivergence == UINT64_MAX) {
+            LOG_INFO(Core, "Воспроизведение завершено: ", s.tick, " тиков за ", seconds, " с, расхождений нет");
+        } else {
+            LOG_WARNING(Core, "Воспроизведение завершено: ", s.tick, " тиков за ", seconds,
+                        " с, первое расхождение на тике ", s.firstDivergence);
+        }
+        s.replaying = false;
+        s.data.clear();
+        s.data.shrink_to_fit();
+    }
+
+    // Тик записи: [float dt][uint16 клавиш][uint16 пакетов][клавиши: uint16 код, uint8 нажата]
+    //             [пакеты: uint32 размер, байты][uint64 хэш состояния]
+    bool ReadTick(ReplayState& s, float& dt) {
+        ByteReader reader(s.data.data() + s.readPos, s.data.size() - s.readPos);
+        dt = reader.Read<float>();
+        uint16_t keyCount = reader.Read<uint16_t>();
+        uint16_t packetCount = reader.Read<uint16_t>();
+        s.tickKeys.clear();
+        for (uint16_t i = 0; i < keyCount; ++i) {
+            uint16_t key = reader.Read<uint16_t>();
+            uint8_t pressed = reader.Read<uint8_t>();
+            s.tickKeys.push_back(Replay::KeyEvent{key, pressed != 0});
+        }
+        s.tickPackets.clear();
+        for (uint16_t i = 0; i < packetCount; ++i) {
+            uint32_t size = reader.Read<uint32_t>();
+            if (size > reader.GetRemaining()) return false;
+            std::string packet(size, '\0');
+            reader.ReadBytes(packet.data(), size);
+            s.tickPackets.push_back(std::move(packet));
+        }
+        s.recordedHash = reader.Read<uint64_t>();
+        if (!reader.IsOk()) return false;
+        s.readPos = s.data.size() - reader.GetRemaining();
+        return true;
+    }
+}
+
+uint32_t Replay::GetSeed() {
+    ReplayState& s = GetState();
+    if (s.seed == 0) {
+        std::random_device rd;
+        do {
+            s.seed = rd();
+        } while (s.seed == 0);
+    }
+    return s.seed;
+}
+
+void Replay::SetSeed(uint32_t seed) {
+    ReplayState& s = GetState();
+    if (s.replaying) return;
+    s.seed = seed;
+}
+
+bool Replay::StartRecording(const std::string& path) {
+    ReplayState& s = GetState();
+    if (s.recording || s.replaying) return false;
+
+    s.path = path.empty() ? DefaultRecordPath() : path;
+    std::error_code ec;
+    std::filesystem::path target(s.path);
+    if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), ec);
+    s.file.open(s.path, std::ios::binary | std::ios::trunc);
+    if (!s.file) {
+        LOG_ERROR(Core, "Не удалось открыть файл записи сессии: ", s.path);
+        return false;
+    }
+
+    s.buffer.clear();
+    ByteWriter writer(s.buffer);
+    writer.Write(FILE_MAGIC);
+    writer.Write(FILE_VERSION);
+    writer.Write(GetSeed());
+    s.file.write(reinterpret_cast<const char*>(s.buffer.data()), static_cast<std::streamsize>(s.buffer.size()));
+
+    s.recording = true;
+    s.tick = 0;
+    s.inTick = false;
+    s.pendingKeys.clear();
+    s.pendingPackets.clear();
+    LOG_INFO(Core, "Запись сессии: ", s.path, ", зерно ", s.seed);
+    return true;
+}
+
+void Replay::StopRecording() {
+    ReplayState& s = GetState();
+    if (!s.recording) return;
+    s.recording = false;
+    s.file.close();
+    LOG_INFO(Core, "Запись сессии завершена: ", s.path, ", тиков ", s.tick);
+}
+
+bool Replay::IsRecording() {
+    return GetState().recording;
+}
+
+bool Replay::StartReplay(const std::string& path) {
+    ReplayState& s = GetState();
+    if (s.recording || s.replaying) return false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR(Core, "Не удалось открыть запись сессии: ", path);
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ByteReader reader(data);
+    uint32_t magic = reader.Read<uint32_t>();
+    uint16_t version = reader.Read<uint16_t>();
+    uint32_t seed = reader.Read<uint32_t>();
+    if (!reader.IsOk() || magic != FILE_MAGIC || version != FILE_VERSION) {
+        LOG_ERROR(Core, "Файл не является записью сессии версии ", FILE_VERSION, ": ", path);
+        return false;
+    }
+
+    s.data = std::move(data);
+    s.readPos = s.data.size() - reader.GetRemaining();
+    s.seed = seed;
+    s.tick = 0;
+    s.inTick = false;
+    s.firstDivergence = UINT64_MAX;
+    s.replaying = true;
+    s.replayStart = std::chrono::steady_clock::now();
+    LOG_INFO(Core, "Воспроизведение сессии: ", path, ", зерно ", seed);
+    return true;
+}
+
+bool Replay::IsReplaying() {
+    return GetState().replaying;
+}
+
+bool Replay::BeginTick(float& dt) {
+    ReplayState& s = GetState();
+    if (s.replaying) {
+        if (s.readPos >= s.data.size()) {
+            FinishReplay(s);
+            return false;
+        }
+        if (!ReadTick(s, dt)) {
+            LOG_WARNING(Core, "Запись сессии обрывается на тике ", s.tick);
+            FinishReplay(s);
+            return false;
+        }
+        s.inTick = true;
+        return true;
+    }
+
+    if (s.recording) {
+        s.tickDt = dt;
+        s.tickKeys.swap(s.pendingKeys);
+        s.pendingKeys.clear();
+        s.inTick = true;
+    }
+    return true;
+}
+
+const std::vector<Replay::KeyEvent>& Replay::GetTickKeys() {
+    ReplayState& s = GetState();
+    static const std::vector<KeyEvent> empty;
+    return s.replaying && s.inTick ? s.tickKeys : empty;
+}
+
+void Replay::EndTick(uint64_t stateHash) {
+    ReplayState& s = GetState();
+    if (!s.inTick) return;
+    s.inTick = false;
+
+    if (s.replaying) {
+        if (stateHash != s.recordedHash && s.firstDivergence == UINT64_MAX) {
+            s.firstDivergence = s.tick;
+            LOG_WARNING(Core, "Воспроизведение разошлось с записью на тике ", s.tick);
+        }
+        s.tickPackets.clear();
+        ++s.tick;
+        return;
+    }
+
+    if (!s.recording) return;
+    s.buffer.clear();
+    ByteWriter writer(s.buffer);
+    writer.Write(s.tickDt);
+    writer.Write(static_cast<uint16_t>(s.tickKeys.size()));
+    writer.Write(static_cast<uint16_t>(s.pendingPackets.size()));
+    for (const KeyEvent& k : s.tickKeys) {
+        writer.Write(static_cast<uint16_t>(k.key));
+        writer.Write(static_cast<uint8_t>(k.pressed ? 1 : 0));
+    }
+    for (const std::string& packet : s.pendingPackets) {
+        writer.Write(static_cast<uint32_t>(packet.size()));
+        writer.WriteBytes(packet.data(), packet.size());
+    }
+    writer.Write(stateHash);
+    s.file.write(reinterpret_cast<const char*>(s.buffer.data()), static_cast<std::streamsize>(s.buffer.size()));
+    s.pendingPackets.clear();
+    s.tickKeys.clear();
+
+    if (++s.tick % FLUSH_TICKS == 0) s.file.flush();
+}
+
+uint64_t Replay::GetTick() {
+    return GetState().tick;
+}
+
+uint64_t Replay::GetFirstDivergence() {
+    return GetState().firstDivergence;
+}
+
+uint64_t Replay::Hash(const void* data, size_t size, uint64_t hash) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void Replay::RecordKey(int key, bool pressed) {
+    ReplayState& s = GetState();
+    if (!s.recording) return;
+    s.pendingKeys.push_back(KeyEvent{key, pressed});
+}
+
+void Replay::RecordPacket(const void* data, size_t size) {
+    ReplayState& s = GetState();
+    if (!s.recording) return;
+    // Пакет уходит в файл с ближайшим EndTick; число пакетов тика в формате 16-битное
+    if (s.pendingPackets.size() >= UINT16_MAX) {
+        LOG_WARNING(Core, "Слишком много пакетов за тик, пакет не записан");
+        return;
+    }
+    s.pendingPackets.emplace_back(static_cast<const char*>(data), size);
+}
+
+std::vector<std::string> Replay::TakeTickPackets() {
+    ReplayState& s = GetState();
+    std::vector<std::string> packets;
+    if (s.replaying && s.inTick) packets.swap(s.tickPackets);
+    return packets;
+}
+
+void Replay::ParseCommandLine(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--seed=", 7) == 0) {
+            SetSeed(static_cast<uint32_t>(std::strtoul(arg + 7, nullptr, 10)));
+        }
+    }
+    // Запись и воспроизведение - после зерна: заголовок записи его содержит
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--record") == 0) {
+            StartRecording();
+        } else if (std::strncmp(arg, "--record=", 9) == 0) {
+            StartRecording(arg + 9);
+        } else if (std::strncmp(arg, "--replay=", 9) == 0) {
+            StartReplay(arg + 9);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Запись сессии для детерминированного воспроизведения.
+// Файл: заголовок с зерном сессии, затем по записи на тик - dt, смены клавиш (InputManager::SetKeyState),
+// принятые сетевые пакеты (NetworkManager) и хэш состояния симуляции после тика.
+// При воспроизведении движок работает без окна и без пауз между кадрами: dt, клавиши и пакеты
+// берутся из файла, а расхождение хэша показывает первый тик, где симуляция пошла иначе.
+//
+// Тик в главном цикле:
+//     if (!Replay::BeginTick(dt)) break;  // после опроса окна, до обновления систем
+//     for (const Replay::KeyEvent& k : Replay::GetTickKeys()) InputManager::SetKeyState(k.key, k.pressed);
+//     ... симуляция ...
+//     Replay::EndTick(хэш состояния);
+// Вызывать из главного потока.
+class Replay {
+public:
+    struct KeyEvent {
+        int key;
+        bool pressed;
+    };
+
+    static constexpr uint32_t FILE_MAGIC = 0x52475452; // "RTGR"
+    static constexpr uint16_t FILE_VERSION = 1;
+
+    // Зерно сессии: из файла при воспроизведении, иначе заданное SetSeed или случайное,
+    // выбранное при первом вызове. Всё случайное в симуляции должно браться от него.
+    static uint32_t GetSeed();
+    static void SetSeed(uint32_t seed);
+
+    // Пустой путь - logs/replay_<дата>_<время>.rtgr
+    static bool StartRecording(const std::string& path = std::string());
+    static void StopRecording();
+    static bool IsRecording();
+
+    // Читает файл целиком; дальше тики идут из него
+    static bool StartReplay(const std::string& path);
+    static bool IsReplaying();
+
+    // Начало тика. При записи фиксирует dt и клавиши с прошлого тика,
+    // при воспроизведении подставляет записанный dt. false - запись воспроизведена до конца.
+    static bool BeginTick(float& dt);
+    // Смены клавиш текущего тика при воспроизведении
+    static const std::vector<KeyEvent>& GetTickKeys();
+    // Конец тика: при записи пишет тик в файл, при воспроизведении сверяет хэш
+    static void EndTick(uint64_t stateHash);
+    static uint64_t GetTick();
+    // FNV-1a для хэша состояния; цепочкой: Hash(&b, sizeof(b), Hash(&a, sizeof(a)))
+    static constexpr uint64_t HASH_SEED = 14695981039346656037ull;
+    static uint64_t Hash(const void* data, size_t size, uint64_t hash = HASH_SEED);
+    // Тик, на котором хэш впервые разошёлся с записью; UINT64_MAX - расхождений нет
+    static uint64_t GetFirstDivergence();
+
+    // Источники событий; без записи ничего не делают. Клавиши - только смены состояния.
+    static void RecordKey(int key, bool pressed);
+    static void RecordPacket(const void* data, size_t size);
+    // Пакеты текущего тика при воспроизведении; каждый пакет отдаётся один раз
+    static std::vector<std::string> TakeTickPackets();
+
+    // --record[=путь], --replay=путь, --seed=N. Остальные аргументы пропускаются.
+    static void ParseCommandLine(int argc, char** argv);
+};
@@ -0,0 +1,377 @@
+#include "SnapshotFile.hpp"
+#include "BlockCompressor.hpp"
+#include "BinaryStream.hpp"
+#include "ThreadPool.hpp"
+#include "Logger.hpp"
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t sectionCount;
+        uint32_t flags;
+        uint64_t timestamp;
+    };
+
+    struct SectionEntry {
+        uint32_t id;
+        uint32_t blockCount;
+        uint64_t rawSize;
+        uint64_t offset;    // от начала файла
+        uint64_t size;      // таблица блоков + сжатые блоки
+        uint32_t checksum;  // Checksum() несжатых данных
+        uint32_t reserved;
+    };
+
+    struct BlockEntry {
+        uint32_t rawSize;
+        uint32_t storedSize; // == rawSize: блок хранится без сжатия
+    };
+
+    // Одна задача сжатия или распаковки
+    struct BlockJob {
+        size_t section;
+        size_t rawOffset;
+        uint32_t rawSize;
+        std::vector<uint8_t> stored;
+        const uint8_t* storedData = nullptr;
+        uint32_t storedSize = 0;
+        bool ok = true;
+    };
+
+    // Четыре независимые цепочки FNV-1a по 64-битным словам: побайтовый вариант
+    // упирается в задержку умножения и оказывался дольше самого сжатия
+    uint32_t Checksum(const uint8_t* data, size_t size) {
+        const uint64_t prime = 1099511628211ull;
+        uint64_t lanes[4] = {14695981039346656037ull, 1, 2, 3};
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (int k = 0; k < 4; ++k) {
+                uint64_t word;
+                std::memcpy(&word, data + i + k * 8, sizeof(word));
+                lanes[k] = (lanes[k] ^ word) * prime;
+            }
+        }
+        uint64_t hash = lanes[0] ^ (lanes[1] * 3) ^ (lanes[2] * 5) ^ (lanes[3] * 7) ^ size;
+        for (; i < size; ++i) {
+            hash = (hash ^ data[i]) * prime;
+        }
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+    double MsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    constexpr size_t HEADER_SIZE = 24;
+    constexpr size_t ENTRY_SIZE = 40;
+
+    // Данные на диске до переименования: иначе после сбоя питания на месте
+    // сохранения может оказаться пустой или недописанный файл
+    bool SyncToDisk(std::FILE* file) {
+        if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+}
+
+std::vector<uint8_t>& SnapshotFile::AddSection(uint32_t id) {
+    sections.push_back(Section{id, {}});
+    return sections.back().data;
+}
+
+const std::vector<uint8_t>* SnapshotFile::FindSection(uint32_t id) const {
+    for (const auto& section : sections) {
+        if (section.id == id) return &section.data;
+    }
+    return nullptr;
+}
+
+bool SnapshotFile::Encode(std::vector<uint8_t>& out) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<BlockJob> jobs;
+    std::vector<uint32_t> checksums(sections.size());
+    for (size_t s = 0; s < sections.size(); ++s) {
+        size_t size = sections[s].data.size();
+        for (size_t offset = 0; offset < size; offset += BLOCK_SIZE) {
+            BlockJob job;
+            job.section = s;
+            job.rawOffset = offset;
+            job.rawSize = static_cast<uint32_t>(std::min<size_t>(BLOCK_SIZE, size - offset));
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    // Блоки всех секций сжимаются вперемешку, контрольные суммы - по секциям
+    ThreadPool::Global().ParallelFor(jobs.size() + sections.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (IsCancelled()) return;
+            if (i >= jobs.size()) {
+                const auto& data = sections[i - jobs.size()].data;
+                checksums[i - jobs.size()] = Checksum(data.data(), data.size());
+                continue;
+            }
+            BlockJob& job = jobs[i];
+            const uint8_t* raw = sections[job.section].data.data() + job.rawOffset;
+            job.stored.resize(BlockCompressor::GetMaxCompressedSize(job.rawSize));
+            size_t packed = BlockCompressor::Compress(raw, job.rawSize, job.stored.data(), job.stored.size());
+            if (packed == 0 || packed >= job.rawSize) {
+                job.stored.assign(raw, raw + job.rawSize);
+            } else {
+                job.stored.resize(packed);
+            }
+        }
+    });
+    stats.compressMs = MsSince(start);
+    if (IsCancelled()) return false;
+
+    timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    schemaVersion = SCHEMA_VERSION;
+
+    out.clear();
+    ByteWriter writer(out);
+    SnapshotHeader header{MAGIC, SCHEMA_VERSION, static_cast<uint32_t>(sections.size()), 0, timestamp};
+    writer.Write(header.magic);
+    writer.Write(header.version);
+    writer.Write(header.sectionCount);
+    writer.Write(header.flags);
+    writer.Write(header.timestamp);
+
+    uint64_t offset = HEADER_SIZE + ENTRY_SIZE * sections.size();
+
+    size_t jobIndex = 0;
+    std::vector<SectionEntry> entries(sections.size());
+    for (size_t s = 0; s < sections.size(); ++s) {
+        SectionEntry& entry = entries[s];
+        entry.id = sections[s].id;
+        entry.rawSize = sections[s].data.size();
+        entry.blockCount = 0;
+        entry.offset = offset;
+        entry.size = 0;
+        for (size_t j = jobIndex; j < jobs.size() && jobs[j].section == s; ++j) {
+            entry.blockCount++;
+            entry.size += sizeof(BlockEntry) + jobs[j].stored.size();
+        }
+        entry.checksum = checksums[s];
+        entry.reserved = 0;
+        offset += entry.size;
+        jobIndex += entry.blockCount;
+
+        writer.Write(entry.id);
+        writer.Write(entry.blockCount);
+        writer.Write(entry.rawSize);
+        writer.Write(entry.offset);
+        writer.Write(entry.size);
+        writer.Write(entry.checksum);
+        writer.Write(entry.reserved);
+    }
+
+    writer.Reserve(offset - out.size());
+    jobIndex = 0;
+    for (size_t s = 0; s < sections.size(); ++s) {
+        size_t first = jobIndex;
+        for (uint32_t b = 0; b < entries[s].blockCount; ++b) {
+            const BlockJob& job = jobs[first + b];
+            writer.Write(job.rawSize);
+            writer.Write(static_cast<uint32_t>(job.stored.size()));
+        }
+        for (uint32_t b = 0; b < entries[s].blockCount; ++b) {
+            const BlockJob& job = jobs[first + b];
+            writer.WriteBytes(job.stored.data(), job.stored.size());
+        }
+        jobIndex += entries[s].blockCount;
+    }
+
+    stats.rawBytes = 0;
+    for (const auto& section : sections) stats.rawBytes += section.data.size();
+    stats.fileBytes = out.size();
+    return true;
+}
+
+bool SnapshotFile::Decode(const uint8_t* data, size_t size) {
+    auto start = std::chrono::steady_clock::now();
+    sections.clear();
+
+    ByteReader reader(data, size);
+    SnapshotHeader header{};
+    reader.Read(header.magic);
+    reader.Read(header.version);
+    reader.Read(header.sectionCount);
+    reader.Read(header.flags);
+    reader.Read(header.timestamp);
+    if (!reader.IsOk() || header.magic != MAGIC) {
+        Logger::Error("Снапшот: неверная сигнатура");
+        return false;
+    }
+    if (header.version > SCHEMA_VERSION) {
+        Logger::Error("Снапшот: версия схемы ", header.version, " новее поддерживаемой ", SCHEMA_VERSION);
+        return false;
+    }
+    schemaVersion = header.version;
+    timestamp = header.timestamp;
+
+    if (header.sectionCount > MAX_SECTIONS || header.sectionCount > (size - HEADER_SIZE) / ENTRY_SIZE) {
+        Logger::Error("Снапшот: неверное число секций ", header.sectionCount);
+        return false;
+    }
+    std::vector<SectionEntry> entries(header.sectionCount);
+    for (auto& entry : entries) {
+        reader.Read(entry.id);
+        reader.Read(entry.blockCount);
+        reader.Read(entry.rawSize);
+        reader.Read(entry.offset);
+        reader.Read(entry.size);
+        reader.Read(entry.checksum);
+        reader.Read(entry.reserved);
+        if (!reader.IsOk() || entry.offset > size || entry.size > size - entry.offset ||
+            entry.blockCount > entry.size / sizeof(BlockEntry) || entry.rawSize > MAX_SECTION_BYTES ||
+            entry.rawSize > uint64_t(entry.blockCount) * BLOCK_SIZE) {
+            Logger::Error("Снапшот: повреждена таблица секций");
+            return false;
+        }
+    }
+
+    std::vector<BlockJob> jobs;
+    sections.resize(entries.size());
+    for (size_t s = 0; s < entries.size(); ++s) {
+        const SectionEntry& entry = entries[s];
+        sections[s].id = entry.id;
+
+        ByteReader blocks(data + entry.offset, entry.size);
+        uint64_t storedOffset = entry.offset + uint64_t(entry.blockCount) * sizeof(BlockEntry);
+        uint64_t rawOffset = 0;
+        for (uint32_t b = 0; b < entry.blockCount; ++b) {
+            BlockJob job;
+            job.section = s;
+            job.rawOffset = rawOffset;
+            blocks.Read(job.rawSize);
+            blocks.Read(job.storedSize);
+            job.storedData = data + storedOffset;
+            storedOffset += job.storedSize;
+            rawOffset += job.rawSize;
+            // Блок не больше BLOCK_SIZE и не меньше сжатого (несжимаемые хранятся как есть)
+            if (!blocks.IsOk() || job.rawSize > BLOCK_SIZE || job.storedSize > job.rawSize ||
+                storedOffset > entry.offset + entry.size || rawOffset > entry.rawSize) {
+                Logger::Error("Снапшот: повреждена таблица блоков секции ", entry.id);
+                return false;
+            }
+            jobs.push_back(std::move(job));
+        }
+        if (rawOffset != entry.rawSize) {
+            Logger::Error("Снапшот: секция ", entry.id, " неполная");
+            return false;
+        }
+        // Размер уже сверен с таблицей блоков, которая целиком лежит в файле
+        sections[s].data.resize(entry.rawSize);
+    }
+
+    ThreadPool::Global().ParallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            BlockJob& job = jobs[i];
+            uint8_t* raw = sections[job.section].data.data() + job.rawOffset;
+            if (job.storedSize == job.rawSize) {
+                if (job.rawSize) std::memcpy(raw, job.storedData, job.rawSize);
+            } else {
+                job.ok = BlockCompressor::Decompress(job.storedData, job.storedSize, raw, job.rawSize);
+            }
+        }
+    });
+
+    for (const auto& job : jobs) {
+        if (!job.ok) {
+            Logger::Error("Снапшот: не удалось распаковать блок секции ", sections[job.section].id);
+            return false;
+        }
+    }
+    std::vector<char> valid(sections.size(), 0);
+    ThreadPool::Global().ParallelFor(sections.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+            const auto& raw = sections[s].data;
+            valid[s] = Checksum(raw.data(), raw.size()) == entries[s].checksum;
+        }
+    });
+    for (size_t s = 0; s < sections.size(); ++s) {
+        if (!valid[s]) {
+            Logger::Error("Снапшот: контрольная сумма секции ", entries[s].id, " не совпадает");
+            return false;
+        }
+    }
+
+    stats.rawBytes = 0;
+    for (const auto& section : sections) stats.rawBytes += section.data.size();
+    stats.fileBytes = size;
+    stats.compressMs = MsSince(start);
+    return true;
+}
+
+bool SnapshotFile::WriteToFile(const std::string& filename) {
+    std::vector<uint8_t> bytes;
+    if (!Encode(bytes)) {
+        Logger::Log("Запись снапшота отменена: ", filename);
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::string tempName = filename + ".tmp";
+    std::FILE* file = std::fopen(tempName.c_str(), "wb");
+    if (!file) {
+        Logger::Error("Не удалось открыть файл снапшота: ", tempName);
+        return false;
+    }
+    bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    written = SyncToDisk(file) && written;
+    written = std::fclose(file) == 0 && written;
+
+    std::error_code ec;
+    if (!written || IsCancelled()) {
+        if (!written) Logger::Error("Ошибка записи снапшота: ", tempName);
+        std::filesystem::remove(tempName, ec);
+        return false;
+    }
+    // rename заменяет существующий файл (на Windows - MoveFileEx с заменой)
+    std::filesystem::rename(tempName, filename, ec);
+    if (ec) {
+        Logger::Error("Не удалось переименовать ", tempName, " в ", filename, ": ", ec.message());
+        std::filesystem::remove(tempName, ec);
+        return false;
+    }
+    stats.ioMs = MsSince(start);
+    return true;
+}
+
+bool SnapshotFile::ReadFromFile(const std::string& filename) {
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        Logger::Error("Не удалось открыть файл снапшота: ", filename);
+        return false;
+    }
+    std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        Logger::Error("Ошибка чтения снапшота: ", filename);
+        return false;
+    }
+    double ioMs = MsSince(start);
+
+    bool ok = Decode(bytes.data(), bytes.size());
+    stats.ioMs = ioMs;
+    return ok;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <atomic>
+
+// Контейнер двоичного снапшота: заголовок с версией схемы и таблица секций.
+// Каждая секция режется на блоки, блоки сжимаются и распаковываются параллельно.
+//
+//   SnapshotHeader
+//   SectionEntry[sectionCount]
+//   данные секций: BlockEntry[blockCount], затем блоки подряд
+class SnapshotFile {
+public:
+    static constexpr uint32_t MAGIC = 0x53475452;       // "RTGS"
+    static constexpr uint32_t SCHEMA_VERSION = 1;
+    static constexpr uint32_t BLOCK_SIZE = 256 * 1024;
+    // Пределы при чтении: повреждённый файл не должен заказывать гигантские выделения
+    static constexpr uint32_t MAX_SECTIONS = 4096;
+    static constexpr uint64_t MAX_SECTION_BYTES = 1ull << 30;
+
+    struct Section {
+        uint32_t id = 0;
+        std::vector<uint8_t> data;
+    };
+
+    struct Stats {
+        uint64_t rawBytes = 0;
+        uint64_t fileBytes = 0;
+        double compressMs = 0.0; // сжатие при записи или распаковка при чтении
+        double ioMs = 0.0;
+    };
+
+    // Секции с одинаковым id не допускаются
+    std::vector<uint8_t>& AddSection(uint32_t id);
+    const std::vector<uint8_t>* FindSection(uint32_t id) const;
+    std::vector<Section>& GetSections() { return sections; }
+    const std::vector<Section>& GetSections() const { return sections; }
+    uint32_t GetSchemaVersion() const { return schemaVersion; }
+    uint64_t GetTimestamp() const { return timestamp; }
+    const Stats& GetStats() const { return stats; }
+
+    // Пишет во временный файл рядом и атомарно переименовывает: прежний файл
+    // остаётся целым при сбое, отмене или падении посреди записи
+    bool WriteToFile(const std::string& filename);
+    // Файлы новее SCHEMA_VERSION не читаются; старые версии читает вызывающий по GetSchemaVersion()
+    bool ReadFromFile(const std::string& filename);
+
+    // Флаг проверяется между блоками сжатия и перед переименованием
+    void SetCancelFlag(const std::atomic<bool>* flag) { cancelFlag = flag; }
+    bool IsCancelled() const { return cancelFlag && cancelFlag->load(std::memory_order_relaxed); }
+
+    // То же в памяти (для сети и журнала); false только при отмене
+    bool Encode(std::vector<uint8_t>& out);
+    bool Decode(const uint8_t* data, size_t size);
+
+private:
+    std::vector<Section> sections;
+    uint32_t schemaVersion = SCHEMA_VERSION;
+    uint64_t timestamp = 0;
+    Stats stats;
+    const std::atomic<bool>* cancelFlag = nullptr;
+};
@@ -0,0 +1,156 @@
+#include "SnapshotJournal.hpp"
+#include "SnapshotSystem.hpp"
+#include "SnapshotFile.hpp"
+#include "BinaryStream.hpp"
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+
+namespace {
+    constexpr uint32_t JOURNAL_MAGIC = 0x4A475452; // "RTGJ"
+
+    struct JournalRecordHeader {
+        uint32_t magic;
+        uint32_t sequence;
+        uint64_t checkpointId;
+        uint32_t payloadSize;
+    };
+    constexpr size_t RECORD_HEADER_SIZE = 20;
+
+    uint64_t NewCheckpointId(uint64_t previous) {
+        // Время + счётчик: журнал от старой точки не подойдёт к новой даже после перезапуска
+        uint64_t now = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+        return (now << 8) ^ (previous + 1);
+    }
+
+    bool ReadCheckpointId(const SnapshotFile& file, uint64_t& id) {
+        const auto* section = file.FindSection(SnapshotSystem::SECTION_CHECKPOINT);
+        if (!section) return false;
+        ByteReader reader(*section);
+        return reader.Read(id);
+    }
+}
+
+SnapshotJournal::SnapshotJournal(const std::string& filename) {
+    SetFile(filename);
+}
+
+void SnapshotJournal::SetFile(const std::string& filename) {
+    checkpointFile = filename;
+    journalFile = filename + ".journal";
+    needCheckpoint = true;
+}
+
+bool SnapshotJournal::Write(const SnapshotState& current, const SnapshotState* base, const std::atomic<bool>* cancel) {
+    bool checkpoint = needCheckpoint || !base || deltaCount >= checkpointInterval || journalBytes > checkpointBytes;
+    return checkpoint ? WriteCheckpoint(current, cancel) : AppendDelta(*base, current, cancel);
+}
+
+bool SnapshotJournal::WriteCheckpoint(const SnapshotState& current, const std::atomic<bool>* cancel) {
+    uint64_t id = NewCheckpointId(checkpointId);
+
+    SnapshotFile file;
+    file.SetCancelFlag(cancel);
+    SnapshotSystem::Serialize(current, file);
+    ByteWriter(file.AddSection(SnapshotSystem::SECTION_CHECKPOINT)).Write(id);
+    if (!file.WriteToFile(checkpointFile)) return false;
+
+    // Точка уже на месте; старый журнал с прежним id при сбое здесь просто игнорируется
+    std::error_code ec;
+    std::filesystem::remove(journalFile, ec);
+
+    checkpointId = id;
+    checkpointBytes = file.GetStats().fileBytes;
+    journalBytes = 0;
+    deltaCount = 0;
+    lastWriteBytes = checkpointBytes;
+    needCheckpoint = false;
+    Logger::Log("Контрольная точка сохранена: ", checkpointFile, " (", checkpointBytes, " байт)");
+    return true;
+}
+
+bool SnapshotJournal::AppendDelta(const SnapshotState& base, const SnapshotState& current, const std::atomic<bool>* cancel) {
+    SnapshotFile delta;
+    delta.SetCancelFlag(cancel);
+    SnapshotSystem::SerializeDelta(base, current, delta);
+
+    std::vector<uint8_t> payload;
+    if (!delta.Encode(payload)) return false;
+
+    std::vector<uint8_t> record;
+    ByteWriter writer(record);
+    writer.Write(JOURNAL_MAGIC);
+    writer.Write(deltaCount);
+    writer.Write(checkpointId);
+    writer.Write(static_cast<uint32_t>(payload.size()));
+    writer.WriteBytes(payload.data(), payload.size());
+
+    std::ofstream file(journalFile, std::ios::binary | std::ios::app);
+    if (file.is_open()) {
+        file.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+        file.flush();
+    }
+    if (!file.is_open() || !file) {
+        // Хвост журнала мог остаться оборванным - дальше пишем только с новой точки
+        Logger::Error("Ошибка записи журнала снапшотов: ", journalFile);
+        needCheckpoint = true;
+        return false;
+    }
+
+    deltaCount++;
+    journalBytes += record.size();
+    lastWriteBytes = record.size();
+    LOG_DEBUG(Core, "Дельта #", deltaCount, " дописана в журнал: ", record.size(), " байт");
+    return true;
+}
+
+bool SnapshotJournal::Load(const std::string& filename, SnapshotState& out, uint32_t* deltasApplied) {
+    if (deltasApplied) *deltasApplied = 0;
+
+    SnapshotFile checkpoint;
+    if (!checkpoint.ReadFromFile(filename)) return false;
+    if (!SnapshotSystem::Deserialize(checkpoint, out)) return false;
+
+    uint64_t id = 0;
+    if (!ReadCheckpointId(checkpoint, id)) return true; // обычный снапшот
+
+    std::ifstream journal(filename + ".journal", std::ios::binary | std::ios::ate);
+    if (!journal.is_open()) return true;
+    std::vector<uint8_t> bytes(static_cast<size_t>(journal.tellg()));
+    journal.seekg(0);
+    journal.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!journal) return true;
+
+    ByteReader reader(bytes);
+    uint32_t expected = 0;
+    while (reader.GetRemaining() >= RECORD_HEADER_SIZE) {
+        JournalRecordHeader header{};
+        reader.Read(header.magic);
+        reader.Read(header.sequence);
+        reader.Read(header.checkpointId);
+        reader.Read(header.payloadSize);
+        if (header.magic != JOURNAL_MAGIC || header.checkpointId != id || header.sequence != expected ||
+            header.payloadSize > reader.GetRemaining()) {
+            // Чужой или оборванный хвост: всё, что после, не применяем
+            Logger::Warning("Журнал снапшотов: запись ", expected, " повреждена или от другой точки, остановка");
+            break;
+        }
+
+        size_t offset = bytes.size() - reader.GetRemaining();
+        SnapshotFile delta;
+        if (!delta.Decode(bytes.data() + offset, header.payloadSize)) {
+            Logger::Warning("Журнал снапшотов: запись ", expected, " не читается, остановка");
+            break;
+        }
+        // Контрольные суммы сошлись, а применить нельзя - состояние уже частично изменено
+        if (!SnapshotSystem::ApplyDelta(delta, out)) {
+            Logger::Error("Журнал снапшотов: запись ", expected, " не применяется");
+            return false;
+        }
+        reader.Skip(header.payloadSize);
+        expected++;
+    }
+
+    if (deltasApplied) *deltasApplied = expected;
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+struct SnapshotState;
+
+// Сохранение контрольной точкой и журналом дельт:
+//   <file>          - полный снапшот с секцией SECTION_CHECKPOINT (id точки)
+//   <file>.journal  - записи [заголовок][SnapshotFile с секциями дельты]
+// Каждое сохранение дописывает в журнал дельту к прошлому; каждые checkpointInterval
+// дельт (или когда журнал перерос точку) пишется новая сжатая контрольная точка.
+// Загрузка: точка + все целые записи журнала с её id, по порядку.
+class SnapshotJournal {
+    std::string checkpointFile;
+    std::string journalFile;
+    uint64_t checkpointId = 0;
+    uint32_t deltaCount = 0;
+    uint32_t checkpointInterval = 12;
+    uint64_t checkpointBytes = 0;
+    uint64_t journalBytes = 0;
+    uint64_t lastWriteBytes = 0;
+    bool needCheckpoint = true;
+
+    bool WriteCheckpoint(const SnapshotState& current, const std::atomic<bool>* cancel);
+    bool AppendDelta(const SnapshotState& base, const SnapshotState& current, const std::atomic<bool>* cancel);
+
+public:
+    explicit SnapshotJournal(const std::string& filename = "save/autosave.dat");
+
+    void SetFile(const std::string& filename);
+    void SetCheckpointInterval(uint32_t deltas) { checkpointInterval = deltas; }
+    // Следующая запись будет контрольной точкой (например, после загрузки)
+    void ForceCheckpoint() { needCheckpoint = true; }
+
+    // base - состояние, записанное прошлым успешным вызовом; nullptr - нет такого
+    bool Write(const SnapshotState& current, const SnapshotState* base, const std::atomic<bool>* cancel = nullptr);
+
+    uint64_t GetLastWriteBytes() const { return lastWriteBytes; }
+    uint32_t GetDeltaCount() const { return deltaCount; }
+
+    // Читает точку и применяет журнал; обычный снапшот без журнала тоже подходит
+    static bool Load(const std::string& filename, SnapshotState& out, uint32_t* deltasApplied = nullptr);
+};
@@ -1,36 +1,815 @@
 #include "SnapshotSystem.hpp"
-#include <fstream>
-#include <thread>
-#include <mutex>
+#include "SnapshotFile.hpp"
+#include "SnapshotJournal.hpp"
+#include "BinaryStream.hpp"
+#include "ThreadPool.hpp"
+#include "../physics/PhysXInitializer.hpp"
+#include "../physics/PhysicsUpdateSystem.hpp"
 #include <chrono>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
 
 std::mutex SnapshotSystem::saveMutex;
 
-void SnapshotSystem::SaveToFile(const GameLevel& level, const WeatherSystem& weather, const std::string& filename) {
-    std::lock_guard<std::mutex> lock(saveMutex);
-    std::ofstream file(filename);
-    if (file.is_open()) {
-        file << "Snapshot saved at: " << std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count() << "\n";
-        file << "Weather: " << weather.timeOfDay << "h\n";
-        file << "Entities: " << level.ecs.registry.size() << "\n";
-        LOG(L"Снапшот сохранён: " + std::wstring(filename.begin(), filename.end()));
-    } else {
-        ERROR(L"Не удалось сохранить снапшот: " + std::wstring(filename.begin(), filename.end()));
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double MsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    uint32_t ToId(entt::entity e) { return static_cast<uint32_t>(entt::to_integral(e)); }
+    entt::entity FromId(uint32_t id) { return static_cast<entt::entity>(id); }
+
+    void WriteVec3(ByteWriter& w, float x, float y, float z) {
+        w.Write(x);
+        w.Write(y);
+        w.Write(z);
+    }
+
+    void WriteInventory(ByteWriter& w, const Inventory& inventory) {
+        for (const auto& slot : inventory.slots) {
+            w.Write(static_cast<uint8_t>(slot.type));
+            w.Write(static_cast<int32_t>(slot.count));
+        }
+    }
+
+    void ReadInventory(ByteReader& r, Inventory& inventory) {
+        for (auto& slot : inventory.slots) {
+            slot.type = static_cast<ItemType>(r.Read<uint8_t>());
+            slot.count = r.Read<int32_t>();
+        }
     }
+
+    void WriteTransform(ByteWriter& w, const TransformComponent& t) {
+        WriteVec3(w, t.position.x, t.position.y, t.position.z);
+        w.Write(t.rotation.x);
+        w.Write(t.rotation.y);
+        w.Write(t.rotation.z);
+        w.Write(t.rotation.w);
+        WriteVec3(w, t.scale.x, t.scale.y, t.scale.z);
+    }
+
+    void ReadTransform(ByteReader& r, TransformComponent& t) {
+        r.Read(t.position.x); r.Read(t.position.y); r.Read(t.position.z);
+        r.Read(t.rotation.x); r.Read(t.rotation.y); r.Read(t.rotation.z); r.Read(t.rotation.w);
+        r.Read(t.scale.x); r.Read(t.scale.y); r.Read(t.scale.z);
+    }
+
+    void WriteCharacter(ByteWriter& w, const CharacterComponent& c) {
+        w.Write(c.health);
+        w.Write(static_cast<uint8_t>(c.isAlive));
+        w.Write(c.respawnTimer);
+        w.Write(static_cast<uint8_t>(c.shouldRespawn));
+        w.Write(static_cast<uint8_t>(c.inVehicle));
+        w.Write(ToId(c.currentVehicle));
+        WriteInventory(w, c.inventory);
+    }
+
+    void ReadCharacter(ByteReader& r, CharacterComponent& c) {
+        r.Read(c.health);
+        c.isAlive = r.Read<uint8_t>() != 0;
+        r.Read(c.respawnTimer);
+        c.shouldRespawn = r.Read<uint8_t>() != 0;
+        c.inVehicle = r.Read<uint8_t>() != 0;
+        c.currentVehicle = FromId(r.Read<uint32_t>());
+        ReadInventory(r, c.inventory);
+    }
+
+    void WriteInventoryComponent(ByteWriter& w, const InventoryComponent& c) { WriteInventory(w, c.inventory); }
+    void ReadInventoryComponent(ByteReader& r, InventoryComponent& c) { ReadInventory(r, c.inventory); }
+
+    void WriteBuilding(ByteWriter& w, const BuildingComponent& b) {
+        WriteVec3(w, b.position.x, b.position.y, b.position.z);
+        w.WriteString(b.type);
+        w.Write(b.owner);
+    }
+
+    void ReadBuilding(ByteReader& r, BuildingComponent& b) {
+        r.Read(b.position.x); r.Read(b.position.y); r.Read(b.position.z);
+        r.ReadString(b.type);
+        r.Read(b.owner);
+    }
+
+    void WriteVehicleLink(ByteWriter& w, const SnapshotState::VehicleLink& v) {
+        w.Write(v.vehicle);
+        w.Write(static_cast<uint8_t>(v.isLocal));
+        w.Write(v.playerId);
+    }
+
+    void ReadVehicleLink(ByteReader& r, SnapshotState::VehicleLink& v) {
+        r.Read(v.vehicle);
+        v.isLocal = r.Read<uint8_t>() != 0;
+        r.Read(v.playerId);
+    }
+
+    void WriteBuildable(ByteWriter& w, const Buildable& b) {
+        WriteVec3(w, b.position.x, b.position.y, b.position.z);
+        w.WriteString(b.type);
+        w.Write(b.owner);
+    }
+
+    void ReadBuildable(ByteReader& r, Buildable& b) {
+        r.Read(b.position.x); r.Read(b.position.y); r.Read(b.position.z);
+        r.ReadString(b.type);
+        r.Read(b.owner);
+    }
+
+    bool ReadBuildables(ByteReader& r, std::vector<Buildable>& out) {
+        uint32_t count = r.Read<uint32_t>();
+        if (count > r.GetRemaining()) return false;
+        out.resize(count);
+        for (auto& b : out) ReadBuildable(r, b);
+        return r.IsOk();
+    }
+
+    // Сравнение записей для дельты (побитно по полям, как они попадут в файл)
+    bool SameInventory(const Inventory& a, const Inventory& b) {
+        for (size_t i = 0; i < a.slots.size(); ++i) {
+            if (a.slots[i].type != b.slots[i].type || a.slots[i].count != b.slots[i].count) return false;
+        }
+        return true;
+    }
+
+    bool Same(const TransformComponent& a, const TransformComponent& b) {
+        return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+               a.rotation.x == b.rotation.x && a.rotation.y == b.rotation.y && a.rotation.z == b.rotation.z &&
+               a.rotation.w == b.rotation.w &&
+               a.scale.x == b.scale.x && a.scale.y == b.scale.y && a.scale.z == b.scale.z;
+    }
+
+    bool Same(const CharacterComponent& a, const CharacterComponent& b) {
+        return a.health == b.health && a.isAlive == b.isAlive && a.respawnTimer == b.respawnTimer &&
+               a.shouldRespawn == b.shouldRespawn && a.inVehicle == b.inVehicle &&
+               a.currentVehicle == b.currentVehicle && SameInventory(a.inventory, b.inventory);
+    }
+
+    bool Same(const InventoryComponent& a, const InventoryComponent& b) { return SameInventory(a.inventory, b.inventory); }
+
+    bool Same(const BuildingComponent& a, const BuildingComponent& b) {
+        return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+               a.owner == b.owner && a.type == b.type;
+    }
+
+    bool Same(const Buildable& a, const Buildable& b) {
+        return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+               a.owner == b.owner && a.type == b.type;
+    }
+
+    bool Same(const SnapshotState::VehicleLink& a, const SnapshotState::VehicleLink& b) {
+        return a.vehicle == b.vehicle && a.isLocal == b.isLocal && a.playerId == b.playerId;
+    }
+
+    // Плоская копия пула: один проход по view без обращений к другим пулам
+    template<typename T>
+    void CaptureComponents(const entt::registry& registry, std::vector<std::pair<uint32_t, T>>& out) {
+        auto view = registry.view<const T>();
+        out.clear();
+        out.reserve(view.size());
+        for (auto entity : view) {
+            out.emplace_back(ToId(entity), view.template get<const T>(entity));
+        }
+    }
+
+    // Секция компонента: число записей, затем [сущность, поля] для каждой
+    template<typename T, typename WriteFn>
+    void WriteComponents(ByteWriter& w, const std::vector<std::pair<uint32_t, T>>& items, WriteFn writeOne) {
+        w.Write(static_cast<uint32_t>(items.size()));
+        for (const auto& item : items) {
+            w.Write(item.first);
+            writeOne(w, item.second);
+        }
+    }
+
+    template<typename T, typename ReadFn>
+    bool ReadComponents(ByteReader& r, std::vector<std::pair<uint32_t, T>>& out, ReadFn readOne) {
+        uint32_t count = r.Read<uint32_t>();
+        if (count > r.GetRemaining() / sizeof(uint32_t)) return false;
+        out.resize(count);
+        for (auto& item : out) {
+            r.Read(item.first);
+            readOne(r, item.second);
+        }
+        return r.IsOk();
+    }
+
+    void WriteIds(ByteWriter& w, const std::vector<uint32_t>& ids) {
+        w.Write(static_cast<uint32_t>(ids.size()));
+        w.WriteBytes(ids.data(), ids.size() * sizeof(uint32_t));
+    }
+
+    bool ReadIds(ByteReader& r, std::vector<uint32_t>& ids) {
+        uint32_t count = r.Read<uint32_t>();
+        if (count > r.GetRemaining() / sizeof(uint32_t)) return false;
+        ids.resize(count);
+        return r.ReadBytes(ids.data(), count * sizeof(uint32_t));
+    }
+
+    // Пулы entt обычно сохраняют порядок между кадрами: сравниваем по индексу,
+    // а к поиску по id переходим только на первом расхождении
+    template<typename T>
+    void DiffComponents(const std::vector<std::pair<uint32_t, T>>& base, const std::vector<std::pair<uint32_t, T>>& current,
+                        std::vector<const std::pair<uint32_t, T>*>& changed, std::vector<uint32_t>& removed) {
+        std::unordered_map<uint32_t, size_t> baseIndex;
+        std::vector<char> seen;
+        bool aligned = base.size() == current.size();
+
+        for (size_t i = 0; i < current.size(); ++i) {
+            const auto& item = current[i];
+            if (aligned && base[i].first == item.first) {
+                if (!Same(base[i].second, item.second)) changed.push_back(&item);
+                continue;
+            }
+            if (baseIndex.empty() && !base.empty()) {
+                baseIndex.reserve(base.size());
+                for (size_t j = 0; j < base.size(); ++j) baseIndex.emplace(base[j].first, j);
+                seen.assign(base.size(), 0);
+                // Уже пройденный выровненный префикс
+                for (size_t j = 0; j < i && j < base.size(); ++j) seen[j] = 1;
+            }
+            aligned = false;
+            auto it = baseIndex.find(item.first);
+            if (it == baseIndex.end()) {
+                changed.push_back(&item);
+            } else {
+                seen[it->second] = 1;
+                if (!Same(base[it->second].second, item.second)) changed.push_back(&item);
+            }
+        }
+
+        if (aligned) return;
+        if (seen.empty()) seen.assign(base.size(), 0); // current пуст
+        for (size_t j = 0; j < base.size(); ++j) {
+            if (!seen[j]) removed.push_back(base[j].first);
+        }
+    }
+
+    // Секция дельты компонента: изменённые записи в формате полной секции, затем удалённые id
+    template<typename T, typename WriteFn>
+    void WriteComponentDelta(ByteWriter& w, const std::vector<std::pair<uint32_t, T>>& base,
+                             const std::vector<std::pair<uint32_t, T>>& current, WriteFn writeOne) {
+        std::vector<const std::pair<uint32_t, T>*> changed;
+        std::vector<uint32_t> removed;
+        DiffComponents(base, current, changed, removed);
+        w.Write(static_cast<uint32_t>(changed.size()));
+        for (const auto* item : changed) {
+            w.Write(item->first);
+            writeOne(w, item->second);
+        }
+        WriteIds(w, removed);
+    }
+
+    template<typename T, typename ReadFn>
+    bool ApplyComponentDelta(ByteReader& r, std::vector<std::pair<uint32_t, T>>& state, ReadFn readOne) {
+        std::vector<std::pair<uint32_t, T>> changed;
+        std::vector<uint32_t> removed;
+        if (!ReadComponents(r, changed, readOne) || !ReadIds(r, removed)) return false;
+        if (changed.empty() && removed.empty()) return true;
+
+        std::unordered_map<uint32_t, size_t> index;
+        index.reserve(state.size());
+        for (size_t i = 0; i < state.size(); ++i) index.emplace(state[i].first, i);
+
+        for (auto& item : changed) {
+            auto it = index.find(item.first);
+            if (it != index.end()) {
+                state[it->second].second = std::move(item.second);
+            } else {
+                index.emplace(item.first, state.size());
+                state.push_back(std::move(item));
+            }
+        }
+        if (!removed.empty()) {
+            std::unordered_map<uint32_t, char> drop;
+            for (uint32_t id : removed) drop.emplace(id, 1);
+            state.erase(std::remove_if(state.begin(), state.end(),
+                [&](const std::pair<uint32_t, T>& item) { return drop.count(item.first) != 0; }), state.end());
+        }
+        return true;
+    }
+
+    template<typename T>
+    void ApplyComponents(entt::registry& registry, const std::vector<std::pair<uint32_t, T>>& items) {
+        for (const auto& item : items) {
+            entt::entity entity = FromId(item.first);
+            if (registry.valid(entity)) registry.emplace_or_replace<T>(entity, item.second);
+        }
+    }
+
+    const uint32_t SECTION_ORDER[] = {
+        SnapshotSystem::SECTION_LEVEL,
+        SnapshotSystem::SECTION_ENTITIES,
+        SnapshotSystem::SECTION_TRANSFORMS,
+        SnapshotSystem::SECTION_CHARACTERS,
+        SnapshotSystem::SECTION_INVENTORIES,
+        SnapshotSystem::SECTION_BUILDING_COMPONENTS,
+        SnapshotSystem::SECTION_VEHICLE_COMPONENTS,
+        SnapshotSystem::SECTION_VEHICLES,
+        SnapshotSystem::SECTION_BUILDINGS,
+        SnapshotSystem::SECTION_WEATHER,
+        SnapshotSystem::SECTION_ORIGIN
+    };
+
+    void WriteSection(uint32_t id, ByteWriter& w, const SnapshotState& s) {
+        switch (id) {
+        case SnapshotSystem::SECTION_LEVEL:
+            w.Write(s.player);
+            w.Write(s.playerCharacter);
+            w.Write(s.vehicle);
+            break;
+
+        case SnapshotSystem::SECTION_ENTITIES:
+            WriteIds(w, s.entities);
+            break;
+
+        case SnapshotSystem::SECTION_TRANSFORMS:
+            w.Reserve(s.transforms.size() * 44);
+            WriteComponents(w, s.transforms, WriteTransform);
+            break;
+
+        case SnapshotSystem::SECTION_CHARACTERS:
+            WriteComponents(w, s.characters, WriteCharacter);
+            break;
+
+        case SnapshotSystem::SECTION_INVENTORIES:
+            WriteComponents(w, s.inventories, WriteInventoryComponent);
+            break;
+
+        case SnapshotSystem::SECTION_BUILDING_COMPONENTS:
+            WriteComponents(w, s.buildingComponents, WriteBuilding);
+            break;
+
+        case SnapshotSystem::SECTION_VEHICLE_COMPONENTS:
+            WriteComponents(w, s.vehicleComponents, WriteVehicleLink);
+            break;
+
+        case SnapshotSystem::SECTION_VEHICLES:
+            w.Write(static_cast<uint32_t>(s.vehicles.size()));
+            for (const auto& v : s.vehicles) {
+                w.WriteString(v.typeName);
+                w.Write(static_cast<uint8_t>(v.hasActor));
+                if (v.hasActor) {
+                    WriteVec3(w, v.pose.p.x, v.pose.p.y, v.pose.p.z);
+                    w.Write(v.pose.q.x);
+                    w.Write(v.pose.q.y);
+                    w.Write(v.pose.q.z);
+                    w.Write(v.pose.q.w);
+                    WriteVec3(w, v.linearVelocity.x, v.linearVelocity.y, v.linearVelocity.z);
+                    WriteVec3(w, v.angularVelocity.x, v.angularVelocity.y, v.angularVelocity.z);
+                }
+                w.Write(v.throttle);
+                w.Write(v.brake);
+                w.Write(v.steer);
+                w.Write(static_cast<uint8_t>(v.engineOn));
+                w.Write(v.rotorRPM);
+            }
+            break;
+
+        case SnapshotSystem::SECTION_BUILDINGS:
+            w.Write(static_cast<uint32_t>(s.buildings.size()));
+            for (const auto& b : s.buildings) WriteBuildable(w, b);
+            break;
+
+        case SnapshotSystem::SECTION_WEATHER:
+            w.Write(s.weather.time);
+            w.Write(s.weather.timeOfDay);
+            w.Write(s.weather.windSpeed);
+            w.Write(s.weather.windDirection);
+            w.Write(s.weather.rainIntensity);
+            break;
+
+        case SnapshotSystem::SECTION_ORIGIN:
+            w.Write(s.origin.x);
+            w.Write(s.origin.y);
+            w.Write(s.origin.z);
+            break;
+        }
+    }
+
+    bool ReadSection(uint32_t id, ByteReader& r, SnapshotState& out);
+
+    const uint32_t DELTA_SECTION_ORDER[] = {
+        SnapshotSystem::SECTION_LEVEL,
+        SnapshotSystem::SECTION_DELTA_ENTITIES,
+        SnapshotSystem::SECTION_DELTA_TRANSFORMS,
+        SnapshotSystem::SECTION_DELTA_CHARACTERS,
+        SnapshotSystem::SECTION_DELTA_INVENTORIES,
+        SnapshotSystem::SECTION_DELTA_BUILDING_COMPONENTS,
+        SnapshotSystem::SECTION_DELTA_VEHICLE_COMPONENTS,
+        SnapshotSystem::SECTION_VEHICLES,
+        SnapshotSystem::SECTION_DELTA_BUILDINGS,
+        SnapshotSystem::SECTION_WEATHER,
+        SnapshotSystem::SECTION_ORIGIN
+    };
+
+    void WriteDeltaSection(uint32_t id, ByteWriter& w, const SnapshotState& base, const SnapshotState& s) {
+        switch (id) {
+        case SnapshotSystem::SECTION_DELTA_ENTITIES: {
+            std::vector<uint32_t> added;
+            std::vector<uint32_t> removed;
+            if (base.entities != s.entities) {
+                std::unordered_map<uint32_t, char> before;
+                before.reserve(base.entities.size());
+                for (uint32_t e : base.entities) before.emplace(e, 0);
+                for (uint32_t e : s.entities) {
+                    auto it = before.find(e);
+                    if (it == before.end()) added.push_back(e);
+                    else it->second = 1;
+                }
+                for (uint32_t e : base.entities) {
+                    if (before[e] == 0) removed.push_back(e);
+                }
+            }
+            WriteIds(w, added);
+            WriteIds(w, removed);
+            break;
+        }
+
+        case SnapshotSystem::SECTION_DELTA_TRANSFORMS:
+            WriteComponentDelta(w, base.transforms, s.transforms, WriteTransform);
+            break;
+        case SnapshotSystem::SECTION_DELTA_CHARACTERS:
+            WriteComponentDelta(w, base.characters, s.characters, WriteCharacter);
+            break;
+        case SnapshotSystem::SECTION_DELTA_INVENTORIES:
+            WriteComponentDelta(w, base.inventories, s.inventories, WriteInventoryComponent);
+            break;
+        case SnapshotSystem::SECTION_DELTA_BUILDING_COMPONENTS:
+            WriteComponentDelta(w, base.buildingComponents, s.buildingComponents, WriteBuilding);
+            break;
+        case SnapshotSystem::SECTION_DELTA_VEHICLE_COMPONENTS:
+            WriteComponentDelta(w, base.vehicleComponents, s.vehicleComponents, WriteVehicleLink);
+            break;
+
+        case SnapshotSystem::SECTION_DELTA_BUILDINGS: {
+            // Постройки в основном только добавляются: пишем число неизменных с начала и хвост
+            size_t keep = 0;
+            size_t limit = std::min(base.buildings.size(), s.buildings.size());
+            while (keep < limit && Same(base.buildings[keep], s.buildings[keep])) ++keep;
+            w.Write(static_cast<uint32_t>(keep));
+            w.Write(static_cast<uint32_t>(s.buildings.size() - keep));
+            for (size_t i = keep; i < s.buildings.size(); ++i) WriteBuildable(w, s.buildings[i]);
+            break;
+        }
+
+        default:
+            WriteSection(id, w, s);
+            break;
+        }
+    }
+
+    bool ApplyDeltaSection(uint32_t id, ByteReader& r, SnapshotState& state) {
+        switch (id) {
+        case SnapshotSystem::SECTION_DELTA_ENTITIES: {
+            std::vector<uint32_t> added;
+            std::vector<uint32_t> removed;
+            if (!ReadIds(r, added) || !ReadIds(r, removed)) return false;
+            if (!removed.empty()) {
+                std::unordered_map<uint32_t, char> drop;
+                for (uint32_t e : removed) drop.emplace(e, 1);
+                state.entities.erase(std::remove_if(state.entities.begin(), state.entities.end(),
+                    [&](uint32_t e) { return drop.count(e) != 0; }), state.entities.end());
+            }
+            state.entities.insert(state.entities.end(), added.begin(), added.end());
+            return true;
+        }
+
+        case SnapshotSystem::SECTION_DELTA_TRANSFORMS:
+            return ApplyComponentDelta(r, state.transforms, ReadTransform);
+        case SnapshotSystem::SECTION_DELTA_CHARACTERS:
+            return ApplyComponentDelta(r, state.characters, ReadCharacter);
+        case SnapshotSystem::SECTION_DELTA_INVENTORIES:
+            return ApplyComponentDelta(r, state.inventories, ReadInventoryComponent);
+        case SnapshotSystem::SECTION_DELTA_BUILDING_COMPONENTS:
+            return ApplyComponentDelta(r, state.buildingComponents, ReadBuilding);
+        case SnapshotSystem::SECTION_DELTA_VEHICLE_COMPONENTS:
+            return ApplyComponentDelta(r, state.vehicleComponents, ReadVehicleLink);
+
+        case SnapshotSystem::SECTION_DELTA_BUILDINGS: {
+            uint32_t keep = r.Read<uint32_t>();
+            if (!r.IsOk() || keep > state.buildings.size()) return false;
+            uint32_t count = r.Read<uint32_t>();
+            if (count > r.GetRemaining()) return false;
+            state.buildings.resize(keep + count);
+            for (uint32_t i = 0; i < count; ++i) ReadBuildable(r, state.buildings[keep + i]);
+            return r.IsOk();
+        }
+        }
+        return ReadSection(id, r, state);
+    }
+
+    // Каждая секция пишет в свои поля out, поэтому секции разбираются параллельно
+    bool ReadSection(uint32_t id, ByteReader& r, SnapshotState& out) {
+        switch (id) {
+        case SnapshotSystem::SECTION_LEVEL:
+            r.Read(out.player);
+            r.Read(out.playerCharacter);
+            r.Read(out.vehicle);
+            return r.IsOk();
+
+        case SnapshotSystem::SECTION_ENTITIES:
+            return ReadIds(r, out.entities);
+
+        case SnapshotSystem::SECTION_TRANSFORMS:
+            return ReadComponents(r, out.transforms, ReadTransform);
+
+        case SnapshotSystem::SECTION_CHARACTERS:
+            return ReadComponents(r, out.characters, ReadCharacter);
+
+        case SnapshotSystem::SECTION_INVENTORIES:
+            return ReadComponents(r, out.inventories, ReadInventoryComponent);
+
+        case SnapshotSystem::SECTION_BUILDING_COMPONENTS:
+            return ReadComponents(r, out.buildingComponents, ReadBuilding);
+
+        case SnapshotSystem::SECTION_VEHICLE_COMPONENTS:
+            return ReadComponents(r, out.vehicleComponents, ReadVehicleLink);
+
+        case SnapshotSystem::SECTION_VEHICLES: {
+            uint32_t count = r.Read<uint32_t>();
+            if (count > r.GetRemaining()) return false;
+            out.vehicles.resize(count);
+            for (auto& v : out.vehicles) {
+                r.ReadString(v.typeName);
+                v.hasActor = r.Read<uint8_t>() != 0;
+                if (v.hasActor) {
+                    r.Read(v.pose.p.x); r.Read(v.pose.p.y); r.Read(v.pose.p.z);
+                    r.Read(v.pose.q.x); r.Read(v.pose.q.y); r.Read(v.pose.q.z); r.Read(v.pose.q.w);
+                    r.Read(v.linearVelocity.x); r.Read(v.linearVelocity.y); r.Read(v.linearVelocity.z);
+                    r.Read(v.angularVelocity.x); r.Read(v.angularVelocity.y); r.Read(v.angularVelocity.z);
+                }
+                r.Read(v.throttle);
+                r.Read(v.brake);
+                r.Read(v.steer);
+                v.engineOn = r.Read<uint8_t>() != 0;
+                r.Read(v.rotorRPM);
+            }
+            return r.IsOk();
+        }
+
+        case SnapshotSystem::SECTION_BUILDINGS:
+            return ReadBuildables(r, out.buildings);
+
+        case SnapshotSystem::SECTION_WEATHER:
+            r.Read(out.weather.time);
+            r.Read(out.weather.timeOfDay);
+            r.Read(out.weather.windSpeed);
+            r.Read(out.weather.windDirection);
+            r.Read(out.weather.rainIntensity);
+            out.hasWeather = r.IsOk();
+            return r.IsOk();
+
+        case SnapshotSystem::SECTION_ORIGIN:
+            r.Read(out.origin.x);
+            r.Read(out.origin.y);
+            r.Read(out.origin.z);
+            out.hasOrigin = r.IsOk();
+            return r.IsOk();
+        }
+        return true; // неизвестные секции из более новых сборок пропускаем
+    }
+
+    // Существующие машины переиспользуются по типу, недостающие создаются, лишние удаляются
+    std::vector<Vehicle*> RestoreVehicles(VehicleManager* manager, const std::vector<SnapshotState::VehicleState>& saved) {
+        std::vector<Vehicle*> restored(saved.size(), nullptr);
+        if (!manager) return restored;
+
+        std::vector<Vehicle*> existing;
+        for (const auto& v : manager->GetVehicles()) existing.push_back(v.get());
+        std::vector<bool> used(existing.size(), false);
+
+        for (size_t i = 0; i < saved.size(); ++i) {
+            const auto& s = saved[i];
+            for (size_t j = 0; j < existing.size(); ++j) {
+                if (!used[j] && existing[j]->type.name == s.typeName) {
+                    used[j] = true;
+                    restored[i] = existing[j];
+                    break;
+                }
+            }
+            if (!restored[i]) {
+                VehicleType type;
+                if (!VehicleFactory::CreateByName(s.typeName, type)) {
+                    Logger::Warning("Снапшот: неизвестный тип транспорта ", s.typeName);
+                    continue;
+                }
+                restored[i] = manager->CreateVehicle(PhysXInitializer::gPhysics, PhysXInitializer::gMaterial, type, s.pose.p);
+            }
+
+            Vehicle* v = restored[i];
+            if (s.hasActor && v->mActor) {
+                v->mActor->setGlobalPose(s.pose);
+                v->mActor->setLinearVelocity(s.linearVelocity);
+                v->mActor->setAngularVelocity(s.angularVelocity);
+            }
+            v->throttle = s.throttle;
+            v->brake = s.brake;
+            v->steer = s.steer;
+            v->engineOn = s.engineOn;
+            v->rotorRPM = s.rotorRPM;
+        }
+
+        for (size_t j = 0; j < existing.size(); ++j) {
+            if (!used[j]) manager->DestroyVehicle(existing[j]);
+        }
+        return restored;
+    }
+}
+
+void SnapshotSystem::Capture(const GameLevel& level, const WeatherSystem& weather, SnapshotState& out) {
+    const entt::registry& registry = level.ecs.registry;
+
+    std::unordered_map<const Vehicle*, int32_t> vehicleIndex;
+    out.vehicles.clear();
+    if (level.vehicles) {
+        const auto& list = level.vehicles->GetVehicles();
+        out.vehicles.resize(list.size());
+        for (size_t i = 0; i < list.size(); ++i) {
+            const Vehicle& v = *list[i];
+            auto& s = out.vehicles[i];
+            vehicleIndex[&v] = static_cast<int32_t>(i);
+            s.typeName = v.type.name;
+            s.hasActor = v.mActor != nullptr;
+            if (v.mActor) {
+                s.pose = v.mActor->getGlobalPose();
+                s.linearVelocity = v.mActor->getLinearVelocity();
+                s.angularVelocity = v.mActor->getAngularVelocity();
+            }
+            s.throttle = v.throttle;
+            s.brake = v.brake;
+            s.steer = v.steer;
+            s.engineOn = v.engineOn;
+            s.rotorRPM = v.rotorRPM;
+        }
+    }
+    auto indexOf = [&](const Vehicle* v) -> int32_t {
+        auto it = vehicleIndex.find(v);
+        return it != vehicleIndex.end() ? it->second : -1;
+    };
+
+    out.player = ToId(level.player);
+    out.playerCharacter = ToId(level.playerCharacter);
+    out.vehicle = indexOf(level.vehicle);
+
+    out.entities.clear();
+    out.entities.reserve(registry.alive());
+    registry.each([&](entt::entity e) { out.entities.push_back(ToId(e)); });
+
+    CaptureComponents(registry, out.transforms);
+    CaptureComponents(registry, out.characters);
+    CaptureComponents(registry, out.inventories);
+    CaptureComponents(registry, out.buildingComponents);
+
+    auto vehicleView = registry.view<const VehicleComponent>();
+    out.vehicleComponents.clear();
+    out.vehicleComponents.reserve(vehicleView.size());
+    for (auto entity : vehicleView) {
+        const auto& component = vehicleView.get<const VehicleComponent>(entity);
+        SnapshotState::VehicleLink link;
+        link.vehicle = indexOf(component.vehicle);
+        link.isLocal = component.isLocal;
+        link.playerId = component.playerId;
+        out.vehicleComponents.emplace_back(ToId(entity), link);
+    }
+
+    out.buildings = level.buildings.GetObjects();
+    out.weather = weather.GetCurrentSnapshot();
+    out.hasWeather = true;
+    out.origin = WorldOrigin::Get();
+    out.hasOrigin = true;
+}
+
+void SnapshotSystem::Serialize(const SnapshotState& state, SnapshotFile& out) {
+    for (uint32_t id : SECTION_ORDER) out.AddSection(id);
+    auto& sections = out.GetSections();
+    ThreadPool::Global().ParallelFor(sections.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ByteWriter writer(sections[i].data);
+            WriteSection(sections[i].id, writer, state);
+        }
+    });
 }
 
-void SnapshotSystem::LoadFromFile(const std::string& filename) {
-    LOG(L"Загрузка снапшота: " + std::wstring(filename.begin(), filename.end()));
+void SnapshotSystem::SerializeDelta(const SnapshotState& base, const SnapshotState& current, SnapshotFile& out) {
+    for (uint32_t id : DELTA_SECTION_ORDER) out.AddSection(id);
+    auto& sections = out.GetSections();
+    ThreadPool::Global().ParallelFor(sections.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ByteWriter writer(sections[i].data);
+            WriteDeltaSection(sections[i].id, writer, base, current);
+        }
+    });
 }
 
-void SnapshotSystem::StartAutoSave(const GameLevel& level, const WeatherSystem& weather) {
-    std::thread([level, weather]() mutable {
-        while (true) {
-            std::this_thread::sleep_for(std::chrono::minutes(5));
-            SaveToFile(level, weather, "save_" + std::to_string(
-                std::chrono::duration_cast<std::chrono::seconds>(
-                    std::chrono::system_clock::now().time_since_epoch()).count()) + ".dat");
+bool SnapshotSystem::ApplyDelta(const SnapshotFile& delta, SnapshotState& state) {
+    // Секции дельты применяются по порядку: сущности раньше компонентов
+    for (const auto& section : delta.GetSections()) {
+        ByteReader reader(section.data);
+        if (!ApplyDeltaSection(section.id, reader, state)) {
+            Logger::Error("Снапшот: повреждена секция дельты ", section.id);
+            return false;
         }
-    }).detach();
+    }
+    return true;
+}
+
+bool SnapshotSystem::Deserialize(const SnapshotFile& file, SnapshotState& out) {
+    const auto& sections = file.GetSections();
+    std::vector<char> ok(sections.size(), 1);
+    ThreadPool::Global().ParallelFor(sections.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ByteReader reader(sections[i].data);
+            ok[i] = ReadSection(sections[i].id, reader, out);
+        }
+    });
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!ok[i]) {
+            Logger::Error("Снапшот: повреждена секция ", sections[i].id);
+            return false;
+        }
+    }
+    return true;
+}
+
+void SnapshotSystem::Apply(const SnapshotState& state, GameLevel& level, WeatherSystem& weather) {
+    // Позы меняются только между шагами физики
+    PhysicsUpdateSystem::FetchResults();
+
+    // Сначала начало координат сохранения: подписчики сдвигают сцену, дальше позы ложатся как записаны.
+    // Старые снапшоты без секции - в текущем начале.
+    if (state.hasOrigin) WorldOrigin::RebaseTo(state.origin);
+
+    std::vector<Vehicle*> vehicles = RestoreVehicles(level.vehicles.get(), state.vehicles);
+    auto vehicleAt = [&](int32_t index) -> Vehicle* {
+        return index >= 0 && index < static_cast<int32_t>(vehicles.size()) ? vehicles[index] : nullptr;
+    };
+
+    entt::registry& registry = level.ecs.registry;
+    registry.clear();
+    for (uint32_t id : state.entities) registry.create(FromId(id));
+
+    ApplyComponents(registry, state.transforms);
+    ApplyComponents(registry, state.characters);
+    ApplyComponents(registry, state.inventories);
+    ApplyComponents(registry, state.buildingComponents);
+    for (const auto& item : state.vehicleComponents) {
+        entt::entity entity = FromId(item.first);
+        if (!registry.valid(entity)) continue;
+        registry.emplace_or_replace<VehicleComponent>(entity, vehicleAt(item.second.vehicle),
+                                                      item.second.isLocal, item.second.playerId);
+    }
+
+    level.player = FromId(state.player);
+    level.playerCharacter = FromId(state.playerCharacter);
+    level.vehicle = vehicleAt(state.vehicle);
+
+    level.buildings.Clear();
+    for (const auto& b : state.buildings) level.buildings.Place(b.position, b.type, b.owner);
+
+    if (state.hasWeather) weather.Restore(state.weather);
+}
+
+bool SnapshotSystem::WriteToFile(const SnapshotState& state, const std::string& filename, const std::atomic<bool>* cancel) {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    auto start = Clock::now();
+
+    SnapshotFile file;
+    file.SetCancelFlag(cancel);
+    Serialize(state, file);
+    double serializeMs = MsSince(start);
+
+    if (!file.WriteToFile(filename)) return false;
+
+    const auto& stats = file.GetStats();
+    Logger::Log("Снапшот сохранён: ", filename, " (", state.entities.size(), " сущностей, ",
+                stats.rawBytes, " -> ", stats.fileBytes, " байт; сериализация ", serializeMs, " мс, сжатие ",
+                stats.compressMs, " мс, запись ", stats.ioMs, " мс, всего ", MsSince(start), " мс)");
+    return true;
+}
+
+bool SnapshotSystem::SaveToFile(const GameLevel& level, const WeatherSystem& weather, const std::string& filename) {
+    auto start = Clock::now();
+    SnapshotState state;
+    Capture(level, weather, state);
+    LOG_DEBUG(Core, "Снапшот: захват состояния ", MsSince(start), " мс");
+    return WriteToFile(state, filename);
+}
+
+bool SnapshotSystem::LoadFromFile(GameLevel& level, WeatherSystem& weather, const std::string& filename) {
+    std::lock_guard<std::mutex> lock(saveMutex);
+    auto start = Clock::now();
+
+    // Всё содержимое файла (и журнала дельт) разбирается до применения:
+    // битый файл не портит текущий уровень
+    SnapshotState state;
+    uint32_t deltas = 0;
+    if (!SnapshotJournal::Load(filename, state, &deltas)) return false;
+    double parseMs = MsSince(start);
+
+    Apply(state, level, weather);
+
+    Logger::Log("Снапшот загружен: ", filename, " (", state.entities.size(), " сущностей, дельт из журнала: ",
+                deltas, "; чтение и разбор ", parseMs, " мс, всего ", MsSince(start), " мс)");
+    return true;
 }
\ No newline at end of file
@@ -1,15 +1,111 @@
 #pragma once
 #include "GameLevel.hpp"
 #include "WeatherSystem.hpp"
+#include "../components/TransformComponent.hpp"
+#include "../components/BuildingComponent.hpp"
+#include "../components/InventoryComponent.hpp"
+#include "../world/WorldOrigin.hpp"
 #include <string>
 #include <mutex>
 #include <array>
+#include <vector>
+#include <atomic>
 #include <enet/enet.h> // Для PlayerState
 
+class SnapshotFile;
+
+// Состояние уровня, отвязанное от registry и PhysX: снимается на главном потоке,
+// сериализуется и пишется в любом другом. Сущности - как uint32_t (entt::to_integral).
+struct SnapshotState {
+    struct VehicleLink {
+        int32_t vehicle = -1; // индекс в vehicles
+        bool isLocal = false;
+        uint32_t playerId = 0;
+    };
+
+    struct VehicleState {
+        std::string typeName;
+        bool hasActor = false;
+        PxTransform pose = PxTransform(PxIdentity);
+        PxVec3 linearVelocity = PxVec3(0.0f);
+        PxVec3 angularVelocity = PxVec3(0.0f);
+        float throttle = 0.0f;
+        float brake = 0.0f;
+        float steer = 0.0f;
+        bool engineOn = false;
+        float rotorRPM = 0.0f;
+    };
+
+    uint32_t player = 0;
+    uint32_t playerCharacter = 0;
+    int32_t vehicle = -1;
+    std::vector<uint32_t> entities;
+    std::vector<std::pair<uint32_t, TransformComponent>> transforms;
+    std::vector<std::pair<uint32_t, CharacterComponent>> characters;
+    std::vector<std::pair<uint32_t, InventoryComponent>> inventories;
+    std::vector<std::pair<uint32_t, BuildingComponent>> buildingComponents;
+    std::vector<std::pair<uint32_t, VehicleLink>> vehicleComponents;
+    std::vector<VehicleState> vehicles;
+    std::vector<Buildable> buildings;
+    WeatherSnapshot weather;
+    bool hasWeather = false;
+    // Позы выше - локальные относительно этого начала координат
+    WorldPosition origin;
+    bool hasOrigin = false;
+};
+
+// Двоичный снапшот уровня (формат - SnapshotFile): сущности ECS, компоненты,
+// транспорт, постройки и погода. Каждая секция собирается в своей задаче пула.
 class SnapshotSystem {
     static std::mutex saveMutex;
 public:
-    static void SaveToFile(const GameLevel& level, const WeatherSystem& weather, const std::string& filename);
-    static void LoadFromFile(const std::string& filename);
-    static void StartAutoSave(const GameLevel& level, const WeatherSystem& weather);
+    // Идентификаторы секций; новые добавлять в конец, старые не переиспользовать
+    enum Section : uint32_t {
+        SECTION_LEVEL = 1,
+        SECTION_ENTITIES,
+        SECTION_TRANSFORMS,
+        SECTION_CHARACTERS,
+        SECTION_INVENTORIES,
+        SECTION_BUILDING_COMPONENTS,
+        SECTION_VEHICLE_COMPONENTS,
+        SECTION_VEHICLES,
+        SECTION_BUILDINGS,
+        SECTION_WEATHER,
+        SECTION_ORIGIN,
+
+        // Идентификатор контрольной точки журнала (см. SnapshotJournal)
+        SECTION_CHECKPOINT = 100,
+
+        // Секции дельты: изменения относительно предыдущего сохранения.
+        // Уровень, транспорт и погода в дельте пишутся целиком обычными секциями.
+        SECTION_DELTA_ENTITIES = 200,
+        SECTION_DELTA_TRANSFORMS,
+        SECTION_DELTA_CHARACTERS,
+        SECTION_DELTA_INVENTORIES,
+        SECTION_DELTA_BUILDING_COMPONENTS,
+        SECTION_DELTA_VEHICLE_COMPONENTS,
+        SECTION_DELTA_BUILDINGS
+    };
+
+    // Только главный поток и между шагами физики: позы транспорта читаются из PhysX.
+    // Копирует компоненты плоскими массивами, без сериализации.
+    static void Capture(const GameLevel& level, const WeatherSystem& weather, SnapshotState& out);
+    // Любой поток: раскладывает состояние по секциям (параллельно)
+    static void Serialize(const SnapshotState& state, SnapshotFile& out);
+    static bool Deserialize(const SnapshotFile& file, SnapshotState& out);
+    // Дельта: только записи, отличающиеся от base, и удалённые сущности.
+    // Грязные записи определяются сравнением с прошлым захватом в I/O-потоке,
+    // поэтому игровому коду не нужно помечать изменения вручную.
+    static void SerializeDelta(const SnapshotState& base, const SnapshotState& current, SnapshotFile& out);
+    static bool ApplyDelta(const SnapshotFile& delta, SnapshotState& state);
+    // Главный поток: заменяет содержимое уровня
+    static void Apply(const SnapshotState& state, GameLevel& level, WeatherSystem& weather);
+
+    // cancel (необязательно) прерывает запись; старый файл при этом не портится
+    static bool WriteToFile(const SnapshotState& state, const std::string& filename,
+                            const std::atomic<bool>* cancel = nullptr);
+
+    static bool SaveToFile(const GameLevel& level, const WeatherSystem& weather, const std::string& filename);
+    // Понимает и обычный снапшот, и контрольную точку с журналом дельт
+    static bool LoadFromFile(GameLevel& level, WeatherSystem& weather, const std::string& filename);
 };
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "ThreadPool.hpp"
+#include <memory>
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    if (threadCount == 0) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+    workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        stopping = true;
+    }
+    jobsCv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobsMutex);
+            jobsCv.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (stopping && jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(jobsMutex);
+        jobs.push_back(std::move(job));
+    }
+    jobsCv.notify_one();
+}
+
+namespace {
+    struct ParallelForState {
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> doneChunks{0};
+        size_t chunkCount = 0;
+        size_t chunkSize = 0;
+        size_t count = 0;
+        std::mutex doneMutex;
+        std::condition_variable doneCv;
+    };
+
+    void RunChunks(ParallelForState& state, const std::function<void(size_t, size_t)>* fn) {
+        while (true) {
+            size_t chunk = state.nextChunk.fetch_add(1);
+            if (chunk >= state.chunkCount) return;
+            size_t begin = chunk * state.chunkSize;
+            size_t end = std::min(begin + state.chunkSize, state.count);
+            (*fn)(begin, end);
+            if (state.doneChunks.fetch_add(1) + 1 == state.chunkCount) {
+                std::lock_guard<std::mutex> lock(state.doneMutex);
+                state.doneCv.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    size_t parallelism = workers.size() + 1;
+    size_t chunkSize = std::max(grain, (count + parallelism - 1) / parallelism);
+    size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    if (chunkCount <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    // Состояние живёт, пока его держит хоть один помощник: опоздавший помощник
+    // просто не найдёт свободных кусков и к fn уже не обратится
+    auto state = std::make_shared<ParallelForState>();
+    state->chunkCount = chunkCount;
+    state->chunkSize = chunkSize;
+    state->count = count;
+
+    const auto* fnPtr = &fn;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        Submit([state, fnPtr]() { RunChunks(*state, fnPtr); });
+    }
+    RunChunks(*state, fnPtr);
+
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    state->doneCv.wait(lock, [&state]() { return state->doneChunks.load() == state->chunkCount; });
+}
+
+ThreadPool& ThreadPool::Global() {
+    static ThreadPool pool;
+    return pool;
+}
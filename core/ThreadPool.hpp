@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstddef>
+
+// Пул рабочих потоков для фоновых задач и параллельных циклов по массивам.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsCv;
+    bool stopping = false;
+
+    void WorkerLoop();
+
+public:
+    // threadCount = 0: по числу ядер минус поток игры
+    explicit ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> job);
+
+    // Делит [0, count) на куски не меньше grain и ждёт завершения всех.
+    // Вызывающий поток тоже берёт куски, поэтому вложенный вызов не зависает.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)>& fn);
+
+    unsigned int GetThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    static ThreadPool& Global();
+};
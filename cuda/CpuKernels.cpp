@@ -0,0 +1,295 @@
+#include "CpuKernels.h"
+#include "../core/ThreadPool.hpp"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RTGC_HAS_AVX2_PATH 1
+#include <immintrin.h>
+#define RTGC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define RTGC_HAS_AVX2_PATH 0
+#endif
+
+namespace {
+    // Меньше этого куски не делим: накладные расходы пула перевесят
+    constexpr int PARALLEL_GRAIN = 16384;
+}
+
+namespace CpuKernels {
+
+void WindScalar(float* wind, int size, float time, int begin, int end) {
+    float* windX = wind;
+    float* windY = wind + size;
+    float* windZ = wind + 2 * size;
+    for (int idx = begin; idx < end; ++idx) {
+        float x = (idx % 256) * 0.1f;
+        float z = (idx / 256) * 0.1f;
+        windX[idx] = sinf(x + time) * cosf(z) * 2.0f;
+        windY[idx] = 0.2f + sinf(time * 0.3f) * 0.1f;
+        windZ[idx] = cosf(x) * sinf(z + time) * 2.0f;
+    }
+}
+
+void WindPointsScalar(const float* xs, const float* zs, float* outX, float* outZ, float time, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        outX[i] = sinf(xs[i] + time) * cosf(zs[i]) * 2.0f;
+        outZ[i] = cosf(xs[i]) * sinf(zs[i] + time) * 2.0f;
+    }
+}
+
+void SuspensionScalar(float* suspension, float dt, int begin, int end) {
+    for (int idx = begin; idx < end; ++idx) {
+        suspension[idx] = suspension[idx] * (1.0f - dt * 0.1f);
+        if (suspension[idx] < 0.01f) suspension[idx] = 0.01f;
+    }
+}
+
+void TractionScalar(float* traction, float dt, int begin, int end) {
+    for (int idx = begin; idx < end; ++idx) {
+        traction[idx] = traction[idx] * (1.0f + dt * 0.05f);
+        if (traction[idx] > 1.0f) traction[idx] = 1.0f;
+    }
+}
+
+void TerrainScalar(float* terrain, float dt, int begin, int end) {
+    for (int idx = begin; idx < end; ++idx) {
+        terrain[idx] = terrain[idx] + sinf(idx * 0.01f + dt) * 0.01f;
+    }
+}
+
+#if RTGC_HAS_AVX2_PATH
+
+// sin на 8 дорожках: редукция Коди-Уэйта к [-pi, pi], отражение к [-pi/2, pi/2]
+// и ряд Тейлора до x^11 (погрешность < 1e-6 на этом отрезке)
+RTGC_TARGET_AVX2 static inline __m256 Sin8(__m256 x) {
+    const __m256 inv2Pi = _mm256_set1_ps(0.15915494309189535f);
+    const __m256 twoPiHi = _mm256_set1_ps(6.28125f);
+    const __m256 twoPiLo = _mm256_set1_ps(0.0019353071795864769f);
+    const __m256 pi = _mm256_set1_ps(3.14159265358979f);
+    const __m256 halfPi = _mm256_set1_ps(1.5707963267948966f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    __m256 k = _mm256_round_ps(_mm256_mul_ps(x, inv2Pi), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(k, twoPiHi, x);
+    r = _mm256_fnmadd_ps(k, twoPiLo, r);
+
+    // sin(r) = sin(±pi - r) для |r| > pi/2
+    __m256 signedPi = _mm256_or_ps(pi, _mm256_and_ps(r, signMask));
+    __m256 absR = _mm256_andnot_ps(signMask, r);
+    __m256 fold = _mm256_cmp_ps(absR, halfPi, _CMP_GT_OQ);
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(signedPi, r), fold);
+
+    __m256 r2 = _mm256_mul_ps(r, r);
+    __m256 p = _mm256_set1_ps(-2.5052108385441720e-8f);
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(2.7557319223985893e-6f));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(-1.9841269841269841e-4f));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(8.3333333333333333e-3f));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(-1.6666666666666667e-1f));
+    p = _mm256_fmadd_ps(p, r2, _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(p, r);
+}
+
+RTGC_TARGET_AVX2 static inline __m256 Cos8(__m256 x) {
+    return Sin8(_mm256_add_ps(x, _mm256_set1_ps(1.5707963267948966f)));
+}
+
+RTGC_TARGET_AVX2 static inline __m256i Iota8(int base) {
+    return _mm256_add_epi32(_mm256_set1_epi32(base), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+RTGC_TARGET_AVX2 void WindAvx2(float* wind, int size, float time, int begin, int end) {
+    float* windX = wind;
+    float* windY = wind + size;
+    float* windZ = wind + 2 * size;
+
+    const __m256 step = _mm256_set1_ps(0.1f);
+    const __m256 t = _mm256_set1_ps(time);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    // windY не зависит от позиции - считаем один раз
+    const __m256 y = _mm256_set1_ps(0.2f + sinf(time * 0.3f) * 0.1f);
+
+    int idx = begin;
+    for (; idx + 8 <= end; idx += 8) {
+        __m256i i = Iota8(idx);
+        __m256 x = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(i, _mm256_set1_epi32(255))), step);
+        __m256 z = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(i, 8)), step);
+
+        __m256 wx = _mm256_mul_ps(_mm256_mul_ps(Sin8(_mm256_add_ps(x, t)), Cos8(z)), two);
+        __m256 wz = _mm256_mul_ps(_mm256_mul_ps(Cos8(x), Sin8(_mm256_add_ps(z, t))), two);
+
+        _mm256_storeu_ps(windX + idx, wx);
+        _mm256_storeu_ps(windY + idx, y);
+        _mm256_storeu_ps(windZ + idx, wz);
+    }
+    WindScalar(wind, size, time, idx, end);
+}
+
+RTGC_TARGET_AVX2 void WindPointsAvx2(const float* xs, const float* zs, float* outX, float* outZ, float time, int begin, int end) {
+    const __m256 t = _mm256_set1_ps(time);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 z = _mm256_loadu_ps(zs + i);
+        _mm256_storeu_ps(outX + i, _mm256_mul_ps(_mm256_mul_ps(Sin8(_mm256_add_ps(x, t)), Cos8(z)), two));
+        _mm256_storeu_ps(outZ + i, _mm256_mul_ps(_mm256_mul_ps(Cos8(x), Sin8(_mm256_add_ps(z, t))), two));
+    }
+    WindPointsScalar(xs, zs, outX, outZ, time, i, end);
+}
+
+RTGC_TARGET_AVX2 void SuspensionAvx2(float* suspension, float dt, int begin, int end) {
+    const __m256 factor = _mm256_set1_ps(1.0f - dt * 0.1f);
+    const __m256 minValue = _mm256_set1_ps(0.01f);
+    int idx = begin;
+    for (; idx + 8 <= end; idx += 8) {
+        __m256 s = _mm256_mul_ps(_mm256_loadu_ps(suspension + idx), factor);
+        _mm256_storeu_ps(suspension + idx, _mm256_max_ps(s, minValue));
+    }
+    SuspensionScalar(suspension, dt, idx, end);
+}
+
+RTGC_TARGET_AVX2 void TractionAvx2(float* traction, float dt, int begin, int end) {
+    const __m256 factor = _mm256_set1_ps(1.0f + dt * 0.05f);
+    const __m256 maxValue = _mm256_set1_ps(1.0f);
+    int idx = begin;
+    for (; idx + 8 <= end; idx += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(traction + idx), factor);
+        _mm256_storeu_ps(traction + idx, _mm256_min_ps(v, maxValue));
+    }
+    TractionScalar(traction, dt, idx, end);
+}
+
+RTGC_TARGET_AVX2 void TerrainAvx2(float* terrain, float dt, int begin, int end) {
+    const __m256 scale = _mm256_set1_ps(0.01f);
+    const __m256 phase = _mm256_set1_ps(dt);
+    int idx = begin;
+    for (; idx + 8 <= end; idx += 8) {
+        __m256 arg = _mm256_fmadd_ps(_mm256_cvtepi32_ps(Iota8(idx)), scale, phase);
+        __m256 v = _mm256_fmadd_ps(Sin8(arg), scale, _mm256_loadu_ps(terrain + idx));
+        _mm256_storeu_ps(terrain + idx, v);
+    }
+    TerrainScalar(terrain, dt, idx, end);
+}
+
+bool HasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+
+#else
+
+void WindAvx2(float* wind, int size, float time, int begin, int end) { WindScalar(wind, size, time, begin, end); }
+void SuspensionAvx2(float* suspension, float dt, int begin, int end) { SuspensionScalar(suspension, dt, begin, end); }
+void TractionAvx2(float* traction, float dt, int begin, int end) { TractionScalar(traction, dt, begin, end); }
+void TerrainAvx2(float* terrain, float dt, int begin, int end) { TerrainScalar(terrain, dt, begin, end); }
+void WindPointsAvx2(const float* xs, const float* zs, float* outX, float* outZ, float time, int begin, int end) { WindPointsScalar(xs, zs, outX, outZ, time, begin, end); }
+bool HasAvx2() { return false; }
+
+#endif
+
+}
+
+CpuKernelBackend::CpuKernelBackend(bool allowSimd) : useSimd(allowSimd && CpuKernels::HasAvx2()) {
+}
+
+void CpuKernelBackend::ComputeWind(float* wind, int size, float time) {
+    auto kernel = useSimd ? CpuKernels::WindAvx2 : CpuKernels::WindScalar;
+    ThreadPool::Global().ParallelFor(size, PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+        kernel(wind, size, time, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+void CpuKernelBackend::ComputeSuspension(float* suspension, int size, float dt) {
+    auto kernel = useSimd ? CpuKernels::SuspensionAvx2 : CpuKernels::SuspensionScalar;
+    ThreadPool::Global().ParallelFor(size, PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+        kernel(suspension, dt, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+void CpuKernelBackend::ComputeTraction(float* traction, int size, float dt) {
+    auto kernel = useSimd ? CpuKernels::TractionAvx2 : CpuKernels::TractionScalar;
+    ThreadPool::Global().ParallelFor(size, PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+        kernel(traction, dt, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+void CpuKernelBackend::ComputeTerrain(float* terrain, int size, float dt) {
+    auto kernel = useSimd ? CpuKernels::TerrainAvx2 : CpuKernels::TerrainScalar;
+    ThreadPool::Global().ParallelFor(size, PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+        kernel(terrain, dt, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+void CpuKernelBackend::ComputeWindPoints(const float* xs, const float* zs, float* outX, float* outZ, int count, float time) {
+    auto kernel = useSimd ? CpuKernels::WindPointsAvx2 : CpuKernels::WindPointsScalar;
+    ThreadPool::Global().ParallelFor(count, PARALLEL_GRAIN, [&](size_t begin, size_t end) {
+        kernel(xs, zs, outX, outZ, time, static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+std::unique_ptr<KernelContext> CpuKernelBackend::CreateContext(const KernelContextDesc& desc) {
+    return std::make_unique<CpuKernelContext>(*this, desc);
+}
+
+CpuKernelContext::CpuKernelContext(CpuKernelBackend& b, const KernelContextDesc& desc) : backend(b) {
+    for (int i = 0; i < KERNEL_COUNT; ++i) {
+        KernelId id = static_cast<KernelId>(i);
+        Channel& ch = channels[i];
+        ch.size = GetElementCount(desc, id);
+        if (ch.size == 0) continue;
+        if (id != KernelId::Wind) ch.input = new float[ch.size]();
+        ch.results[0] = new float[ch.size]();
+        ch.results[1] = new float[ch.size]();
+    }
+}
+
+CpuKernelContext::~CpuKernelContext() {
+    Synchronize();
+    for (auto& ch : channels) {
+        delete[] ch.input;
+        delete[] ch.results[0];
+        delete[] ch.results[1];
+    }
+}
+
+void CpuKernelContext::Enqueue(KernelId id, int slot, float param) {
+    // Слот мог ещё считаться, если кадры идут быстрее ядра
+    WaitSlot(id, slot);
+
+    Channel& ch = GetChannel(id);
+    float* out = ch.results[slot];
+    int size = ch.size;
+    if (ch.input) {
+        // Вход копируется сразу, так что вызывающий может заполнять его для следующего кадра
+        std::memcpy(out, ch.input, size * sizeof(float));
+    }
+
+    auto done = std::make_shared<std::promise<void>>();
+    pending[static_cast<int>(id)][slot] = done->get_future();
+    CpuKernelBackend* b = &backend;
+    ThreadPool::Global().Submit([b, id, out, size, param, done]() {
+        switch (id) {
+            case KernelId::Wind: b->ComputeWind(out, size / 3, param); break;
+            case KernelId::Suspension: b->ComputeSuspension(out, size, param); break;
+            case KernelId::Traction: b->ComputeTraction(out, size, param); break;
+            case KernelId::Terrain: b->ComputeTerrain(out, size, param); break;
+            default: break;
+        }
+        done->set_value();
+    });
+}
+
+void CpuKernelContext::WaitSlot(KernelId id, int slot) {
+    std::future<void>& f = pending[static_cast<int>(id)][slot];
+    if (f.valid()) f.get();
+}
+
+void CpuKernelContext::Synchronize() {
+    for (int i = 0; i < KERNEL_COUNT; ++i) {
+        WaitSlot(static_cast<KernelId>(i), 0);
+        WaitSlot(static_cast<KernelId>(i), 1);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "KernelBackend.h"
+#include <future>
+
+// Эталонные скалярные версии повторяют ядра из .cu построчно и работают
+// на диапазоне [begin, end), AVX2-версии должны давать тот же результат.
+namespace CpuKernels {
+    void WindScalar(float* wind, int size, float time, int begin, int end);
+    void SuspensionScalar(float* suspension, float dt, int begin, int end);
+    void TractionScalar(float* traction, float dt, int begin, int end);
+    void TerrainScalar(float* terrain, float dt, int begin, int end);
+    // Ветер в произвольных точках (координаты в единицах сетки ядра: метры * 0.1)
+    void WindPointsScalar(const float* xs, const float* zs, float* outX, float* outZ, float time, int begin, int end);
+
+    void WindAvx2(float* wind, int size, float time, int begin, int end);
+    void SuspensionAvx2(float* suspension, float dt, int begin, int end);
+    void TractionAvx2(float* traction, float dt, int begin, int end);
+    void TerrainAvx2(float* terrain, float dt, int begin, int end);
+    void WindPointsAvx2(const float* xs, const float* zs, float* outX, float* outZ, float time, int begin, int end);
+
+    bool HasAvx2();
+}
+
+class CpuKernelBackend : public KernelBackend {
+    bool useSimd;
+
+public:
+    explicit CpuKernelBackend(bool allowSimd = true);
+
+    const char* GetName() const override { return useSimd ? "CPU (AVX2)" : "CPU"; }
+    bool IsSimd() const { return useSimd; }
+
+    void ComputeWind(float* wind, int size, float time) override;
+    void ComputeSuspension(float* suspension, int size, float dt) override;
+    void ComputeTraction(float* traction, int size, float dt) override;
+    void ComputeTerrain(float* terrain, int size, float dt) override;
+    void ComputeWindPoints(const float* xs, const float* zs, float* outX, float* outZ, int count, float time) override;
+
+    std::unique_ptr<KernelContext> CreateContext(const KernelContextDesc& desc) override;
+};
+
+// Тот же конвейер, что и на GPU: расчёт уходит в пул потоков, результат забирается в следующем кадре.
+// Так расписание запусков проверяется без видеокарты (KernelBench).
+class CpuKernelContext : public KernelContext {
+    CpuKernelBackend& backend;
+    std::future<void> pending[KERNEL_COUNT][2];
+
+protected:
+    // Вход копируется в Enqueue до постановки в пул, ждать нечего
+    void WaitInputFree(KernelId) override {}
+    void Enqueue(KernelId id, int slot, float param) override;
+    void WaitSlot(KernelId id, int slot) override;
+
+public:
+    CpuKernelContext(CpuKernelBackend& backend, const KernelContextDesc& desc);
+    ~CpuKernelContext() override;
+
+    void Synchronize() override;
+};
@@ -0,0 +1,118 @@
+#ifdef RTGC_WITH_CUDA
+#include "KernelContext.h"
+#include "WindCuda.h"
+#include "SuspensionCuda.h"
+#include "TractionCuda.h"
+#include "TerrainCuda.h"
+#include <cuda_runtime.h>
+#include <memory>
+
+// Буферы устройства и закреплённая память CPU выделяются один раз; копирования
+// и ядро идут на одном потоке, готовность слота отмечается событием
+class CudaKernelContext : public KernelContext {
+    cudaStream_t stream = nullptr;
+    float* device[KERNEL_COUNT] = {};
+    cudaEvent_t inputFree[KERNEL_COUNT] = {};
+    cudaEvent_t slotDone[KERNEL_COUNT][2] = {};
+    bool inputPending[KERNEL_COUNT] = {};
+    bool slotPending[KERNEL_COUNT][2] = {};
+    bool valid = true;
+
+protected:
+    void WaitInputFree(KernelId id) override {
+        int i = static_cast<int>(id);
+        if (inputPending[i]) {
+            cudaEventSynchronize(inputFree[i]);
+            inputPending[i] = false;
+        }
+    }
+
+    void Enqueue(KernelId id, int slot, float param) override {
+        int i = static_cast<int>(id);
+        Channel& ch = channels[i];
+        size_t bytes = ch.size * sizeof(float);
+
+        if (ch.input) {
+            cudaMemcpyAsync(device[i], ch.input, bytes, cudaMemcpyHostToDevice, stream);
+            cudaEventRecord(inputFree[i], stream);
+            inputPending[i] = true;
+        }
+
+        switch (id) {
+            case KernelId::Wind: LaunchWindCudaAsync(device[i], ch.size / 3, param, stream); break;
+            case KernelId::Suspension: LaunchSuspensionCudaAsync(device[i], ch.size, param, stream); break;
+            case KernelId::Traction: LaunchTractionCudaAsync(device[i], ch.size, param, stream); break;
+            case KernelId::Terrain: LaunchTerrainCudaAsync(device[i], ch.size, param, stream); break;
+            default: break;
+        }
+
+        cudaMemcpyAsync(ch.results[slot], device[i], bytes, cudaMemcpyDeviceToHost, stream);
+        cudaEventRecord(slotDone[i][slot], stream);
+        slotPending[i][slot] = true;
+    }
+
+    void WaitSlot(KernelId id, int slot) override {
+        int i = static_cast<int>(id);
+        if (slotPending[i][slot]) {
+            cudaEventSynchronize(slotDone[i][slot]);
+            slotPending[i][slot] = false;
+        }
+    }
+
+public:
+    explicit CudaKernelContext(const KernelContextDesc& desc) {
+        valid = cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking) == cudaSuccess;
+        for (int i = 0; i < KERNEL_COUNT && valid; ++i) {
+            KernelId id = static_cast<KernelId>(i);
+            Channel& ch = channels[i];
+            ch.size = GetElementCount(desc, id);
+            if (ch.size == 0) continue;
+
+            // Любая неудача делает контекст негодным: бэкенд отдаст вместо него CPU-контекст
+            size_t bytes = ch.size * sizeof(float);
+            valid = cudaMalloc(&device[i], bytes) == cudaSuccess &&
+                    cudaMemset(device[i], 0, bytes) == cudaSuccess &&
+                    (id == KernelId::Wind || cudaMallocHost(&ch.input, bytes) == cudaSuccess) &&
+                    cudaMallocHost(&ch.results[0], bytes) == cudaSuccess &&
+                    cudaMallocHost(&ch.results[1], bytes) == cudaSuccess;
+            if (!valid) break;
+
+            valid = cudaEventCreateWithFlags(&inputFree[i], cudaEventDisableTiming) == cudaSuccess &&
+                    cudaEventCreateWithFlags(&slotDone[i][0], cudaEventDisableTiming) == cudaSuccess &&
+                    cudaEventCreateWithFlags(&slotDone[i][1], cudaEventDisableTiming) == cudaSuccess;
+        }
+    }
+
+    ~CudaKernelContext() override {
+        if (stream) Synchronize();
+        for (int i = 0; i < KERNEL_COUNT; ++i) {
+            Channel& ch = channels[i];
+            if (device[i]) cudaFree(device[i]);
+            if (ch.input) cudaFreeHost(ch.input);
+            if (ch.results[0]) cudaFreeHost(ch.results[0]);
+            if (ch.results[1]) cudaFreeHost(ch.results[1]);
+            if (inputFree[i]) cudaEventDestroy(inputFree[i]);
+            if (slotDone[i][0]) cudaEventDestroy(slotDone[i][0]);
+            if (slotDone[i][1]) cudaEventDestroy(slotDone[i][1]);
+        }
+        if (stream) cudaStreamDestroy(stream);
+    }
+
+    bool IsValid() const { return valid; }
+
+    void Synchronize() override {
+        cudaStreamSynchronize(stream);
+        for (int i = 0; i < KERNEL_COUNT; ++i) {
+            inputPending[i] = false;
+            slotPending[i][0] = false;
+            slotPending[i][1] = false;
+        }
+    }
+};
+
+std::unique_ptr<KernelContext> CreateCudaKernelContext(const KernelContextDesc& desc) {
+    auto context = std::make_unique<CudaKernelContext>(desc);
+    if (!context->IsValid()) return nullptr;
+    return context;
+}
+#endif
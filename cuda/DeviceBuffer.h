@@ -0,0 +1,25 @@
+#pragma once
+#include <cuda_runtime.h>
+#include <cstddef>
+
+// Буфер устройства, который живёт между запусками ядра и только растёт:
+// покадровый вызов не платит за cudaMalloc/cudaFree. Один буфер на ядро,
+// запуски одного ядра идут с одного потока.
+struct DeviceBuffer {
+    float* data = nullptr;
+    size_t capacity = 0;
+
+    // nullptr, если памяти устройства не хватило; следующий вызов попробует снова
+    float* Get(size_t count) {
+        if (count > capacity) {
+            cudaFree(data);
+            data = nullptr;
+            capacity = 0;
+            float* allocated = nullptr;
+            if (cudaMalloc(&allocated, count * sizeof(float)) != cudaSuccess) return nullptr;
+            data = allocated;
+            capacity = count;
+        }
+        return data;
+    }
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "KernelBackend.h"
+#include "CpuKernels.h"
+#include "../core/Logger.hpp"
+#include <cstdlib>
+#include <string>
+
+#ifdef RTGC_WITH_CUDA
+#include <cuda_runtime.h>
+#include "WindCuda.h"
+#include "SuspensionCuda.h"
+#include "TractionCuda.h"
+#include "TerrainCuda.h"
+
+// nullptr, если не хватило памяти устройства или закреплённой памяти
+std::unique_ptr<KernelContext> CreateCudaKernelContext(const KernelContextDesc& desc);
+
+class CudaKernelBackend : public KernelBackend {
+    // Пакеты точек - сотни элементов: копирование на устройство дороже самого расчёта.
+    // Он же считает ядра, которые не удалось запустить на устройстве.
+    CpuKernelBackend cpu;
+    bool fallbackReported = false;
+
+    bool Fallback(bool launched, const char* kernel) {
+        if (launched) return false;
+        if (!fallbackReported) {
+            Logger::Error("CUDA: ядро ", kernel, " не выполнено (", cudaGetErrorString(cudaGetLastError()), "), считаем на CPU");
+            fallbackReported = true;
+        }
+        return true;
+    }
+
+public:
+    const char* GetName() const override { return "CUDA"; }
+    void ComputeWind(float* wind, int size, float time) override {
+        if (Fallback(LaunchWindCuda(wind, size, time), "Wind")) cpu.ComputeWind(wind, size, time);
+    }
+    void ComputeSuspension(float* suspension, int size, float dt) override {
+        if (Fallback(LaunchSuspensionCuda(suspension, size, dt), "Suspension")) cpu.ComputeSuspension(suspension, size, dt);
+    }
+    void ComputeTraction(float* traction, int size, float dt) override {
+        if (Fallback(LaunchTractionCuda(traction, size, dt), "Traction")) cpu.ComputeTraction(traction, size, dt);
+    }
+    void ComputeTerrain(float* terrain, int size, float dt) override {
+        if (Fallback(LaunchTerrainCuda(terrain, size, dt), "Terrain")) cpu.ComputeTerrain(terrain, size, dt);
+    }
+    void ComputeWindPoints(const float* xs, const float* zs, float* outX, float* outZ, int count, float time) override {
+        cpu.ComputeWindPoints(xs, zs, outX, outZ, count, time);
+    }
+    std::unique_ptr<KernelContext> CreateContext(const KernelContextDesc& desc) override {
+        if (auto context = CreateCudaKernelContext(desc)) return context;
+        Logger::Error("CUDA: не удалось выделить буферы контекста ядер, считаем на CPU");
+        return cpu.CreateContext(desc);
+    }
+};
+
+static bool HasCudaDevice() {
+    int count = 0;
+    return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+}
+#endif
+
+static std::unique_ptr<KernelBackend> CreateBackend() {
+    const char* env = std::getenv("RTGC_KERNEL_BACKEND");
+    std::string requested = env ? env : "";
+
+    if (requested == "cpu-scalar") {
+        return std::make_unique<CpuKernelBackend>(false);
+    }
+#ifdef RTGC_WITH_CUDA
+    if (requested != "cpu") {
+        if (HasCudaDevice()) {
+            return std::make_unique<CudaKernelBackend>();
+        }
+        Logger::Warning("CUDA-устройство не найдено, ядра считаются на CPU");
+    }
+#else
+    if (requested == "cuda") {
+        Logger::Warning("Сборка без CUDA, ядра считаются на CPU");
+    }
+#endif
+    return std::make_unique<CpuKernelBackend>(true);
+}
+
+KernelBackend& KernelBackend::Get() {
+    static std::unique_ptr<KernelBackend> backend = []() {
+        auto b = CreateBackend();
+        Logger::Log("Вычислительные ядра: ", b->GetName());
+        return b;
+    }();
+    return *backend;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <memory>
+#include "KernelContext.h"
+
+// Общий интерфейс вычислительных ядер (ветер, подвеска, сцепление, ландшафт).
+// Все буферы - на стороне CPU; реализация сама решает, где считать.
+class KernelBackend {
+public:
+    virtual ~KernelBackend() = default;
+
+    virtual const char* GetName() const = 0;
+
+    // wind: три подряд идущих массива X, Y, Z по size элементов (сетка 256 в ширину)
+    virtual void ComputeWind(float* wind, int size, float time) = 0;
+    virtual void ComputeSuspension(float* suspension, int size, float dt) = 0;
+    virtual void ComputeTraction(float* traction, int size, float dt) = 0;
+    virtual void ComputeTerrain(float* terrain, int size, float dt) = 0;
+    // Ветер в произвольных точках (координаты в единицах сетки ядра: метры * 0.1),
+    // пакеты частиц и растительности; можно звать с любого потока
+    virtual void ComputeWindPoints(const float* xs, const float* zs, float* outX, float* outZ, int count, float time) = 0;
+
+    // Контекст с постоянными буферами для покадровых асинхронных запусков
+    virtual std::unique_ptr<KernelContext> CreateContext(const KernelContextDesc& desc) = 0;
+
+    // CUDA при наличии устройства, иначе CPU. Переменная окружения
+    // RTGC_KERNEL_BACKEND=cuda|cpu|cpu-scalar задаёт выбор явно.
+    static KernelBackend& Get();
+};
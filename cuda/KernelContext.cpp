@@ -0,0 +1,35 @@
+#include "KernelContext.h"
+
+int KernelContext::GetElementCount(const KernelContextDesc& desc, KernelId id) {
+    switch (id) {
+        case KernelId::Wind: return desc.windSize * 3;
+        case KernelId::Suspension: return desc.suspensionSize;
+        case KernelId::Traction: return desc.tractionSize;
+        case KernelId::Terrain: return desc.terrainSize;
+        default: return 0;
+    }
+}
+
+float* KernelContext::GetInputBuffer(KernelId id) {
+    Channel& ch = GetChannel(id);
+    if (!ch.input) return nullptr;
+    WaitInputFree(id);
+    return ch.input;
+}
+
+void KernelContext::Launch(KernelId id, float param) {
+    Channel& ch = GetChannel(id);
+    if (ch.size == 0) return;
+    int slot = static_cast<int>(ch.launches % 2);
+    Enqueue(id, slot, param);
+    ch.launches++;
+}
+
+const float* KernelContext::GetResult(KernelId id) {
+    Channel& ch = GetChannel(id);
+    if (ch.launches == 0) return nullptr;
+    // Предыдущий запуск успел отработать за кадр; при единственном запуске ждём его
+    int slot = ch.launches >= 2 ? static_cast<int>((ch.launches - 2) % 2) : 0;
+    WaitSlot(id, slot);
+    return ch.results[slot];
+}
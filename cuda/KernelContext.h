@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+
+enum class KernelId {
+    Wind = 0,
+    Suspension,
+    Traction,
+    Terrain,
+    Count
+};
+
+struct KernelContextDesc {
+    int windSize = 0;       // клеток сетки ветра (256 в ширину)
+    int suspensionSize = 0;
+    int tractionSize = 0;
+    int terrainSize = 0;    // 0 - канал не нужен и не выделяется
+};
+
+// Постоянные буферы и асинхронный запуск ядер с двойной буферизацией:
+//   float* in = ctx.GetInputBuffer(id);   // только для ядер, меняющих данные на месте
+//   ctx.Launch(id, param);                // кадр N уходит считаться
+//   const float* r = ctx.GetResult(id);   // результат кадра N-1 (для первого запуска - ждём его)
+// Указатель результата действителен до следующего Launch того же ядра.
+class KernelContext {
+public:
+    static constexpr int KERNEL_COUNT = static_cast<int>(KernelId::Count);
+
+protected:
+    struct Channel {
+        int size = 0;              // элементов на запуск (для ветра - три массива X, Y, Z)
+        float* input = nullptr;    // закреплённая память CPU под входные данные
+        float* results[2] = { nullptr, nullptr };
+        uint64_t launches = 0;
+    };
+    Channel channels[KERNEL_COUNT];
+
+    Channel& GetChannel(KernelId id) { return channels[static_cast<int>(id)]; }
+    const Channel& GetChannel(KernelId id) const { return channels[static_cast<int>(id)]; }
+
+    static int GetElementCount(const KernelContextDesc& desc, KernelId id);
+
+    // Ждать, пока вход канала можно перезаписывать
+    virtual void WaitInputFree(KernelId id) = 0;
+    // Поставить расчёт в очередь; результат ляжет в results[slot]
+    virtual void Enqueue(KernelId id, int slot, float param) = 0;
+    // Ждать завершения расчёта, пишущего в results[slot]
+    virtual void WaitSlot(KernelId id, int slot) = 0;
+
+public:
+    virtual ~KernelContext() = default;
+
+    float* GetInputBuffer(KernelId id);
+    void Launch(KernelId id, float param);
+    const float* GetResult(KernelId id);
+    int GetSize(KernelId id) const { return GetChannel(id).size; }
+    uint64_t GetLaunchCount(KernelId id) const { return GetChannel(id).launches; }
+
+    virtual void Synchronize() = 0;
+};
@@ -1,4 +1,5 @@
 #include <cuda_runtime.h>
+#include "DeviceBuffer.h"
 
 __global__ void ComputeSuspension(float* suspension, int size, float dt) {
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -8,12 +9,22 @@ __global__ void ComputeSuspension(float* suspension, int size, float dt) {
     if (suspension[idx] < 0.01f) suspension[idx] = 0.01f;
 }
 
-extern "C" void LaunchSuspensionCuda(float* h_suspension, int size, float dt) {
-    float *d_suspension;
+static DeviceBuffer d_suspensionBuffer;
+
+// false - ошибка CUDA (нет памяти, сбой запуска или копирования); данные на CPU тогда не тронуты
+extern "C" bool LaunchSuspensionCuda(float* h_suspension, int size, float dt) {
+    float* d_suspension = d_suspensionBuffer.Get(size);
+    if (!d_suspension) return false;
     size_t bytes = size * sizeof(float);
-    cudaMalloc(&d_suspension, bytes);
+    if (cudaMemcpy(d_suspension, h_suspension, bytes, cudaMemcpyHostToDevice) != cudaSuccess) return false;
     dim3 block(256), grid((size + 255) / 256);
     ComputeSuspension<<<grid, block>>>(d_suspension, size, dt);
-    cudaMemcpy(h_suspension, d_suspension, bytes, cudaMemcpyDeviceToHost);
-    cudaFree(d_suspension);
+    if (cudaGetLastError() != cudaSuccess) return false;
+    return cudaMemcpy(h_suspension, d_suspension, bytes, cudaMemcpyDeviceToHost) == cudaSuccess;
+}
+
+// Только запуск на потоке: буферы устройства постоянные, копирования делает KernelContext
+extern "C" void LaunchSuspensionCudaAsync(float* d_suspension, int size, float dt, cudaStream_t stream) {
+    dim3 block(256), grid((size + 255) / 256);
+    ComputeSuspension<<<grid, block, 0, stream>>>(d_suspension, size, dt);
 }
\ No newline at end of file
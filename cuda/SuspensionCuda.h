@@ -1,2 +1,4 @@
 #pragma once
-void LaunchSuspensionCuda(float* h_suspension, int size, float dt);
\ No newline at end of file
+#include <cuda_runtime.h>
+extern "C" bool LaunchSuspensionCuda(float* h_suspension, int size, float dt);
+extern "C" void LaunchSuspensionCudaAsync(float* d_suspension, int size, float dt, cudaStream_t stream);
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <cuda_runtime.h>
+#include "DeviceBuffer.h"
 
 __global__ void ComputeTerrain(float* terrain, int size, float dt) {
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -7,12 +8,22 @@ __global__ void ComputeTerrain(float* terrain, int size, float dt) {
     terrain[idx] = terrain[idx] + sinf(idx * 0.01f + dt) * 0.01f;
 }
 
-extern "C" void LaunchTerrainCuda(float* h_terrain, int size, float dt) {
-    float *d_terrain;
+static DeviceBuffer d_terrainBuffer;
+
+// false - ошибка CUDA (нет памяти, сбой запуска или копирования); данные на CPU тогда не тронуты
+extern "C" bool LaunchTerrainCuda(float* h_terrain, int size, float dt) {
+    float* d_terrain = d_terrainBuffer.Get(size);
+    if (!d_terrain) return false;
     size_t bytes = size * sizeof(float);
-    cudaMalloc(&d_terrain, bytes);
+    if (cudaMemcpy(d_terrain, h_terrain, bytes, cudaMemcpyHostToDevice) != cudaSuccess) return false;
     dim3 block(256), grid((size + 255) / 256);
     ComputeTerrain<<<grid, block>>>(d_terrain, size, dt);
-    cudaMemcpy(h_terrain, d_terrain, bytes, cudaMemcpyDeviceToHost);
-    cudaFree(d_terrain);
+    if (cudaGetLastError() != cudaSuccess) return false;
+    return cudaMemcpy(h_terrain, d_terrain, bytes, cudaMemcpyDeviceToHost) == cudaSuccess;
+}
+
+// Только запуск на потоке: буферы устройства постоянные, копирования делает KernelContext
+extern "C" void LaunchTerrainCudaAsync(float* d_terrain, int size, float dt, cudaStream_t stream) {
+    dim3 block(256), grid((size + 255) / 256);
+    ComputeTerrain<<<grid, block, 0, stream>>>(d_terrain, size, dt);
 }
\ No newline at end of file
@@ -1,2 +1,4 @@
 #pragma once
-void LaunchTerrainCuda(float* h_terrain, int size, float dt);
\ No newline at end of file
+#include <cuda_runtime.h>
+extern "C" bool LaunchTerrainCuda(float* h_terrain, int size, float dt);
+extern "C" void LaunchTerrainCudaAsync(float* d_terrain, int size, float dt, cudaStream_t stream);
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <cuda_runtime.h>
+#include "DeviceBuffer.h"
 
 __global__ void ComputeTraction(float* traction, int size, float dt) {
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -8,12 +9,22 @@ __global__ void ComputeTraction(float* traction, int size, float dt) {
     if (traction[idx] > 1.0f) traction[idx] = 1.0f;
 }
 
-extern "C" void LaunchTractionCuda(float* h_traction, int size, float dt) {
-    float *d_traction;
+static DeviceBuffer d_tractionBuffer;
+
+// false - ошибка CUDA (нет памяти, сбой запуска или копирования); данные на CPU тогда не тронуты
+extern "C" bool LaunchTractionCuda(float* h_traction, int size, float dt) {
+    float* d_traction = d_tractionBuffer.Get(size);
+    if (!d_traction) return false;
     size_t bytes = size * sizeof(float);
-    cudaMalloc(&d_traction, bytes);
+    if (cudaMemcpy(d_traction, h_traction, bytes, cudaMemcpyHostToDevice) != cudaSuccess) return false;
     dim3 block(256), grid((size + 255) / 256);
     ComputeTraction<<<grid, block>>>(d_traction, size, dt);
-    cudaMemcpy(h_traction, d_traction, bytes, cudaMemcpyDeviceToHost);
-    cudaFree(d_traction);
+    if (cudaGetLastError() != cudaSuccess) return false;
+    return cudaMemcpy(h_traction, d_traction, bytes, cudaMemcpyDeviceToHost) == cudaSuccess;
+}
+
+// Только запуск на потоке: буферы устройства постоянные, копирования делает KernelContext
+extern "C" void LaunchTractionCudaAsync(float* d_traction, int size, float dt, cudaStream_t stream) {
+    dim3 block(256), grid((size + 255) / 256);
+    ComputeTraction<<<grid, block, 0, stream>>>(d_traction, size, dt);
 }
\ No newline at end of file
@@ -1,2 +1,4 @@
 #pragma once
-void LaunchTractionCuda(float* h_traction, int size, float dt);
\ No newline at end of file
+#include <cuda_runtime.h>
+extern "C" bool LaunchTractionCuda(float* h_traction, int size, float dt);
+extern "C" void LaunchTractionCudaAsync(float* d_traction, int size, float dt, cudaStream_t stream);
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <cuda_runtime.h>
+#include "DeviceBuffer.h"
 
 __global__ void ComputeWindField(float* windX, float* windY, float* windZ, int size, float time) {
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -10,15 +11,21 @@ __global__ void ComputeWindField(float* windX, float* windY, float* windZ, int s
     windZ[idx] = cosf(x) * sinf(z + time) * 2.0f;
 }
 
-extern "C" void LaunchWindCuda(float* h_wind, int size, float time) {
-    float *d_windX, *d_windY, *d_windZ;
-    size_t bytes = size * sizeof(float);
-    cudaMalloc(&d_windX, bytes); cudaMalloc(&d_windY, bytes); cudaMalloc(&d_windZ, bytes);
+static DeviceBuffer d_windBuffer;
+
+// false - ошибка CUDA (нет памяти, сбой запуска или копирования)
+extern "C" bool LaunchWindCuda(float* h_wind, int size, float time) {
+    // X, Y, Z лежат подряд и на устройстве, и на CPU: одно копирование вместо трёх
+    float* d_wind = d_windBuffer.Get(size * 3);
+    if (!d_wind) return false;
+    dim3 block(256), grid((size + 255) / 256);
+    ComputeWindField<<<grid, block>>>(d_wind, d_wind + size, d_wind + 2 * size, size, time);
+    if (cudaGetLastError() != cudaSuccess) return false;
+    return cudaMemcpy(h_wind, d_wind, size * 3 * sizeof(float), cudaMemcpyDeviceToHost) == cudaSuccess;
+}
+
+// Только запуск на потоке: буферы устройства постоянные, копирования делает KernelContext
+extern "C" void LaunchWindCudaAsync(float* d_wind, int size, float time, cudaStream_t stream) {
     dim3 block(256), grid((size + 255) / 256);
-    ComputeWindField<<<grid, block>>>(d_windX, d_windY, d_windZ, size, time);
-    // ИСПРАВЛЕНО: Копируем все 3 массива
-    cudaMemcpy(h_wind, d_windX, bytes, cudaMemcpyDeviceToHost);
-    cudaMemcpy(h_wind + size, d_windY, bytes, cudaMemcpyDeviceToHost);
-    cudaMemcpy(h_wind + 2 * size, d_windZ, bytes, cudaMemcpyDeviceToHost);
-    cudaFree(d_windX); cudaFree(d_windY); cudaFree(d_windZ);
+    ComputeWindField<<<grid, block, 0, stream>>>(d_wind, d_wind + size, d_wind + 2 * size, size, time);
 }
\ No newline at end of file
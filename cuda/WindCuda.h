@@ -1,2 +1,4 @@
 #pragma once
-void LaunchWindCuda(float* h_wind, int size, float time);
\ No newline at end of file
+#include <cuda_runtime.h>
+extern "C" bool LaunchWindCuda(float* h_wind, int size, float time);
+extern "C" void LaunchWindCudaAsync(float* d_wind, int size, float time, cudaStream_t stream);
\ No newline at end of file
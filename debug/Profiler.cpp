@@ -1,25 +1,555 @@
 #include "Profiler.hpp"
+#include "ProfilerTrace.hpp"
 #include "../core/Logger.hpp"
-#include <iostream>
+#include "../core/ThreadPool.hpp"
+#include "../core/Histogram.hpp"
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <deque>
+#include <unordered_map>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <ctime>
 
-void Profiler::BeginSample(const std::string& name) {
-    data[name].start = std::chrono::high_resolution_clock::now();
+// Инициализация статических переменных
+std::atomic<bool> Profiler::enabled{true};
+thread_local uint16_t Profiler::depth = 0;
+
+namespace {
+    constexpr size_t BUFFER_CAPACITY = 1 << 14; // событий на поток между двумя EndFrame
+    constexpr size_t BUFFER_MASK = BUFFER_CAPACITY - 1;
+
+    struct ZoneInfo {
+        const char* name;
+        const char* file;
+        int line;
+    };
+
+    // Буфер потока: пишет только владелец, читает только EndFrame
+    struct ThreadBuffer {
+        std::vector<Profiler::ZoneEvent> events;
+        alignas(64) std::atomic<size_t> head{0};
+        alignas(64) std::atomic<size_t> tail{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> alive{true};
+        std::string name; // под registryMutex
+        uint32_t index = 0;
+
+        ThreadBuffer() : events(BUFFER_CAPACITY) {}
+    };
+
+    // Гистограмма длительностей в нс; читает и пишет только EndFrame, поэтому без атомиков
+    struct DurationHistogram {
+        uint32_t counts[HistogramBuckets::COUNT] = {};
+
+        void Add(uint64_t ns) { ++counts[HistogramBuckets::Index(ns)]; }
+
+        uint64_t Percentile(double q, uint64_t total) const {
+            return HistogramBuckets::Percentile(q, total, [this](int b) { return counts[b]; });
+        }
+    };
+
+    struct ZoneAccum {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t minNs = UINT64_MAX;
+        uint64_t maxNs = 0;
+        DurationHistogram histogram;
+    };
+
+    struct OtherThreadZone {
+        uint32_t thread;
+        uint16_t zone;
+        uint64_t totalNs;
+        uint64_t count;
+    };
+
+    struct CapturedFrame {
+        uint64_t index;
+        uint64_t start;
+        uint64_t end;
+        std::vector<TraceCapture::Event> events;
+    };
+
+    struct ProfilerState {
+        std::mutex registryMutex;
+        ZoneInfo zones[Profiler::MAX_ZONES];
+        std::atomic<uint16_t> zoneCount{0};
+        std::vector<std::shared_ptr<ThreadBuffer>> threads;
+        uint32_t nextThreadIndex = 1;
+        uint64_t retiredDropped = 0; // потери завершившихся потоков, чьи буферы уже удалены
+
+        // Калибровка тактов: опорная точка и текущий коэффициент
+        std::once_flag calibrateOnce;
+        uint64_t baseTicks = 0;
+        std::chrono::steady_clock::time_point baseTime;
+        std::atomic<double> nsPerTick{1.0};
+
+        // Только поток кадра
+        ThreadBuffer* frameBuffer = nullptr;
+        uint64_t frameIndex = 0;
+        uint64_t frameStart = 0;
+        uint64_t lastFrameStart = 0;
+        uint64_t lastFrameEnd = 0;
+        std::vector<Profiler::ZoneEvent> frameEvents;
+        std::vector<Profiler::ZoneEvent> lastFrameEvents;
+        std::vector<OtherThreadZone> lastOtherThreads;
+        int reportInterval = 0;
+
+        // Захват трассы: запросы из любых потоков, окно кадров - только поток кадра
+        std::atomic<int> captureRequest{0};
+        std::atomic<double> autoThresholdMs{0.0};
+        std::atomic<int> autoWindow{0};
+        int captureRemaining = 0;
+        uint64_t autoCooldownUntil = 0;
+        std::deque<CapturedFrame> captureFrames;
+        std::unordered_map<uint32_t, std::string> captureThreadNames;
+
+        // Статистика читается из любого потока
+        std::mutex statsMutex;
+        std::vector<ZoneAccum> accum;
+    };
+
+    ProfilerState& GetState() {
+        static ProfilerState state;
+        return state;
+    }
+
+    void EnsureCalibrated(ProfilerState& s) {
+        std::call_once(s.calibrateOnce, [&s]() {
+            s.baseTime = std::chrono::steady_clock::now();
+            s.baseTicks = Profiler::Now();
+#if RTGC_PROFILER_TSC
+            // Первичная оценка за 2 мс; дальше EndFrame уточняет её по всему прошедшему времени
+            auto until = s.baseTime + std::chrono::milliseconds(2);
+            std::chrono::steady_clock::time_point now;
+            do {
+                now = std::chrono::steady_clock::now();
+            } while (now < until);
+            uint64_t ticks = Profiler::Now() - s.baseTicks;
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - s.baseTime).count());
+            if (ticks > 0) s.nsPerTick.store(ns / static_cast<double>(ticks), std::memory_order_relaxed);
+#endif
+        });
+    }
+
+    void RefineCalibration(ProfilerState& s) {
+#if RTGC_PROFILER_TSC
+        auto now = std::chrono::steady_clock::now();
+        uint64_t ticks = Profiler::Now() - s.baseTicks;
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - s.baseTime).count());
+        if (ns > 1e8 && ticks > 0) s.nsPerTick.store(ns / static_cast<double>(ticks), std::memory_order_relaxed);
+#else
+        (void)s;
+#endif
+    }
+
+    thread_local ThreadBuffer* currentBuffer = nullptr;
+
+    // Держит буфер до конца потока; после выхода EndFrame дочитает и удалит его
+    struct ThreadHandle {
+        std::shared_ptr<ThreadBuffer> buffer;
+        ~ThreadHandle() {
+            if (buffer) buffer->alive.store(false, std::memory_order_release);
+            currentBuffer = nullptr;
+        }
+    };
+    thread_local ThreadHandle threadHandle;
+
+    ThreadBuffer* RegisterThread() {
+        ProfilerState& s = GetState();
+        auto buffer = std::make_shared<ThreadBuffer>();
+        {
+            std::lock_guard<std::mutex> lock(s.registryMutex);
+            buffer->index = s.nextThreadIndex++;
+            buffer->name = "Поток " + std::to_string(buffer->index);
+            s.threads.push_back(buffer);
+        }
+        threadHandle.buffer = buffer;
+        currentBuffer = buffer.get();
+        return currentBuffer;
+    }
+
+    struct FrameNode {
+        uint16_t zone;
+        int parent;
+        uint64_t totalTicks = 0;
+        uint64_t count = 0;
+        std::vector<int> children;
+    };
+
+    void AppendTree(std::string& out, const std::vector<FrameNode>& nodes, int node, int indent,
+                    double frameMs, double msPerTick) {
+        std::vector<int> children = nodes[node].children;
+        std::sort(children.begin(), children.end(), [&](int a, int b) {
+            return nodes[a].totalTicks > nodes[b].totalTicks;
+        });
+        char line[256];
+        for (int child : children) {
+            const FrameNode& n = nodes[child];
+            double ms = static_cast<double>(n.totalTicks) * msPerTick;
+            std::snprintf(line, sizeof(line), "%*s%s: %.3f мс (%.1f%%), x%llu\n", indent * 2, "",
+                          Profiler::GetZoneName(n.zone), ms, frameMs > 0.0 ? ms * 100.0 / frameMs : 0.0,
+                          static_cast<unsigned long long>(n.count));
+            out += line;
+            AppendTree(out, nodes, child, indent + 1, frameMs, msPerTick);
+        }
+    }
+
+    // Окно кадров уходит в пул потоков, поток кадра продолжает без ожидания диска
+    void SubmitCapture(ProfilerState& s) {
+        auto capture = std::make_shared<TraceCapture>();
+        capture->frameThread = s.frameBuffer ? s.frameBuffer->index : 0;
+        capture->nsPerTick = s.nsPerTick.load(std::memory_order_relaxed);
+        size_t eventCount = 0;
+        for (const CapturedFrame& frame : s.captureFrames) eventCount += frame.events.size();
+        capture->events.reserve(eventCount);
+        for (const CapturedFrame& frame : s.captureFrames) {
+            capture->frames.push_back(TraceCapture::Frame{frame.index, frame.start, frame.end});
+            capture->events.insert(capture->events.end(), frame.events.begin(), frame.events.end());
+        }
+        for (const auto& thread : s.captureThreadNames) {
+            capture->threads.push_back(TraceCapture::Thread{thread.first, thread.second});
+        }
+        s.captureFrames.clear();
+        s.captureThreadNames.clear();
+
+        std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        char path[96];
+        size_t length = std::strftime(path, sizeof(path), "logs/trace_%Y%m%d_%H%M%S", &tm);
+        std::snprintf(path + length, sizeof(path) - length, "_f%llu.json",
+                      static_cast<unsigned long long>(capture->frames.empty() ? 0 : capture->frames.back().index));
+
+        std::string file = path;
+        ThreadPool::Global().Submit([capture, file]() {
+            if (WriteChromeTrace(file, *capture)) {
+                LOG_INFO(Core, "Трасса профайлера записана: ", file, " (кадров ", capture->frames.size(),
+                         ", зон ", capture->events.size(), ")");
+            } else {
+                LOG_WARNING(Core, "Не удалось записать трассу профайлера ", file);
+            }
+        });
+    }
+}
+
+uint16_t Profiler::RegisterZone(const char* name, const char* file, int line) {
+    ProfilerState& s = GetState();
+    EnsureCalibrated(s);
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    uint16_t id = s.zoneCount.load(std::memory_order_relaxed);
+    if (id >= MAX_ZONES) {
+        Logger::Warning("Профайлер: превышено число зон (", MAX_ZONES, "), зона ", name, " объединена с последней");
+        return MAX_ZONES - 1;
+    }
+    s.zones[id] = ZoneInfo{name, file, line};
+    s.zoneCount.store(static_cast<uint16_t>(id + 1), std::memory_order_release);
+    return id;
+}
+
+const char* Profiler::GetZoneName(uint16_t zone) {
+    ProfilerState& s = GetState();
+    if (zone >= s.zoneCount.load(std::memory_order_acquire)) return "?";
+    return s.zones[zone].name;
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ThreadBuffer* buffer = currentBuffer ? currentBuffer : RegisterThread();
+    ProfilerState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    buffer->name = name;
+}
+
+void Profiler::Record(uint16_t zone, uint16_t zoneDepth, uint64_t start, uint64_t end) {
+    ThreadBuffer* buffer = currentBuffer;
+    if (!buffer) buffer = RegisterThread();
+    size_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) >= BUFFER_CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[head & BUFFER_MASK] = ZoneEvent{start, end, zone, zoneDepth};
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::BeginFrame() {
+    ProfilerState& s = GetState();
+    EnsureCalibrated(s);
+    if (!currentBuffer) RegisterThread();
+    s.frameBuffer = currentBuffer;
+    s.frameStart = Now();
+}
+
+void Profiler::EndFrame() {
+    ProfilerState& s = GetState();
+    uint64_t frameEnd = Now();
+    RefineCalibration(s);
+    double nsPerTick = s.nsPerTick.load(std::memory_order_relaxed);
+
+    s.frameEvents.clear();
+    int request = s.captureRequest.exchange(0, std::memory_order_acq_rel);
+    if (request > 0) {
+        s.captureFrames.clear();
+        s.captureRemaining = request;
+    }
+    int autoWindow = s.autoWindow.load(std::memory_order_relaxed);
+    CapturedFrame* captured = nullptr;
+    if (s.captureRemaining > 0 || autoWindow > 0) {
+        s.captureFrames.push_back(CapturedFrame{s.frameIndex, s.frameStart, frameEnd, {}});
+        captured = &s.captureFrames.back();
+    }
+
+    std::vector<OtherThreadZone> others;
+    std::vector<ThreadBuffer*> retired;
+    {
+        std::lock_guard<std::mutex> registryLock(s.registryMutex);
+        std::lock_guard<std::mutex> statsLock(s.statsMutex);
+        if (s.accum.size() < s.zoneCount.load(std::memory_order_relaxed)) {
+            s.accum.resize(s.zoneCount.load(std::memory_order_relaxed));
+        }
+
+        for (auto& buffer : s.threads) {
+            bool alive = buffer->alive.load(std::memory_order_acquire);
+            size_t head = buffer->head.load(std::memory_order_acquire);
+            size_t tail = buffer->tail.load(std::memory_order_relaxed);
+            bool isFrameThread = buffer.get() == s.frameBuffer;
+            if (captured && tail != head) s.captureThreadNames[buffer->index] = buffer->name;
+            for (; tail != head; ++tail) {
+                const ZoneEvent& e = buffer->events[tail & BUFFER_MASK];
+                uint64_t ns = static_cast<uint64_t>(static_cast<double>(e.end - e.start) * nsPerTick);
+                ZoneAccum& a = s.accum[e.zone];
+                ++a.count;
+                a.totalNs += ns;
+                a.minNs = std::min(a.minNs, ns);
+                a.maxNs = std::max(a.maxNs, ns);
+                a.histogram.Add(ns);
+                if (captured) captured->events.push_back(TraceCapture::Event{e.start, e.end, buffer->index, e.zone});
+
+                if (isFrameThread) {
+                    s.frameEvents.push_back(e);
+                } else if (e.depth == 0) {
+                    auto it = std::find_if(others.begin(), others.end(), [&](const OtherThreadZone& o) {
+                        return o.thread == buffer->index && o.zone == e.zone;
+                    });
+                    if (it == others.end()) {
+                        others.push_back(OtherThreadZone{buffer->index, e.zone, e.end - e.start, 1});
+                    } else {
+                        it->totalNs += e.end - e.start;
+                        ++it->count;
+                    }
+                }
+            }
+            buffer->tail.store(tail, std::memory_order_release);
+            if (!alive) {
+                // alive прочитан до head: поток уже ничего не запишет, счётчик потерь окончательный
+                s.retiredDropped += buffer->dropped.load(std::memory_order_relaxed);
+                retired.push_back(buffer.get());
+            }
+        }
+        // Поток завершился раньше, чем мы прочитали его буфер, - всё прочитано, буфер больше не нужен
+        s.threads.erase(std::remove_if(s.threads.begin(), s.threads.end(), [&](const std::shared_ptr<ThreadBuffer>& b) {
+            return std::find(retired.begin(), retired.end(), b.get()) != retired.end();
+        }), s.threads.end());
+    }
+
+    s.lastFrameStart = s.frameStart;
+    s.lastFrameEnd = frameEnd;
+    s.lastFrameEvents.swap(s.frameEvents);
+    s.lastOtherThreads.swap(others);
+
+    if (captured) {
+        if (s.captureRemaining > 0) {
+            if (--s.captureRemaining == 0) SubmitCapture(s);
+        } else {
+            while (s.captureFrames.size() > static_cast<size_t>(autoWindow)) s.captureFrames.pop_front();
+            double frameMs = static_cast<double>(frameEnd - s.frameStart) * nsPerTick / 1e6;
+            double threshold = s.autoThresholdMs.load(std::memory_order_relaxed);
+            if (threshold > 0.0 && frameMs > threshold && s.frameIndex >= s.autoCooldownUntil) {
+                LOG_INFO(Core, "Кадр ", s.frameIndex, " занял ", frameMs, " мс (порог ", threshold,
+                         " мс), сохраняем трассу последних ", s.captureFrames.size(), " кадров");
+                s.autoCooldownUntil = s.frameIndex + static_cast<uint64_t>(autoWindow);
+                SubmitCapture(s);
+            }
+        }
+    }
+    ++s.frameIndex;
+
+    if (s.reportInterval > 0 && s.frameIndex % static_cast<uint64_t>(s.reportInterval) == 0) {
+        LOG_DEBUG(Core, "Профиль кадра:\n", GetFrameReport());
+    }
+}
+
+uint64_t Profiler::GetFrameIndex() {
+    return GetState().frameIndex;
+}
+
+double Profiler::TicksToMs(uint64_t ticks) {
+    return static_cast<double>(ticks) * GetState().nsPerTick.load(std::memory_order_relaxed) / 1e6;
+}
+
+std::vector<Profiler::ZoneStats> Profiler::GetZoneStats() {
+    ProfilerState& s = GetState();
+    std::vector<ZoneStats> result;
+    std::lock_guard<std::mutex> lock(s.statsMutex);
+    for (size_t zone = 0; zone < s.accum.size(); ++zone) {
+        const ZoneAccum& a = s.accum[zone];
+        if (a.count == 0) continue;
+        const ZoneInfo& info = s.zones[zone];
+        ZoneStats stats;
+        stats.name = info.name;
+        stats.file = info.file;
+        stats.line = info.line;
+        stats.count = a.count;
+        stats.minMs = static_cast<double>(a.minNs) / 1e6;
+        stats.maxMs = static_cast<double>(a.maxNs) / 1e6;
+        stats.totalMs = static_cast<double>(a.totalNs) / 1e6;
+        stats.avgMs = stats.totalMs / static_cast<double>(a.count);
+        stats.p99Ms = static_cast<double>(std::min(a.histogram.Percentile(0.99, a.count), a.maxNs)) / 1e6;
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const ZoneStats& a, const ZoneStats& b) {
+        return a.totalMs > b.totalMs;
+    });
+    return result;
 }
 
-void Profiler::EndSample(const std::string& name) {
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - data[name].start).count();
-    data[name].totalTime += duration;
-    data[name].callCount++;
+void Profiler::ResetStats() {
+    ProfilerState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.statsMutex);
+    for (ZoneAccum& a : s.accum) a = ZoneAccum();
+}
+
+std::string Profiler::GetFrameReport() {
+    ProfilerState& s = GetState();
+    double msPerTick = s.nsPerTick.load(std::memory_order_relaxed) / 1e6;
+    double frameMs = static_cast<double>(s.lastFrameEnd - s.lastFrameStart) * msPerTick;
+
+    // Дерево по вложенности: повторные вызовы одной зоны под одним родителем сливаются
+    std::vector<ZoneEvent> events = s.lastFrameEvents;
+    std::sort(events.begin(), events.end(), [](const ZoneEvent& a, const ZoneEvent& b) {
+        return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+    });
+    std::vector<FrameNode> nodes(1);
+    nodes[0].zone = 0;
+    nodes[0].parent = -1;
+    std::vector<int> stack;
+    uint64_t topLevelTicks = 0;
+    for (const ZoneEvent& e : events) {
+        if (stack.size() > e.depth) stack.resize(e.depth);
+        int parent = stack.empty() ? 0 : stack.back();
+        if (e.depth > stack.size()) parent = 0; // родитель начался до кадра
+        int node = -1;
+        for (int child : nodes[parent].children) {
+            if (nodes[child].zone == e.zone) {
+                node = child;
+                break;
+            }
+        }
+        if (node < 0) {
+            node = static_cast<int>(nodes.size());
+            FrameNode n;
+            n.zone = e.zone;
+            n.parent = parent;
+            nodes.push_back(n);
+            nodes[parent].children.push_back(node);
+        }
+        nodes[node].totalTicks += e.end - e.start;
+        ++nodes[node].count;
+        if (parent == 0) topLevelTicks += e.end - e.start;
+        stack.push_back(node);
+    }
+
+    std::string out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "Кадр #%llu: %.3f мс\n", static_cast<unsigned long long>(s.frameIndex), frameMs);
+    out += line;
+    AppendTree(out, nodes, 0, 1, frameMs, msPerTick);
+    double untracked = frameMs - static_cast<double>(topLevelTicks) * msPerTick;
+    if (untracked > 0.0) {
+        std::snprintf(line, sizeof(line), "  (вне зон): %.3f мс\n", untracked);
+        out += line;
+    }
+
+    if (!s.lastOtherThreads.empty()) {
+        out += "Другие потоки:\n";
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        for (const OtherThreadZone& o : s.lastOtherThreads) {
+            std::string threadName = "Поток " + std::to_string(o.thread);
+            for (const auto& buffer : s.threads) {
+                if (buffer->index == o.thread) threadName = buffer->name;
+            }
+            std::snprintf(line, sizeof(line), "  [%s] %s: %.3f мс, x%llu\n", threadName.c_str(),
+                          s.zones[o.zone].name, static_cast<double>(o.totalNs) * msPerTick,
+                          static_cast<unsigned long long>(o.count));
+            out += line;
+        }
+    }
+    return out;
 }
 
 void Profiler::PrintResults() {
-    for (const auto& [name, data] : data) {
-        if (data.callCount > 0) {
-            long long avgTime = data.totalTime / data.callCount;
-            LOG(L"Профиль [" + std::wstring(name.begin(), name.end()) + L"]: " +
-                std::to_wstring(avgTime) + L" мкс (среднее), " +
-                std::to_wstring(data.callCount) + L" вызовов");
+    for (const ZoneStats& z : GetZoneStats()) {
+        Logger::Log("Профиль [", z.name, "]: вызовов ", z.count, ", мин ", z.minMs, " мс, сред ", z.avgMs,
+                    " мс, макс ", z.maxMs, " мс, p99 ", z.p99Ms, " мс");
+    }
+    uint64_t dropped = GetDroppedEvents();
+    if (dropped > 0) Logger::Warning("Профайлер: потеряно событий (буфер потока переполнен): ", dropped);
+}
+
+void Profiler::SetReportInterval(int frames) {
+    GetState().reportInterval = frames;
+}
+
+void Profiler::StartCapture(int frames) {
+    if (frames <= 0) return;
+    GetState().captureRequest.store(frames, std::memory_order_release);
+    LOG_INFO(Core, "Профайлер: запись трассы ", frames, " кадров");
+}
+
+void Profiler::SetAutoCapture(double thresholdMs, int frames) {
+    ProfilerState& s = GetState();
+    bool on = thresholdMs > 0.0 && frames > 0;
+    s.autoThresholdMs.store(on ? thresholdMs : 0.0, std::memory_order_relaxed);
+    s.autoWindow.store(on ? frames : 0, std::memory_order_relaxed);
+}
+
+bool Profiler::IsCapturing() {
+    ProfilerState& s = GetState();
+    return s.captureRemaining > 0 || s.captureRequest.load(std::memory_order_relaxed) > 0;
+}
+
+void Profiler::ParseCommandLine(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--profile-capture") == 0) {
+            StartCapture();
+        } else if (std::strncmp(arg, "--profile-capture=", 18) == 0) {
+            StartCapture(std::atoi(arg + 18));
+        } else if (std::strncmp(arg, "--profile-auto=", 15) == 0) {
+            char* rest = nullptr;
+            double thresholdMs = std::strtod(arg + 15, &rest);
+            int frames = (rest && *rest == ':') ? std::atoi(rest + 1) : DEFAULT_CAPTURE_FRAMES;
+            SetAutoCapture(thresholdMs, frames);
+            LOG_INFO(Core, "Профайлер: автозапись трассы при кадре дольше ", thresholdMs, " мс, окно ", frames, " кадров");
+        } else if (std::strncmp(arg, "--profile-report=", 17) == 0) {
+            SetReportInterval(std::atoi(arg + 17));
         }
     }
+}
+
+uint64_t Profiler::GetDroppedEvents() {
+    ProfilerState& s = GetState();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    uint64_t total = s.retiredDropped;
+    for (const auto& buffer : s.threads) total += buffer->dropped.load(std::memory_order_relaxed);
+    return total;
 }
\ No newline at end of file
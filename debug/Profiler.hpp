@@ -1,18 +1,138 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <atomic>
 #include <chrono>
-#include <unordered_map>
+#include <cstdint>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define RTGC_PROFILER_TSC 1
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define RTGC_PROFILER_TSC 1
+#else
+#define RTGC_PROFILER_TSC 0
+#endif
+
+// Иерархический профайлер с учётом потоков.
+// Зона - RAII-объект с заранее зарегистрированным id (PROFILE_ZONE), без строк и хэшей на вызове.
+// Каждый поток пишет завершённые зоны в свой lock-free буфер (один писатель, один читатель),
+// EndFrame на главном потоке забирает их, считает min/avg/max/p99 по зонам и строит дерево кадра.
 class Profiler {
-    struct ProfileData {
-        std::chrono::high_resolution_clock::time_point start;
-        long long totalTime = 0;
-        int callCount = 0;
+public:
+    struct ZoneEvent {
+        uint64_t start; // такты Now()
+        uint64_t end;
+        uint16_t zone;
+        uint16_t depth; // вложенность в своём потоке
     };
-    std::unordered_map<std::string, ProfileData> data;
 
-public:
-    void BeginSample(const std::string& name);
-    void EndSample(const std::string& name);
-    void PrintResults();
-};
\ No newline at end of file
+    struct ZoneStats {
+        const char* name;
+        const char* file;
+        int line;
+        uint64_t count;
+        double minMs;
+        double avgMs;
+        double maxMs;
+        double p99Ms;
+        double totalMs;
+    };
+
+    static constexpr uint16_t MAX_ZONES = 4096;
+
+    static uint16_t RegisterZone(const char* name, const char* file, int line);
+    static const char* GetZoneName(uint16_t zone);
+
+    static void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+    static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    // Имя потока для отчётов и трасс; вызывать из самого потока
+    static void SetThreadName(const char* name);
+
+    // Границы кадра главного цикла; вызываются из одного потока
+    static void BeginFrame();
+    static void EndFrame();
+    static uint64_t GetFrameIndex();
+
+    // Статистика по зонам с последнего ResetStats
+    static std::vector<ZoneStats> GetZoneStats();
+    static void ResetStats();
+    // Дерево последнего кадра потока, вызывающего BeginFrame/EndFrame, и итоги остальных потоков
+    static std::string GetFrameReport();
+    // Таблица статистики в лог
+    static void PrintResults();
+    // Раз в N кадров писать дерево кадра в лог (0 - не писать)
+    static void SetReportInterval(int frames);
+
+    // Потери с запуска по всем потокам, включая завершившиеся
+    static uint64_t GetDroppedEvents();
+
+    // Трасса для просмотра на временной шкале (Chrome Trace JSON, см. ProfilerTrace.hpp),
+    // пишется в logs/trace_*.json в фоне. Запрос из любого потока, начнётся с текущего кадра.
+    static constexpr int DEFAULT_CAPTURE_FRAMES = 120;
+    static void StartCapture(int frames = DEFAULT_CAPTURE_FRAMES);
+    // Кадр дольше thresholdMs сбрасывает в трассу последние frames кадров вместе с ним.
+    // Следующий сброс - не раньше чем через frames кадров. thresholdMs <= 0 выключает.
+    static void SetAutoCapture(double thresholdMs, int frames = DEFAULT_CAPTURE_FRAMES);
+    // Идёт ручная запись; вызывать из потока кадра
+    static bool IsCapturing();
+    // Ключи профайлера: --profile-capture[=кадров], --profile-auto=мс[:кадров], --profile-report=кадров.
+    // Остальные аргументы пропускаются.
+    static void ParseCommandLine(int argc, char** argv);
+
+    static uint64_t Now() {
+#if RTGC_PROFILER_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    static double TicksToMs(uint64_t ticks);
+
+    class ScopedZone {
+        uint64_t start;
+        uint16_t zone;
+        bool active;
+
+    public:
+        explicit ScopedZone(uint16_t zoneId) : start(0), zone(zoneId), active(IsEnabled()) {
+            if (active) {
+                ++depth;
+                start = Now();
+            }
+        }
+        ~ScopedZone() {
+            if (active) {
+                uint64_t end = Now();
+                --depth;
+                Record(zone, depth, start, end);
+            }
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+    };
+
+private:
+    static std::atomic<bool> enabled;
+    static thread_local uint16_t depth;
+
+    static void Record(uint16_t zone, uint16_t zoneDepth, uint64_t start, uint64_t end);
+};
+
+#define RTGC_PROFILE_CONCAT2(a, b) a##b
+#define RTGC_PROFILE_CONCAT(a, b) RTGC_PROFILE_CONCAT2(a, b)
+
+#ifndef RTGC_DISABLE_PROFILER
+// id регистрируется один раз (статическая переменная), дальше зона стоит два чтения таймера
+#define PROFILE_ZONE(name) \
+    static const uint16_t RTGC_PROFILE_CONCAT(rtgcZoneId_, __LINE__) = Profiler::RegisterZone(name, __FILE__, __LINE__); \
+    Profiler::ScopedZone RTGC_PROFILE_CONCAT(rtgcZone_, __LINE__)(RTGC_PROFILE_CONCAT(rtgcZoneId_, __LINE__))
+#else
+#define PROFILE_ZONE(name) do {} while (0)
+#endif
+
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
\ No newline at end of file
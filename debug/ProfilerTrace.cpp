@@ -0,0 +1,64 @@
+#include "ProfilerTrace.hpp"
+#include "Profiler.hpp"
+#include <cstdio>
+
+namespace {
+    // Дорожка кадров в том же процессе, чтобы не путалась с потоками
+    constexpr uint32_t FRAME_TRACK = 0;
+
+    void WriteEscaped(std::FILE* f, const char* s) {
+        for (; *s; ++s) {
+            unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') {
+                std::fputc('\\', f);
+                std::fputc(c, f);
+            } else if (c < 0x20) {
+                std::fprintf(f, "\\u%04x", c);
+            } else {
+                std::fputc(c, f);
+            }
+        }
+    }
+
+    void WriteThreadName(std::FILE* f, uint32_t tid, const char* name, int sortIndex) {
+        std::fprintf(f, ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"", tid);
+        WriteEscaped(f, name);
+        std::fprintf(f, "\"}},\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%d}}",
+                     tid, sortIndex);
+    }
+}
+
+bool WriteChromeTrace(const std::string& path, const TraceCapture& capture) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    uint64_t base = capture.frames.empty() ? 0 : capture.frames.front().start;
+    for (const TraceCapture::Event& e : capture.events) {
+        if (e.start < base) base = e.start;
+    }
+    double usPerTick = capture.nsPerTick / 1000.0;
+    auto toUs = [&](uint64_t ticks) { return static_cast<double>(ticks - base) * usPerTick; };
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"RTGC\"}}");
+    WriteThreadName(f, FRAME_TRACK, "Кадры", -1);
+    for (const TraceCapture::Thread& t : capture.threads) {
+        WriteThreadName(f, t.index, t.name.c_str(), t.index == capture.frameThread ? 0 : static_cast<int>(t.index));
+    }
+
+    for (const TraceCapture::Frame& frame : capture.frames) {
+        std::fprintf(f, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"cat\":\"frame\",\"name\":\"Кадр %llu\",\"ts\":%.3f,\"dur\":%.3f}",
+                     FRAME_TRACK, static_cast<unsigned long long>(frame.index), toUs(frame.start),
+                     static_cast<double>(frame.end - frame.start) * usPerTick);
+    }
+
+    for (const TraceCapture::Event& e : capture.events) {
+        std::fprintf(f, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"cat\":\"zone\",\"name\":\"", e.thread);
+        WriteEscaped(f, Profiler::GetZoneName(e.zone));
+        std::fprintf(f, "\",\"ts\":%.3f,\"dur\":%.3f}", toUs(e.start), static_cast<double>(e.end - e.start) * usPerTick);
+    }
+
+    std::fprintf(f, "\n]}\n");
+    bool ok = std::ferror(f) == 0;
+    return std::fclose(f) == 0 && ok;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Снимок зон за окно кадров для просмотра на временной шкале.
+// Собирает Profiler (StartCapture / SetAutoCapture), пишет WriteChromeTrace.
+struct TraceCapture {
+    struct Event {
+        uint64_t start; // такты Profiler::Now()
+        uint64_t end;
+        uint32_t thread;
+        uint16_t zone;
+    };
+
+    struct Frame {
+        uint64_t index;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    struct Thread {
+        uint32_t index;
+        std::string name;
+    };
+
+    std::vector<Event> events;
+    std::vector<Frame> frames;
+    std::vector<Thread> threads;
+    uint32_t frameThread = 0;
+    double nsPerTick = 1.0;
+};
+
+// Chrome Trace Event JSON: открывается в chrome://tracing и ui.perfetto.dev.
+// Зоны - полные события ("X") по потокам, кадры - отдельная дорожка "Кадры" с номером
+// и длительностью, имена потоков - метаданные thread_name. Время отсчитывается от начала окна.
+bool WriteChromeTrace(const std::string& path, const TraceCapture& capture);
\ No newline at end of file
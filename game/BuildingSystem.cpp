@@ -9,12 +9,12 @@ void BuildingSystem::Place(const glm::vec3& pos, const std::string& type, uint32
     shape->release();
     PhysXInitializer::gScene->addActor(*body);
     physicsBodies.push_back(body);
-    LOG(L"Объект построен и добавлен в физику");
+    LOG_INFO(Game, "Объект построен и добавлен в физику");
 }
 
 void BuildingSystem::InteractWith(Buildable& obj) {
     if (obj.type == "container") {
-        LOG(L"Открыт контейнер");
+        LOG_INFO(Game, "Открыт контейнер");
     }
 }
 
@@ -27,4 +27,8 @@ void BuildingSystem::Clear() {
     objects.clear();
 }
 
+void BuildingSystem::ShiftOrigin(const Vector3& shift) {
+    for (auto& obj : objects) obj.position -= glm::vec3(shift.x, shift.y, shift.z);
+}
+
 const std::vector<Buildable>& BuildingSystem::GetObjects() const { return objects; }
\ No newline at end of file
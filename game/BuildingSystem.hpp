@@ -4,6 +4,7 @@
 #include <string>
 #include <PhysX/PxPhysicsAPI.h>
 #include "../core/Logger.hpp"
+#include "../math/Vector3.hpp"
 using namespace physx;
 
 struct Buildable {
@@ -19,5 +20,7 @@ public:
     void Place(const glm::vec3& pos, const std::string& type, uint32_t owner = 0);
     void InteractWith(Buildable& obj);
     void Clear();
+    // Перенос начала координат (WorldOrigin): тела PhysX сдвигает сцена, здесь - сохраняемые позиции
+    void ShiftOrigin(const Vector3& shift);
     const std::vector<Buildable>& GetObjects() const;
 };
\ No newline at end of file
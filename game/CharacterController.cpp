@@ -1,21 +1,74 @@
 #include "CharacterController.hpp"
 #include "../core/Logger.hpp"
+#include "../world/Terrain.hpp"
+#include <cmath>
 
-CharacterController::CharacterController() : position(0.0f, 10.0f, 0.0f), velocity(0.0f, 0.0f, 0.0f) {}
+CharacterController::CharacterController() : position(0.0f, 10.0f, 0.0f), velocity(0.0f, 0.0f, 0.0f), groundNormal(0.0f, 1.0f, 0.0f) {}
 
 void CharacterController::Initialize() {
     Logger::Log("CharacterController инициализирован");
 }
 
+float CharacterController::GetGroundHeight(float x, float z) const {
+    return terrain ? terrain->GetHeightAt(x, z) : 0.0f;
+}
+
+Vector3 CharacterController::GetGroundNormal(float x, float z) const {
+    return terrain ? terrain->GetNormalAt(x, z) : Vector3(0.0f, 1.0f, 0.0f);
+}
+
+bool CharacterController::IsWalkable(const Vector3& normal) const {
+    // Нормаль единичная, поэтому её y - косинус угла наклона
+    return normal.y >= std::cos(maxSlopeAngle * 3.14159265f / 180.0f);
+}
+
 void CharacterController::Update(float dt) {
-    position += velocity * dt;
-    
-    // Простая гравитация
-    if (position.y > 0.0f) {
-        velocity.y -= 9.81f * dt;
+    if (onGround) {
+        float nextX = position.x + velocity.x * dt;
+        float nextZ = position.z + velocity.z * dt;
+
+        // Склон круче допустимого блокирует горизонтальное движение вверх
+        if (GetGroundHeight(nextX, nextZ) > position.y && !IsWalkable(GetGroundNormal(nextX, nextZ))) {
+            nextX = position.x;
+            nextZ = position.z;
+        }
+        position.x = nextX;
+        position.z = nextZ;
+
+        float ground = GetGroundHeight(position.x, position.z);
+        groundNormal = GetGroundNormal(position.x, position.z);
+        if (position.y - ground > stepHeight) {
+            // Сошли с уступа: дальше падаем, горизонтальный шаг этого кадра уже сделан
+            onGround = false;
+            velocity.y -= 9.81f * dt;
+            position.y += velocity.y * dt;
+        } else if (!IsWalkable(groundNormal)) {
+            // Слишком крутой склон: соскальзываем вдоль поверхности
+            Vector3 gravity(0.0f, -9.81f, 0.0f);
+            Vector3 slide = gravity - groundNormal * gravity.Dot(groundNormal);
+            velocity += slide * dt;
+            position.x += velocity.x * dt;
+            position.z += velocity.z * dt;
+            position.y = GetGroundHeight(position.x, position.z);
+            velocity.y = 0.0f;
+        } else {
+            // Спуск и подъём в пределах ступеньки: прилипаем к земле
+            position.y = ground;
+            velocity.y = 0.0f;
+        }
     } else {
-        position.y = 0.0f;
+        // Простая гравитация
+        velocity.y -= 9.81f * dt;
+        position += velocity * dt;
+    }
+
+    // Проверка приземления
+    float ground = GetGroundHeight(position.x, position.z);
+    if (!onGround && position.y <= ground) {
+        position.y = ground;
         velocity.y = 0.0f;
+        groundNormal = GetGroundNormal(position.x, position.z);
+        onGround = true;
     }
 }
 
@@ -35,4 +88,5 @@ Vector3 CharacterController::GetPosition() const {
 void CharacterController::SetPosition(const Vector3& pos) {
     position = pos;
     velocity = Vector3(0.0f, 0.0f, 0.0f);
+    onGround = (position.y <= GetGroundHeight(position.x, position.z) + 0.01f);
 }
@@ -1,11 +1,22 @@
 #pragma once
 #include "../math/Vector3.hpp"
 
+class Terrain;
+
 class CharacterController {
 private:
     Vector3 position;
     Vector3 velocity;
+    Vector3 groundNormal;
     float speed = 5.0f;
+    float maxSlopeAngle = 45.0f; // градусы
+    float stepHeight = 0.3f; // на таком перепаде вниз персонаж прилипает к земле, а не падает
+    bool onGround = false;
+    const Terrain* terrain = nullptr;
+    
+    float GetGroundHeight(float x, float z) const;
+    Vector3 GetGroundNormal(float x, float z) const;
+    bool IsWalkable(const Vector3& normal) const;
     
 public:
     CharacterController();
@@ -15,4 +26,10 @@ public:
     void Shutdown();
     Vector3 GetPosition() const;
     void SetPosition(const Vector3& pos);
+    
+    // Без ландшафта землёй считается плоскость y=0
+    void SetTerrain(const Terrain* t) { terrain = t; }
+    void SetMaxSlopeAngle(float degrees) { maxSlopeAngle = degrees; }
+    Vector3 GetGroundNormal() const { return groundNormal; }
+    bool IsOnGround() const { return onGround; }
 };
@@ -1,28 +1,63 @@
 #include "GameLevel.hpp"
+#include "../core/Logger.hpp"
 #include "../physics/PhysXInitializer.hpp"
+#include "../physics/PhysicsUpdateSystem.hpp"
+#include "../systems/TransformSystem.hpp"
 
 GameLevel::GameLevel() : terrain(PhysXInitializer::gPhysics, PhysXInitializer::gMaterial) {
     auto vehicleType = VehicleFactory::CreateKamaz();
     // ИСПРАВЛЕНО: передаём playerId при создании транспорта
-    vehicle = new Vehicle(PhysXInitializer::gPhysics, PhysXInitializer::gMaterial, vehicleType, PxVec3(0, 10, 0), 1);
+    vehicles = std::make_unique<VehicleManager>(PhysXInitializer::gScene, PhysXInitializer::gMaterial);
+    PhysicsUpdateSystem::SetVehicleManager(vehicles.get());
+    vehicle = vehicles->CreateVehicle(PhysXInitializer::gPhysics, PhysXInitializer::gMaterial, vehicleType, PxVec3(0, 10, 0), 1);
     characterController = new CharacterController(PhysXInitializer::gScene, PhysXInitializer::gPhysics, PhysXInitializer::gMaterial);
     player = ecs.registry.create();
     // ИСПРАВЛЕНО: устанавливаем playerId в компоненте
     ecs.registry.emplace<VehicleComponent>(player, VehicleComponent{vehicle, true, 1});
     playerCharacter = ecs.registry.create();
     ecs.registry.emplace<CharacterComponent>(playerCharacter, CharacterComponent{});
-    LOG(L"Уровень загружен");
+    autosave.Start(300.0f, "save/autosave.dat");
+    // Перенос начала координат: сцена PhysX (актёры, транспорт), корневые сущности ECS
+    // и позиции построек, которые пишутся в сохранение
+    originListener = WorldOrigin::AddListener([this](const Vector3& shift) {
+        PhysicsUpdateSystem::ShiftOrigin(shift);
+        TransformSystem::ShiftOrigin(ecs.registry, shift);
+        buildings.ShiftOrigin(shift);
+        if (characterController) characterController->ShiftOrigin(shift);
+    });
+    LOG_INFO(Game, "Уровень загружен");
 }
 
 void GameLevel::Update(float dt) {
+    // Перенос начала - между шагами PhysX, до захвата автосохранения.
+    // Фокус - активный игрок: транспорт за рулём, иначе персонаж пешком.
+    const CharacterComponent* character = ecs.registry.try_get<CharacterComponent>(playerCharacter);
+    bool driving = !character || character->inVehicle;
+    if (driving && vehicle && vehicle->mActor) {
+        const physx::PxVec3 p = vehicle->mActor->getGlobalPose().p;
+        WorldOrigin::Update(Vector3(p.x, p.y, p.z));
+    } else if (characterController) {
+        WorldOrigin::Update(characterController->GetPosition());
+    }
+    // Захват для автосохранения - пока сцена PhysX не считает шаг
+    autosave.Update(dt, *this, weather);
+    // PhysX считает шаг в своих потоках, пока обновляется остальное
+    PhysicsUpdateSystem::BeginSimulation(dt, ecs.registry);
+    weather.Update(dt);
     // Обновление объектов уровня
 }
 
 void GameLevel::Render() {
+    // Результаты физики нужны до отрисовки
+    PhysicsUpdateSystem::FetchResults();
     // Рендеринг объектов уровня
 }
 
 GameLevel::~GameLevel() {
-    delete vehicle;
+    // Ожидающее автосохранение дописывается: I/O-поток уровень уже не читает
+    autosave.Shutdown(true);
+    WorldOrigin::RemoveListener(originListener);
+    PhysicsUpdateSystem::FetchResults();
+    PhysicsUpdateSystem::SetVehicleManager(nullptr);
     delete characterController;
 }
\ No newline at end of file
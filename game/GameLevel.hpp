@@ -3,6 +3,7 @@
 #include "../components/CharacterComponent.hpp"
 #include "../components/RenderableComponent.hpp"
 #include "Vehicle.hpp"
+#include "VehicleManager.hpp"
 #include "VehicleFactory.hpp"
 #include "BuildingSystem.hpp"
 #include "Terrain.hpp"
@@ -11,19 +12,25 @@
 #include "WeatherSystem.hpp"
 #include "SpawnSystem.hpp"
 #include "../core/ECSManager.hpp"
+#include "../core/AutosaveService.hpp"
 #include "../physics/CharacterController.hpp"
+#include "../world/WorldOrigin.hpp"
+#include <memory>
 
 class GameLevel {
 public:
     ECSManager ecs;
-    Vehicle* vehicle = nullptr;
+    std::unique_ptr<VehicleManager> vehicles;
+    Vehicle* vehicle = nullptr; // принадлежит vehicles
     CharacterController* characterController = nullptr;
     BuildingSystem buildings;
     Terrain terrain;
     WeatherSystem weather;
     SpawnSystem spawnSystem;
+    AutosaveService autosave;
     entt::entity player;
     entt::entity playerCharacter;
+    int originListener = 0; // WorldOrigin::AddListener
 
     GameLevel();
     ~GameLevel();
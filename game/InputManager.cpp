@@ -1,4 +1,5 @@
 #include "InputManager.hpp"
+#include "../core/Replay.hpp"
 
 std::unordered_map<int, bool> InputManager::keys;
 std::unordered_map<std::string, int> InputManager::keyBindings;
@@ -51,5 +52,8 @@ bool InputManager::IsKeyPressed(const std::string& action) {
 }
 
 void InputManager::SetKeyState(int key, bool pressed) {
-    keys[key] = pressed;
+    bool& state = keys[key];
+    // Автоповтор нажатой клавиши в запись сессии не попадает
+    if (state != pressed) Replay::RecordKey(key, pressed);
+    state = pressed;
 }
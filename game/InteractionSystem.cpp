@@ -1,4 +1,5 @@
 #include "InteractionSystem.hpp"
+#include "../core/Logger.hpp"
 #include "BuildingSystem.hpp"
 #include "CharacterComponent.hpp"
 #include "Inventory.hpp" // Добавлено для ItemType
@@ -28,7 +29,7 @@ void InteractionSystem::Update(entt::registry& registry, BuildingSystem& buildin
         if (dist < 3.0f && InputManager::IsDown(GLFW_KEY_E)) {
             if (b.type == "container") {
                 charComp.inventory.Add(ItemType::Medkit, 1);
-                LOG(L"Взято: аптечка");
+                LOG_INFO(Game, "Взято: аптечка");
             }
         }
     }
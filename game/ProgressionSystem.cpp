@@ -13,12 +13,12 @@ void ProgressionSystem::LevelUp() {
     level++;
     skillPoints += 1; // +1 очко навыка за уровень
     experience = 0; // Сброс опыта
-    LOG(L"Новый уровень: " + std::to_wstring(level));
+    LOG_INFO(Game, "Новый уровень: ", level);
 }
 
 void ProgressionSystem::SpendSkillPoint(const std::string& skill) {
     if (skillPoints > 0) {
         skillPoints--;
-        LOG(L"Очко навыка потрачено на: " + std::wstring(skill.begin(), skill.end()));
+        LOG_INFO(Game, "Очко навыка потрачено на: ", skill);
     }
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 void QuestSystem::AddQuest(const Quest& quest) {
     quests.push_back(quest);
-    LOG(L"Квест добавлен: " + std::wstring(quest.name.begin(), quest.name.end()));
+    LOG_INFO(Game, "Квест добавлен: ", quest.name);
 }
 
 void QuestSystem::Update(float dt) {
@@ -24,6 +24,6 @@ void QuestSystem::CompleteQuest(int index) {
         if (quests[index].onCompleted) {
             quests[index].onCompleted();
         }
-        LOG(L"Квест завершён: " + std::wstring(quests[index].name.begin(), quests[index].name.end()));
+        LOG_INFO(Game, "Квест завершён: ", quests[index].name);
     }
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include "Vehicle.hpp"
+#include "../graphics/RenderableVehicle.hpp"
+#include "../core/MemoryTracker.hpp"
 #include <algorithm> // для std::min/std::max
+#include <cmath>
 
 Vehicle::Vehicle(PxPhysics* physics, PxMaterial* material, const VehicleType& vt, const PxVec3& pos, uint32_t playerId) : type(vt) {
     mActor = physics->createRigidDynamic(PxTransform(pos));
@@ -8,7 +11,7 @@ Vehicle::Vehicle(PxPhysics* physics, PxMaterial* material, const VehicleType& vt
     // --- НОВОЕ: Загрузка геометрии из файла ---
     std::vector<Mesh*> loadedMeshes = ModelLoader::LoadOBJ(type.modelFile);
     if (!loadedMeshes.empty()) {
-        renderableVehicle = new RenderableVehicle();
+        renderableVehicle = MemoryTracker::New<RenderableVehicle>(MemoryTag::Meshes);
         renderableVehicle->SetMeshes(loadedMeshes);
 
         // Создаём физическую геометрию из меша (упрощённо - используем bounding box)
@@ -54,7 +57,7 @@ Vehicle::Vehicle(PxPhysics* physics, PxMaterial* material, const VehicleType& vt
             break;
     }
     PhysXInitializer::gScene->addActor(*mActor);
-    LOG(L"Транспорт создан: " + std::wstring(type.name.begin(), type.name.end()));
+    LOG_INFO(Game, "Транспорт создан: ", type.name);
 }
 
 void Vehicle::Update(float dt) {
@@ -73,8 +76,14 @@ void Vehicle::Update(float dt) {
             auto* tank = reinterpret_cast<PxVehicleDriveTank*>(mVehicle);
             if (!tank) break;
             auto& dyn = tank->mDriveDynData;
-            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_LEFT_THROTTLE, throttle - steer);
-            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_RIGHT_THROTTLE, throttle + steer);
+            // Обороты двигателя - от газа, направление и поворот - тягой гусениц
+            float left = std::max(-1.0f, std::min(1.0f, throttle - steer));
+            float right = std::max(-1.0f, std::min(1.0f, throttle + steer));
+            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_ACCEL, std::max(std::fabs(left), std::fabs(right)));
+            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_THRUST_LEFT, left);
+            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_THRUST_RIGHT, right);
+            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_BRAKE_LEFT, brake);
+            dyn.setAnalogInput(PxVehicleDriveTankControl::eANALOG_INPUT_BRAKE_RIGHT, brake);
             break;
         }
         case VehicleDriveType::Helicopter:
@@ -135,14 +144,47 @@ void Vehicle::CreateWheeledVehicle(PxPhysics* physics) {
 }
 
 void Vehicle::CreateTrackedVehicle(PxPhysics* physics) {
-    auto* tank = PxVehicleDriveTank::allocate(PxVehicleDriveTankControlModel::eSPECIAL);
+    // Катки парами: чётные - левая гусеница, нечётные - правая; все ведущие
+    PxU32 wheelCount = static_cast<PxU32>(type.wheels.size());
+    if (wheelCount < 2 || wheelCount % 2 != 0 || wheelCount > PX_MAX_NB_WHEELS) {
+        LOG_WARNING(Game, "Гусеничный транспорт ", type.name, ": нужно чётное число катков, задано ", wheelCount);
+        return;
+    }
+    auto* tank = PxVehicleDriveTank::allocate(wheelCount);
     if (!tank) return;
-    LOG(L"Инициализация гусеничного транспорта не завершена");
+
+    PxVehicleWheelsSimData ws = PxVehicleWheelsSimData::allocate(wheelCount);
+    for (PxU32 i = 0; i < wheelCount; ++i) {
+        auto& w = type.wheels[i];
+        PxWheelData wd;
+        wd.mRadius = w.radius;
+        wd.mWidth = w.width;
+        wd.mMaxBrakeTorque = w.maxBrakeTorque;
+        ws.setWheelData(i, wd);
+
+        PxSuspensionData sd;
+        sd.mMaxCompression = 0.3f;
+        sd.mMaxDroop = 0.2f;
+        sd.mSpringStrength = 35000.0f;
+        ws.setSuspensionData(i, sd);
+
+        ws.setWheelCentreOffset(i, PxVec3(w.position.x, w.position.y, w.position.z));
+    }
+
+    PxVehicleDriveSimData ds;
+    PxVehicleEngineData ed;
+    ed.mPeakTorque = type.engineTorque;
+    ed.mMaxOmega = type.engineRPM;
+    ds.setEngineData(ed);
+
+    tank->setup(physics, mActor, ws, ds, wheelCount);
+    // Тяга гусениц в [-1, 1]: задний ход без переключения передач (см. Vehicle::Update)
+    tank->setDriveModel(PxVehicleDriveTankControlModel::eSPECIAL);
     mVehicle = tank;
 }
 
 void Vehicle::CreateHelicopter(PxPhysics* physics) {
-    LOG(L"Физика вертолёта требует кастомной реализации");
+    LOG_INFO(Game, "Физика вертолёта требует кастомной реализации");
 }
 
 Vehicle::~Vehicle() {
@@ -150,7 +192,7 @@ Vehicle::~Vehicle() {
         for (auto* mesh : renderableVehicle->meshes) {
             delete mesh; // Удаляем меш, созданный в ModelLoader
         }
-        delete renderableVehicle; // Удаляем RenderableVehicle
+        MemoryTracker::Delete(MemoryTag::Meshes, renderableVehicle); // Удаляем RenderableVehicle
     }
     if (mVehicle) {
         if (type.type == VehicleDriveType::Wheeled4WD) {
@@ -15,4 +15,13 @@ VehicleType VehicleFactory::CreateKamaz() {
     };
     v.modelFile = "assets/models/kamaz.obj"; // Путь к файлу
     return v;
+}
+
+bool VehicleFactory::CreateByName(const std::string& name, VehicleType& out) {
+    VehicleType kamaz = CreateKamaz();
+    if (name == kamaz.name) {
+        out = kamaz;
+        return true;
+    }
+    return false;
 }
\ No newline at end of file
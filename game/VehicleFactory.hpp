@@ -4,6 +4,8 @@
 class VehicleFactory {
 public:
     static VehicleType CreateKamaz();
+    // Поиск типа по VehicleType::name (для загрузки сохранений)
+    static bool CreateByName(const std::string& name, VehicleType& out);
     // static VehicleType CreateT90();
     // static VehicleType CreateMi24();
 };
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "VehicleManager.hpp"
+#include "../physics/PhysXInitializer.hpp"
+#include <algorithm>
+
+// word3 фильтра запросов: корпус машины не должен ловить собственные лучи подвески
+static constexpr PxU32 SURFACE_NON_DRIVABLE = 0xffff0000;
+
+static PxQueryHitType::Enum WheelRaycastPreFilter(PxFilterData /*queryFilter*/, PxFilterData objectFilter,
+                                                  const void* /*constantBlock*/, PxU32 /*constantBlockSize*/,
+                                                  PxHitFlags& /*queryFlags*/) {
+    return (objectFilter.word3 & SURFACE_NON_DRIVABLE) ? PxQueryHitType::eNONE : PxQueryHitType::eBLOCK;
+}
+
+VehicleManager::VehicleManager(PxScene* s, PxMaterial* drivableMaterial) : scene(s) {
+    // Один тип поверхности и один тип шин - пока все машины на одном сцеплении
+    PxVehicleDrivableSurfaceType surfaceType;
+    surfaceType.mType = 0;
+    const PxMaterial* materials[1] = { drivableMaterial };
+    frictionPairs = PxVehicleDrivableSurfaceToTireFrictionPairs::allocate(1, 1);
+    frictionPairs->setup(1, 1, materials, &surfaceType);
+    frictionPairs->setTypePairFriction(0, 0, 1.0f);
+    LOG_INFO(Game, "Менеджер транспорта инициализирован");
+}
+
+VehicleManager::~VehicleManager() {
+    Clear();
+    if (batchQuery) {
+        batchQuery->release();
+        batchQuery = nullptr;
+    }
+    if (frictionPairs) {
+        frictionPairs->release();
+        frictionPairs = nullptr;
+    }
+}
+
+Vehicle* VehicleManager::CreateVehicle(PxPhysics* physics, PxMaterial* material, const VehicleType& type, const PxVec3& pos, uint32_t playerId) {
+    auto vehicle = std::make_unique<Vehicle>(physics, material, type, pos, playerId);
+
+    // Помечаем формы корпуса как непроезжие для лучей подвески
+    PxU32 shapeCount = vehicle->mActor->getNbShapes();
+    std::vector<PxShape*> shapes(shapeCount);
+    vehicle->mActor->getShapes(shapes.data(), shapeCount);
+    for (PxShape* shape : shapes) {
+        PxFilterData qfd = shape->getQueryFilterData();
+        qfd.word3 |= SURFACE_NON_DRIVABLE;
+        shape->setQueryFilterData(qfd);
+    }
+
+    Vehicle* ptr = vehicle.get();
+    vehicles.push_back(std::move(vehicle));
+    wheeledDirty = true;
+    return ptr;
+}
+
+void VehicleManager::DestroyVehicle(Vehicle* vehicle) {
+    if (!vehicle) return;
+    if (vehicle->mActor) {
+        scene->removeActor(*vehicle->mActor);
+    }
+    vehicles.erase(
+        std::remove_if(vehicles.begin(), vehicles.end(),
+            [vehicle](const std::unique_ptr<Vehicle>& ptr) { return ptr.get() == vehicle; }
+        ),
+        vehicles.end()
+    );
+    wheeledDirty = true;
+}
+
+void VehicleManager::Clear() {
+    for (auto& v : vehicles) {
+        if (v->mActor) scene->removeActor(*v->mActor);
+    }
+    vehicles.clear();
+    wheeledVehicles.clear();
+    wheeledOwners.clear();
+    wheeledDirty = true;
+}
+
+void VehicleManager::RebuildWheeledList() {
+    wheeledVehicles.clear();
+    wheeledOwners.clear();
+    PxU32 wheelCount = 0;
+    for (auto& v : vehicles) {
+        if (!v->mVehicle) continue;
+        // Колёсные и гусеничные машины - в одном пакете: PhysX различает их по типу PxVehicleWheels
+        PxVehicleWheels* wheels = nullptr;
+        if (v->type.type == VehicleDriveType::Wheeled4WD) {
+            wheels = reinterpret_cast<PxVehicleDrive4W*>(v->mVehicle);
+        } else if (v->type.type == VehicleDriveType::Tracked) {
+            wheels = reinterpret_cast<PxVehicleDriveTank*>(v->mVehicle);
+        } else {
+            continue;
+        }
+        wheeledVehicles.push_back(wheels);
+        wheeledOwners.push_back(v.get());
+        wheelCount += wheels->mWheelsSimData.getNbWheels();
+    }
+
+    // Результаты колёс лежат одним блоком, каждая машина смотрит в свой срез
+    wheelResultBuffer.resize(wheelCount);
+    wheelQueryResults.resize(wheeledVehicles.size());
+    PxU32 offset = 0;
+    for (size_t i = 0; i < wheeledVehicles.size(); ++i) {
+        PxU32 n = wheeledVehicles[i]->mWheelsSimData.getNbWheels();
+        wheelQueryResults[i].wheelQueryResults = wheelResultBuffer.data() + offset;
+        wheelQueryResults[i].nbWheelQueryResults = n;
+        offset += n;
+    }
+
+    EnsureBatchQuery(wheelCount);
+    wheeledDirty = false;
+}
+
+void VehicleManager::EnsureBatchQuery(PxU32 wheelCount) {
+    if (batchQuery && wheelCount <= raycastCapacity) return;
+
+    // Растим с запасом, чтобы колонна из новых машин не пересоздавала запрос каждый раз
+    raycastCapacity = std::max<PxU32>(wheelCount, raycastCapacity * 2);
+    raycastResults.resize(raycastCapacity);
+    raycastHits.resize(raycastCapacity);
+
+    if (batchQuery) batchQuery->release();
+    PxBatchQueryDesc desc(raycastCapacity, 0, 0);
+    desc.queryMemory.userRaycastResultBuffer = raycastResults.data();
+    desc.queryMemory.userRaycastTouchBuffer = raycastHits.data();
+    desc.queryMemory.raycastTouchBufferSize = raycastCapacity;
+    desc.preFilterShader = WheelRaycastPreFilter;
+    batchQuery = scene->createBatchQuery(desc);
+}
+
+void VehicleManager::Update(float dt) {
+    // Ввод и нестандартный транспорт (вертолёты) - по отдельности, это дёшево
+    for (auto& v : vehicles) {
+        v->Update(dt);
+    }
+
+    if (wheeledDirty) RebuildWheeledList();
+    if (wheeledVehicles.empty()) return;
+
+    PxU32 count = static_cast<PxU32>(wheeledVehicles.size());
+    PxVehicleSuspensionRaycasts(batchQuery, count, wheeledVehicles.data(),
+                                static_cast<PxU32>(raycastResults.size()), raycastResults.data());
+
+    PxVehicleUpdates(dt, scene->getGravity(), *frictionPairs, count, wheeledVehicles.data(),
+                     wheelQueryResults.data());
+
+    ReadWheelStates();
+}
+
+void VehicleManager::ReadWheelStates() {
+    for (size_t i = 0; i < wheeledOwners.size(); ++i) {
+        Vehicle* owner = wheeledOwners[i];
+        const PxVehicleWheelQueryResult& q = wheelQueryResults[i];
+        PxU32 n = std::min<PxU32>(q.nbWheelQueryResults, static_cast<PxU32>(owner->wheelStates.size()));
+        for (PxU32 w = 0; w < n; ++w) {
+            const PxWheelQueryResult& r = q.wheelQueryResults[w];
+            WheelState& state = owner->wheelStates[w];
+            state.compression = r.suspJounce;
+            state.load = r.tireLoad;
+            state.slip = r.longitudinalSlip;
+            state.contact = !r.isInAir;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Vehicle.hpp"
+#include <PhysX/PxPhysicsAPI.h>
+#include <PhysX/vehicle/PxVehicleUpdate.h>
+#include <PhysX/vehicle/PxVehicleSDK.h>
+#include <vector>
+#include <memory>
+#include "../core/Logger.hpp"
+using namespace physx;
+
+// Владеет всеми Vehicle уровня. Колёсный и гусеничный транспорт обновляется пакетно:
+// один PxBatchQuery на лучи подвески всех машин и один вызов PxVehicleUpdates за шаг.
+// Вертолёты в пакет не входят - их силы считает Vehicle::Update.
+class VehicleManager {
+    std::vector<std::unique_ptr<Vehicle>> vehicles;
+
+    // Колёсные и гусеничные машины в формате, который ждёт PhysX Vehicle SDK
+    std::vector<PxVehicleWheels*> wheeledVehicles;
+    std::vector<Vehicle*> wheeledOwners;
+    std::vector<PxVehicleWheelQueryResult> wheelQueryResults;
+    std::vector<PxWheelQueryResult> wheelResultBuffer;
+
+    // Буферы пакетного запроса лучей (по одному лучу на колесо)
+    PxBatchQuery* batchQuery = nullptr;
+    std::vector<PxRaycastQueryResult> raycastResults;
+    std::vector<PxRaycastHit> raycastHits;
+    PxU32 raycastCapacity = 0;
+
+    PxVehicleDrivableSurfaceToTireFrictionPairs* frictionPairs = nullptr;
+    PxScene* scene = nullptr;
+    bool wheeledDirty = true;
+
+    void RebuildWheeledList();
+    void EnsureBatchQuery(PxU32 wheelCount);
+    void ReadWheelStates();
+
+public:
+    VehicleManager(PxScene* scene, PxMaterial* drivableMaterial);
+    ~VehicleManager();
+
+    Vehicle* CreateVehicle(PxPhysics* physics, PxMaterial* material, const VehicleType& type, const PxVec3& pos, uint32_t playerId = 0);
+    void DestroyVehicle(Vehicle* vehicle);
+    void Clear();
+
+    // Вызывается до simulate(): ввод, лучи подвески и динамика всех машин разом
+    void Update(float dt);
+
+    size_t GetVehicleCount() const { return vehicles.size(); }
+    size_t GetWheeledCount() const { return wheeledVehicles.size(); }
+    const std::vector<std::unique_ptr<Vehicle>>& GetVehicles() const { return vehicles; }
+};
@@ -1,34 +1,153 @@
 #include "WeatherSystem.hpp"
-#include "../cuda/WindCuda.h" // Подключаем CUDA-заголовок
+#include "../cuda/CpuKernels.h"
+#include "../cuda/KernelBackend.h"
+#include "../core/ThreadPool.hpp"
+#include <memory>
+#include <cmath>
+#include <algorithm>
 
-WeatherSystem::WeatherSystem() : windField_h(new float[size * 3]) {
-    cudaMalloc(&windField_d, size * 3 * sizeof(float));
-    LOG(L"Погодная система инициализирована с CUDA");
+namespace {
+    // Один метр мира - одна клетка прежней сетки 256x256 с шагом 0.1 в аргументе
+    constexpr float WIND_SCALE = 0.1f;
+    // Пакет обрабатывается кусками на стеке, без выделений
+    constexpr size_t WIND_CHUNK = 256;
+}
+
+WeatherSystem::WeatherSystem() {
+    // Первые два снимка считаем сразу, дальше - в фоне
+    snapshots[nextSlot] = Step(snapshots[prevSlot], tickInterval);
+    ApplyInterpolated();
+    // CUDA или CPU выбирается при первом обращении к бэкенду
+    Logger::Log("Погодная система инициализирована, ядра: ", KernelBackend::Get().GetName());
 }
 
 WeatherSystem::~WeatherSystem() {
-    cudaFree(windField_d);
-    delete[] windField_h;
+    // Задача пишет в наш слот - дожидаемся её
+    if (job.valid()) job.wait();
 }
 
-void WeatherSystem::Update(float dt) {
-    timeOfDay += dt * 0.01f;
+WeatherSnapshot WeatherSystem::Step(const WeatherSnapshot& from, float dt) {
+    WeatherSnapshot s = from;
+    s.time += dt;
+    s.timeOfDay += dt * 0.01f;
+    if (s.timeOfDay >= 24.0f) s.timeOfDay -= 24.0f;
+    s.windSpeed = 5.0f + sinf(s.timeOfDay * 0.5f) * 3.0f;
+    s.windDirection += dt * 0.02f;
+    return s;
+}
+
+void WeatherSystem::ScheduleTick() {
+    int freeSlot = 3 - prevSlot - nextSlot;
+    WeatherSnapshot base = snapshots[nextSlot];
+    float interval = tickInterval;
+
+    auto done = std::make_shared<std::promise<void>>();
+    job = done->get_future();
+    jobInFlight = true;
+    ThreadPool::Global().Submit([this, base, interval, freeSlot, done]() {
+        snapshots[freeSlot] = Step(base, interval);
+        readySlot.store(freeSlot, std::memory_order_release);
+        done->set_value();
+    });
+}
+
+void WeatherSystem::ApplyInterpolated() {
+    const WeatherSnapshot& a = snapshots[prevSlot];
+    const WeatherSnapshot& b = snapshots[nextSlot];
+    float span = static_cast<float>(b.time - a.time);
+    // Если фоновая задача отстала, держим последний снимок
+    float t = span > 0.0f ? std::clamp(static_cast<float>(clock - a.time) / span, 0.0f, 1.0f) : 1.0f;
+
+    // Время суток переходит через 24 - интерполируем по кратчайшей дуге
+    float dayDelta = b.timeOfDay - a.timeOfDay;
+    if (dayDelta < -12.0f) dayDelta += 24.0f;
+    timeOfDay = a.timeOfDay + dayDelta * t;
     if (timeOfDay >= 24.0f) timeOfDay -= 24.0f;
+
+    windSpeed = a.windSpeed + (b.windSpeed - a.windSpeed) * t;
+    windDirection = a.windDirection + (b.windDirection - a.windDirection) * t;
+    rainIntensity = a.rainIntensity + (b.rainIntensity - a.rainIntensity) * t;
     isDay = (timeOfDay >= 6.0f && timeOfDay < 18.0f);
-    windSpeed = 5.0f + sinf(timeOfDay * 0.5f) * 3.0f;
-    windDirection += dt * 0.02f;
 
-    // Используем CUDA для вычисления поля ветра
-    LaunchWindCuda(windField_d, size, timeOfDay);
+    // Поле не пересчитывается целиком: запоминаем только его фазу
+    windTime = timeOfDay;
+    windY = 0.2f + sinf(windTime * 0.3f) * 0.1f;
+}
+
+void WeatherSystem::Update(float dt) {
+    clock += dt;
+
+    int ready = readySlot.exchange(-1, std::memory_order_acquire);
+    if (ready >= 0) {
+        pendingSlot = ready;
+        jobInFlight = false;
+    }
+
+    // Следующий снимок становится текущим, когда время дошло до предыдущего "следующего"
+    if (pendingSlot >= 0 && clock >= snapshots[nextSlot].time) {
+        prevSlot = nextSlot;
+        nextSlot = pendingSlot;
+        pendingSlot = -1;
+    }
 
-    // Копируем результат обратно на CPU
-    cudaMemcpy(windField_h, windField_d, size * 3 * sizeof(float), cudaMemcpyDeviceToHost);
+    if (pendingSlot < 0 && !jobInFlight) {
+        ScheduleTick();
+    }
+
+    ApplyInterpolated();
+}
+
+WeatherSnapshot WeatherSystem::GetCurrentSnapshot() const {
+    WeatherSnapshot s;
+    s.time = clock;
+    s.timeOfDay = timeOfDay;
+    s.windSpeed = windSpeed;
+    s.windDirection = windDirection;
+    s.rainIntensity = rainIntensity;
+    return s;
+}
+
+void WeatherSystem::Restore(const WeatherSnapshot& state) {
+    if (job.valid()) job.wait();
+    readySlot.store(-1, std::memory_order_relaxed);
+    jobInFlight = false;
+    pendingSlot = -1;
+
+    clock = state.time;
+    prevSlot = 0;
+    nextSlot = 1;
+    snapshots[prevSlot] = state;
+    snapshots[nextSlot] = Step(state, tickInterval);
+    ApplyInterpolated();
+}
+
+void WeatherSystem::SetUpdateRate(float hz) {
+    if (hz > 0.0f) tickInterval = 1.0f / hz;
 }
 
 glm::vec3 WeatherSystem::GetWindAt(const glm::vec3& pos) const {
-    int x = static_cast<int>(pos.x) % 256;
-    int z = static_cast<int>(pos.z) % 256;
-    int idx = z * 256 + x;
-    // Используем данные с CPU
-    return {windField_h[idx], windField_h[idx + size], windField_h[idx + 2*size]};
+    // Координаты не сворачиваются по модулю: поле непрерывно при любых, в т.ч. отрицательных, позициях
+    float x = pos.x * WIND_SCALE;
+    float z = pos.z * WIND_SCALE;
+    float wx, wz;
+    CpuKernels::WindPointsScalar(&x, &z, &wx, &wz, windTime, 0, 1);
+    return {wx, windY, wz};
+}
+
+void WeatherSystem::GetWindAt(const glm::vec3* positions, glm::vec3* out, size_t count) const {
+    // Тот же бэкенд, что и у остальных ядер: AVX2 или скалярный код по RTGC_KERNEL_BACKEND
+    KernelBackend& kernels = KernelBackend::Get();
+    float xs[WIND_CHUNK], zs[WIND_CHUNK], wx[WIND_CHUNK], wz[WIND_CHUNK];
+
+    for (size_t base = 0; base < count; base += WIND_CHUNK) {
+        int n = static_cast<int>(std::min(WIND_CHUNK, count - base));
+        for (int i = 0; i < n; ++i) {
+            xs[i] = positions[base + i].x * WIND_SCALE;
+            zs[i] = positions[base + i].z * WIND_SCALE;
+        }
+        kernels.ComputeWindPoints(xs, zs, wx, wz, n, windTime);
+        for (int i = 0; i < n; ++i) {
+            out[base + i] = {wx[i], windY, wz[i]};
+        }
+    }
 }
\ No newline at end of file
@@ -1,13 +1,44 @@
 #pragma once
 #include <glm/glm.hpp>
-#include <cuda_runtime.h> // Для CUDA
 #include "../core/Logger.hpp"
+#include <atomic>
+#include <future>
+#include <cstddef>
 
+// Неизменяемый снимок погоды на момент time (секунды игры)
+struct WeatherSnapshot {
+    double time = 0.0;
+    float timeOfDay = 12.0f;
+    float windSpeed = 0.0f;
+    float windDirection = 0.0f;
+    float rainIntensity = 0.0f;
+};
+
+// Погода считается фоновой задачей с низкой частотой и публикует снимки на шаг вперёд;
+// Update главного потока только забирает готовый снимок и интерполирует между двумя.
+// Ветер считается аналитически только в запрошенных точках: цена кадра
+// зависит от числа запросов, а не от размера поля
 class WeatherSystem {
-    float* windField_d = nullptr; // Указатель на GPU
-    float* windField_h = nullptr; // Указатель на CPU
-    int size = 256 * 256;
+    // Три слота: предыдущий и следующий снимки читает главный поток, в третий пишет задача
+    WeatherSnapshot snapshots[3];
+    int prevSlot = 0;
+    int nextSlot = 1;
+    int pendingSlot = -1;            // готов, но ещё не нужен
+    std::atomic<int> readySlot{-1};  // публикация задачи: индекс записанного слота
+    bool jobInFlight = false;
+    std::future<void> job;
+
+    double clock = 0.0;
+    float tickInterval = 0.5f;       // 2 Гц
+
+    float windTime = 12.0f; // фаза поля ветра, обновляется в Update
+    float windY = 0.2f;     // вертикальная составляющая одна для всех точек
+
+    static WeatherSnapshot Step(const WeatherSnapshot& from, float dt);
+    void ScheduleTick();
+    void ApplyInterpolated();
 public:
+    // Интерполированные значения текущего кадра
     float timeOfDay = 12.0f;
     float windSpeed = 0.0f;
     float windDirection = 0.0f;
@@ -18,4 +49,15 @@ public:
     ~WeatherSystem();
     void Update(float dt);
     glm::vec3 GetWindAt(const glm::vec3& pos) const;
+    // Пакетный запрос для частиц и растительности; потокобезопасен
+    void GetWindAt(const glm::vec3* positions, glm::vec3* out, size_t count) const;
+
+    // Частота фонового шага погоды; применяется со следующего снимка
+    void SetUpdateRate(float hz);
+    float GetUpdateRate() const { return 1.0f / tickInterval; }
+
+    // Для сохранения: состояние, интерполированное на текущий кадр
+    WeatherSnapshot GetCurrentSnapshot() const;
+    // Для загрузки: дожидается фоновой задачи и начинает цепочку снимков заново
+    void Restore(const WeatherSnapshot& state);
 };
\ No newline at end of file
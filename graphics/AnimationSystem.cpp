@@ -20,7 +20,7 @@ void AnimationSystem::LoadAnimationClip(const std::string& name, const std::stri
     // clip.LoadFromFile(path);
 
     clips[name] = clip;
-    LOG(L"Анимация загружена: " + std::wstring(name.begin(), name.end()));
+    LOG_INFO(Graphics, "Анимация загружена: ", name);
 }
 
 void AnimationSystem::PlayAnimation(const std::string& clipName) {
@@ -1,8 +1,9 @@
 #include "LightingSystem.hpp"
 #include "Logger.hpp"
+#include <cstdio>
 
 LightingSystem::LightingSystem(Shader* shader) : lightingShader(shader) {
-    LOG(L"Система освещения инициализирована");
+    LOG_INFO(Graphics, "Система освещения инициализирована");
 
     // Добавление основного источника света
     Light mainLight;
@@ -21,12 +22,17 @@ void LightingSystem::SetLightUniforms(Shader& shader) const {
     shader.Use();
     glUniform1i(glGetUniformLocation(shader.id, "uLightCount"), static_cast<int>(lights.size()));
 
+    // Имена собираются в буфере на стеке: без строк в куче на каждый свет каждый кадр
+    char name[64];
+    auto location = [&](size_t index, const char* field) {
+        std::snprintf(name, sizeof(name), "uLights[%zu].%s", index, field);
+        return glGetUniformLocation(shader.id, name);
+    };
     for (size_t i = 0; i < lights.size(); ++i) {
-        std::string lightName = "uLights[" + std::to_string(i) + "]";
-        glUniform3fv(glGetUniformLocation(shader.id, (lightName + ".position").c_str()), 1, &lights[i].position[0]);
-        glUniform3fv(glGetUniformLocation(shader.id, (lightName + ".color").c_str()), 1, &lights[i].color[0]);
-        glUniform1f(glGetUniformLocation(shader.id, (lightName + ".intensity").c_str()), lights[i].intensity);
-        glUniform1f(glGetUniformLocation(shader.id, (lightName + ".range").c_str()), lights[i].range);
+        glUniform3fv(location(i, "position"), 1, &lights[i].position[0]);
+        glUniform3fv(location(i, "color"), 1, &lights[i].color[0]);
+        glUniform1f(location(i, "intensity"), lights[i].intensity);
+        glUniform1f(location(i, "range"), lights[i].range);
     }
 }
 
@@ -19,7 +19,7 @@ PostProcessingSystem::PostProcessingSystem(Shader* shader) : postProcessShader(s
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
 
-    LOG(L"Система пост-обработки инициализирована");
+    LOG_INFO(Graphics, "Система пост-обработки инициализирована");
 }
 
 void PostProcessingSystem::Setup(unsigned int width, unsigned int height) {
@@ -39,7 +39,7 @@ void PostProcessingSystem::Setup(unsigned int width, unsigned int height) {
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbuffer);
 
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        ERROR(L"Ошибка инициализации фреймбуфера пост-обработки");
+        LOG_ERROR(Graphics, "Ошибка инициализации фреймбуфера пост-обработки");
     }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
@@ -2,6 +2,7 @@
 #include "../world/Terrain.hpp"
 #include "../physics/CharacterController.hpp"
 #include "../core/Logger.hpp"
+#include "../world/WorldOrigin.hpp"
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include <windows.h>
@@ -599,7 +600,8 @@ void Renderer::RenderGame(const Vector3& cameraPos) {
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 
-    // Setup camera following the character
+    // Setup camera following the character; cameraPos is local to WorldOrigin,
+    // so the camera moves together with everything else on a rebase
     gluLookAt(cameraPos.x, cameraPos.y + 15.0f, cameraPos.z + 30.0f,
               cameraPos.x, cameraPos.y, cameraPos.z,
               0.0f, 1.0f, 0.0f);
@@ -655,15 +657,19 @@ void Renderer::RenderGame(const Vector3& cameraPos) {
     glVertex3f(-500.0f, 0.0f, 500.0f);
     glEnd();
 
-    // Draw grid lines with subtle snow shadows
+    // Draw grid lines with subtle snow shadows.
+    // Lines stay on world multiples of 50 m: an origin rebase does not make the grid jump
+    const WorldPosition& origin = WorldOrigin::Get();
+    float gridPhaseX = static_cast<float>(std::fmod(origin.x, 50.0));
+    float gridPhaseZ = static_cast<float>(std::fmod(origin.z, 50.0));
     glColor3f(0.7f, 0.75f, 0.8f);
     glLineWidth(1.5f);
     glBegin(GL_LINES);
     for (int i = -500; i <= 500; i += 50) {
-        glVertex3f((float)i, 0.01f, -500.0f);
-        glVertex3f((float)i, 0.01f, 500.0f);
-        glVertex3f(-500.0f, 0.01f, (float)i);
-        glVertex3f(500.0f, 0.01f, (float)i);
+        glVertex3f((float)i - gridPhaseX, 0.01f, -500.0f);
+        glVertex3f((float)i - gridPhaseX, 0.01f, 500.0f);
+        glVertex3f(-500.0f, 0.01f, (float)i - gridPhaseZ);
+        glVertex3f(500.0f, 0.01f, (float)i - gridPhaseZ);
     }
     glEnd();
     glLineWidth(1.0f);
@@ -675,8 +681,10 @@ void Renderer::RenderGame(const Vector3& cameraPos) {
     for (size_t i = 0; i < m_cities.size(); ++i) {
         const City& city = m_cities[i];
 
+        // City coordinates are world-space: converted in double relative to the current origin
+        Vector3 local = WorldOrigin::ToLocal(WorldPosition(city.x * 0.01, 1.5, city.z * 0.01));
         glPushMatrix();
-        glTranslatef(city.x * 0.01f, 1.5f, city.z * 0.01f);
+        glTranslatef(local.x, local.y, local.z);
 
         // AAA building materials with realistic colors
         float baseR = 0.6f, baseG = 0.65f, baseB = 0.7f;
@@ -8,7 +8,7 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) : id(0) {
     std::string vCode = ReadFile(vertexPath);
     std::string fCode = ReadFile(fragmentPath);
     if (vCode.empty() || fCode.empty()) {
-        ERROR(L"Не удалось прочитать файлы шейдера");
+        LOG_ERROR(Graphics, "Не удалось прочитать файлы шейдера");
         return;
     }
     const char* vSrc = vCode.c_str();
@@ -43,7 +43,7 @@ void Shader::Use() const {
 std::string Shader::ReadFile(const std::string& path) {
     std::ifstream file(path);
     if (!file.is_open()) {
-        ERROR(L"Не удалось открыть шейдер: " + std::wstring(path.begin(), path.end()));
+        LOG_ERROR(Graphics, "Не удалось открыть шейдер: ", path);
         return "";
     }
     std::stringstream buffer;
@@ -58,13 +58,13 @@ void Shader::CheckCompileErrors(unsigned int shader, const std::string& type) {
         glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
         if (!success) {
             glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-            ERROR(L"Ошибка компиляции шейдера (" + std::wstring(type.begin(), type.end()) + L"): " + std::wstring(infoLog, infoLog + strlen(infoLog)));
+            LOG_ERROR(Graphics, "Ошибка компиляции шейдера (", type, "): ", infoLog);
         }
     } else {
         glGetProgramiv(shader, GL_LINK_STATUS, &success);
         if (!success) {
             glGetProgramInfoLog(shader, 1024, NULL, infoLog);
-            ERROR(L"Ошибка линковки программы: " + std::wstring(infoLog, infoLog + strlen(infoLog)));
+            LOG_ERROR(Graphics, "Ошибка линковки программы: ", infoLog);
         }
     }
 }
\ No newline at end of file
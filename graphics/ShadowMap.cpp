@@ -19,11 +19,11 @@ ShadowMap::ShadowMap() {
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        ERROR(L"Ошибка инициализации фреймбуфера теней");
+        LOG_ERROR(Graphics, "Ошибка инициализации фреймбуфера теней");
     }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    LOG(L"Карта теней инициализирована");
+    LOG_INFO(Graphics, "Карта теней инициализирована");
 }
 
 void ShadowMap::BindForWriting() {
@@ -1,6 +1,7 @@
 #include "Window.hpp"
 #include "GPUManager.hpp"
 #include "../core/Logger.hpp"
+#include "../game/InputManager.hpp"
 #include <GL/gl.h>
 #include <cstring>
 
@@ -62,11 +63,13 @@ LRESULT CALLBACK Window::WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM
             if (window && wParam < 256) {
                 window->m_keys[wParam] = true;
                 window->m_keysPressed[wParam] = true;
+                InputManager::SetKeyState(static_cast<int>(wParam), true);
             }
             return 0;
         case WM_KEYUP:
             if (window && wParam < 256) {
                 window->m_keys[wParam] = false;
+                InputManager::SetKeyState(static_cast<int>(wParam), false);
             }
             return 0;
         default:
@@ -1,16 +1,29 @@
 #pragma comment(linker, "/SUBSYSTEM:WINDOWS")
 #include "EngineMinimal.hpp"
+#include "debug/Profiler.hpp"
+#include "core/Metrics.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Replay.hpp"
 #include <Windows.h>
+#include <stdlib.h>
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
-    Engine engine;
+    Profiler::ParseCommandLine(__argc, __argv);
+    Metrics::ParseCommandLine(__argc, __argv);
+    MemoryTracker::ParseCommandLine(__argc, __argv);
+    Replay::ParseCommandLine(__argc, __argv);
+    {
+        Engine engine;
 
-    if (!engine.Initialize()) {
-        MessageBoxA(NULL, "Не удалось инициализировать движок RTGC", "Ошибка", MB_OK | MB_ICONERROR);
-        return -1;
-    }
+        if (!engine.Initialize()) {
+            MessageBoxA(NULL, "Не удалось инициализировать движок RTGC", "Ошибка", MB_OK | MB_ICONERROR);
+            return -1;
+        }
 
-    engine.Run();
+        engine.Run();
+    }
+    // Движок уже разрушен: всё, что осталось, - утечки или глобальные объекты
+    MemoryTracker::ReportLeaks();
 
     return 0;
 }
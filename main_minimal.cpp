@@ -1,17 +1,29 @@
 #include "EngineMinimal.hpp"
+#include "debug/Profiler.hpp"
+#include "core/Metrics.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Replay.hpp"
 #include <iostream>
 
-int main() {
-    Engine engine;
-    
-    std::cout << "Initializing RTGC Engine..." << std::endl;
-    
-    if (!engine.Initialize()) {
-        std::cout << "Failed to initialize RTGC Engine" << std::endl;
-        return -1;
+int main(int argc, char** argv) {
+    Profiler::ParseCommandLine(argc, argv);
+    Metrics::ParseCommandLine(argc, argv);
+    MemoryTracker::ParseCommandLine(argc, argv);
+    Replay::ParseCommandLine(argc, argv);
+    {
+        Engine engine;
+        
+        std::cout << "Initializing RTGC Engine..." << std::endl;
+        
+        if (!engine.Initialize()) {
+            std::cout << "Failed to initialize RTGC Engine" << std::endl;
+            return -1;
+        }
+        
+        engine.Run();
     }
-    
-    engine.Run();
+    // Движок уже разрушен: всё, что осталось, - утечки или глобальные объекты
+    MemoryTracker::ReportLeaks();
     
     return 0;
 }
@@ -0,0 +1,91 @@
+#include "MathBatch.hpp"
+
+namespace {
+    constexpr float MIN_LENGTH = 0.0001f;
+
+    // Общий цикл: четыре элемента на SIMD, остаток - тем же кодом на одной дорожке,
+    // чтобы хвост давал те же результаты, что и основная часть
+    template<typename Kernel>
+    void ForEachQuad(size_t count, Kernel kernel) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) kernel(i, 4);
+        if (i < count) kernel(i, count - i);
+    }
+
+    // Загрузка до четырёх float; недостающие дорожки - нули
+    simd::Float4 LoadPartial(const float* p, size_t n) {
+        if (n == 4) return simd::LoadUnaligned(p);
+        alignas(16) float tmp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (size_t k = 0; k < n; ++k) tmp[k] = p[k];
+        return simd::Load(tmp);
+    }
+
+    void StorePartial(float* p, simd::Float4 v, size_t n) {
+        if (n == 4) {
+            simd::StoreUnaligned(p, v);
+            return;
+        }
+        alignas(16) float tmp[4];
+        simd::Store(tmp, v);
+        for (size_t k = 0; k < n; ++k) p[k] = tmp[k];
+    }
+
+    void TransformSoa(const Mat4& m, ConstVec3Soa in, Vec3Soa out, size_t count, bool translate) {
+        // Элементы матрицы по всем дорожкам: строка r, столбец c
+        simd::Float4 e[4][3];
+        for (int c = 0; c < 4; ++c) {
+            const Vec4& col = m.columns[c];
+            e[c][0] = simd::Splat(col.x);
+            e[c][1] = simd::Splat(col.y);
+            e[c][2] = simd::Splat(col.z);
+        }
+        float w = translate ? 1.0f : 0.0f;
+        simd::Float4 tw[3] = {simd::Mul(e[3][0], simd::Splat(w)), simd::Mul(e[3][1], simd::Splat(w)),
+                              simd::Mul(e[3][2], simd::Splat(w))};
+
+        ForEachQuad(count, [&](size_t i, size_t n) {
+            simd::Float4 x = LoadPartial(in.x + i, n);
+            simd::Float4 y = LoadPartial(in.y + i, n);
+            simd::Float4 z = LoadPartial(in.z + i, n);
+            for (int r = 0; r < 3; ++r) {
+                simd::Float4 v = simd::MulAdd(e[0][r], x, tw[r]);
+                v = simd::MulAdd(e[1][r], y, v);
+                v = simd::MulAdd(e[2][r], z, v);
+                StorePartial(r == 0 ? out.x + i : r == 1 ? out.y + i : out.z + i, v, n);
+            }
+        });
+    }
+}
+
+void MathBatch::TransformPoints(const Mat4& m, ConstVec3Soa in, Vec3Soa out, size_t count) {
+    TransformSoa(m, in, out, count, true);
+}
+
+void MathBatch::TransformVectors(const Mat4& m, ConstVec3Soa in, Vec3Soa out, size_t count) {
+    TransformSoa(m, in, out, count, false);
+}
+
+void MathBatch::NormalizeMany(ConstVec3Soa in, Vec3Soa out, size_t count) {
+    const simd::Float4 minLenSq = simd::Splat(MIN_LENGTH * MIN_LENGTH);
+    const simd::Float4 one = simd::Splat(1.0f);
+    ForEachQuad(count, [&](size_t i, size_t n) {
+        simd::Float4 x = LoadPartial(in.x + i, n);
+        simd::Float4 y = LoadPartial(in.y + i, n);
+        simd::Float4 z = LoadPartial(in.z + i, n);
+        simd::Float4 lenSq = simd::MulAdd(z, z, simd::MulAdd(y, y, simd::Mul(x, x)));
+        simd::Float4 ok = simd::CmpGe(lenSq, minLenSq);
+        simd::Float4 len = simd::Select(ok, simd::Sqrt(lenSq), one);
+        StorePartial(out.x + i, simd::And(ok, simd::Div(x, len)), n);
+        StorePartial(out.y + i, simd::And(ok, simd::Div(y, len)), n);
+        StorePartial(out.z + i, simd::And(ok, simd::Div(z, len)), n);
+    });
+}
+
+void MathBatch::DotMany(ConstVec3Soa a, ConstVec3Soa b, float* out, size_t count) {
+    ForEachQuad(count, [&](size_t i, size_t n) {
+        simd::Float4 d = simd::Mul(LoadPartial(a.x + i, n), LoadPartial(b.x + i, n));
+        d = simd::MulAdd(LoadPartial(a.y + i, n), LoadPartial(b.y + i, n), d);
+        d = simd::MulAdd(LoadPartial(a.z + i, n), LoadPartial(b.z + i, n), d);
+        StorePartial(out + i, d, n);
+    });
+}
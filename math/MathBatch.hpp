@@ -0,0 +1,34 @@
+#pragma once
+#include "MathTypes.hpp"
+#include <cstddef>
+
+// Пакетные операции над массивами векторов в раскладке SoA (отдельные массивы x, y, z):
+// по четыре вектора за итерацию на SIMD-регистрах, хвост - скалярно.
+// Выравнивание массивов не требуется; входной и выходной массивы могут совпадать.
+//     std::vector<float> xs, ys, zs; ...
+//     MathBatch::TransformPoints(model, {xs.data(), ys.data(), zs.data()}, {xs.data(), ys.data(), zs.data()}, xs.size());
+struct Vec3Soa {
+    float* x;
+    float* y;
+    float* z;
+};
+
+struct ConstVec3Soa {
+    const float* x;
+    const float* y;
+    const float* z;
+
+    ConstVec3Soa(const float* xs, const float* ys, const float* zs) : x(xs), y(ys), z(zs) {}
+    ConstVec3Soa(const Vec3Soa& soa) : x(soa.x), y(soa.y), z(soa.z) {}
+};
+
+class MathBatch {
+public:
+    // out[i] = m * (in[i], 1), без проективного деления
+    static void TransformPoints(const Mat4& m, ConstVec3Soa in, Vec3Soa out, size_t count);
+    // out[i] = m * (in[i], 0)
+    static void TransformVectors(const Mat4& m, ConstVec3Soa in, Vec3Soa out, size_t count);
+    // Векторы короче 1e-4 становятся нулевыми, как в Vector3::Normalize
+    static void NormalizeMany(ConstVec3Soa in, Vec3Soa out, size_t count);
+    static void DotMany(ConstVec3Soa a, ConstVec3Soa b, float* out, size_t count);
+};
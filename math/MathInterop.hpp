@@ -0,0 +1,46 @@
+#pragma once
+#include "MathTypes.hpp"
+
+// Преобразования Vector3/Vec3/Vec4/Quat/Mat4 в типы glm и PhysX и обратно.
+// Раскладки совпадают (Mat4 и glm::mat4/PxMat44 - по столбцам), поэтому преобразование -
+// покомпонентное копирование, которое компилятор сводит к загрузке/выгрузке регистров.
+// Каждая половина компилируется, только если доступны заголовки соответствующей библиотеки.
+
+#if __has_include(<glm/glm.hpp>)
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+inline glm::vec3 ToGLM(const Vector3& v) { return glm::vec3(v.x, v.y, v.z); }
+inline glm::vec3 ToGLM(const Vec3& v) { return glm::vec3(v.x, v.y, v.z); }
+inline glm::vec4 ToGLM(const Vec4& v) { return glm::vec4(v.x, v.y, v.z, v.w); }
+inline glm::quat ToGLM(const Quat& q) { return glm::quat(q.w, q.x, q.y, q.z); } // конструктор glm - (w, x, y, z)
+inline glm::mat4 ToGLM(const Mat4& m) {
+    return glm::mat4(ToGLM(m.columns[0]), ToGLM(m.columns[1]), ToGLM(m.columns[2]), ToGLM(m.columns[3]));
+}
+
+inline Vec3 FromGLM(const glm::vec3& v) { return Vec3(v.x, v.y, v.z); }
+inline Vec4 FromGLM(const glm::vec4& v) { return Vec4(v.x, v.y, v.z, v.w); }
+inline Quat FromGLM(const glm::quat& q) { return Quat(q.x, q.y, q.z, q.w); }
+inline Mat4 FromGLM(const glm::mat4& m) {
+    return Mat4(FromGLM(m[0]), FromGLM(m[1]), FromGLM(m[2]), FromGLM(m[3]));
+}
+#endif
+
+#if __has_include(<PhysX/PxPhysicsAPI.h>)
+#include <PhysX/PxPhysicsAPI.h>
+
+inline physx::PxVec3 ToPhysX(const Vector3& v) { return physx::PxVec3(v.x, v.y, v.z); }
+inline physx::PxVec3 ToPhysX(const Vec3& v) { return physx::PxVec3(v.x, v.y, v.z); }
+inline physx::PxVec4 ToPhysX(const Vec4& v) { return physx::PxVec4(v.x, v.y, v.z, v.w); }
+inline physx::PxQuat ToPhysX(const Quat& q) { return physx::PxQuat(q.x, q.y, q.z, q.w); }
+inline physx::PxMat44 ToPhysX(const Mat4& m) {
+    return physx::PxMat44(ToPhysX(m.columns[0]), ToPhysX(m.columns[1]), ToPhysX(m.columns[2]), ToPhysX(m.columns[3]));
+}
+
+inline Vec3 FromPhysX(const physx::PxVec3& v) { return Vec3(v.x, v.y, v.z); }
+inline Vec4 FromPhysX(const physx::PxVec4& v) { return Vec4(v.x, v.y, v.z, v.w); }
+inline Quat FromPhysX(const physx::PxQuat& q) { return Quat(q.x, q.y, q.z, q.w); }
+inline Mat4 FromPhysX(const physx::PxMat44& m) {
+    return Mat4(FromPhysX(m.column0), FromPhysX(m.column1), FromPhysX(m.column2), FromPhysX(m.column3));
+}
+#endif
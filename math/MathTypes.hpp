@@ -0,0 +1,208 @@
+#pragma once
+#include "Simd.hpp"
+#include "Vector3.hpp"
+
+// Вычислительные типы на SIMD-регистрах (Simd.hpp). Поля - обычные float, как у Vector3,
+// поэтому v.x, q.w и т.п. работают; операции загружают выровненные 16 байт целиком.
+// Vector3 остаётся типом хранения (12 байт, компоненты, снапшоты, сеть),
+// Vec3 - для горячих вычислений; преобразование явное: Vec3(v) и v.ToVector3().
+// Преобразования в glm и PhysX - MathInterop.hpp, пакетные операции над массивами - MathBatch.hpp.
+
+struct alignas(16) Vec3 {
+    float x, y, z;
+    float pad; // всегда 0: Dot4 и сравнения по четырём дорожкам не видят мусора
+
+    // Все конструкторы пишут 16 байт одной записью: следующая загрузка регистра получает
+    // данные из буфера записи, а не ждёт слияния четырёх отдельных записей float
+    Vec3(float x = 0, float y = 0, float z = 0) { simd::Store(&this->x, simd::Set(x, y, z, 0.0f)); }
+    explicit Vec3(const Vector3& v) { simd::Store(&x, simd::Set(v.x, v.y, v.z, 0.0f)); }
+    explicit Vec3(simd::Float4 v) { simd::Store(&x, simd::ClearW(v)); }
+
+    simd::Float4 Load() const { return simd::Load(&x); }
+    Vector3 ToVector3() const { return Vector3(x, y, z); }
+
+    Vec3 operator+(const Vec3& o) const { return Vec3(simd::Add(Load(), o.Load())); }
+    Vec3 operator-(const Vec3& o) const { return Vec3(simd::Sub(Load(), o.Load())); }
+    Vec3 operator*(const Vec3& o) const { return Vec3(simd::Mul(Load(), o.Load())); }
+    Vec3 operator*(float s) const { return Vec3(simd::Mul(Load(), simd::Splat(s))); }
+    Vec3 operator-() const { return Vec3(simd::Sub(simd::Zero(), Load())); }
+    Vec3& operator+=(const Vec3& o) { return *this = *this + o; }
+    Vec3& operator-=(const Vec3& o) { return *this = *this - o; }
+    Vec3& operator*=(float s) { return *this = *this * s; }
+
+    // Как у Vector3: |s| < 1e-4 даёт нулевой вектор, без ветвления
+    Vec3 operator/(float s) const {
+        simd::Float4 d = simd::Splat(s);
+        simd::Float4 absD = simd::Max(d, simd::Sub(simd::Zero(), d));
+        simd::Float4 ok = simd::CmpGe(absD, simd::Splat(0.0001f));
+        simd::Float4 safe = simd::Select(ok, d, simd::Splat(1.0f));
+        return Vec3(simd::And(ok, simd::Div(Load(), safe)));
+    }
+
+    float Dot(const Vec3& o) const { return simd::GetX(simd::Dot3(Load(), o.Load())); }
+    Vec3 Cross(const Vec3& o) const { return Vec3(simd::Cross3(Load(), o.Load())); }
+    float LengthSquared() const { return Dot(*this); }
+    float Length() const { return simd::GetX(simd::Sqrt(simd::Dot3(Load(), Load()))); }
+
+    // Длина < 1e-4 даёт нулевой вектор, как Vector3::Normalize
+    Vec3 Normalize() const {
+        simd::Float4 v = Load();
+        simd::Float4 lenSq = simd::Dot3(v, v);
+        simd::Float4 ok = simd::CmpGe(lenSq, simd::Splat(0.0001f * 0.0001f));
+        simd::Float4 len = simd::Select(ok, simd::Sqrt(lenSq), simd::Splat(1.0f));
+        return Vec3(simd::And(ok, simd::Div(v, len)));
+    }
+
+    static Vec3 Min(const Vec3& a, const Vec3& b) { return Vec3(simd::Min(a.Load(), b.Load())); }
+    static Vec3 Max(const Vec3& a, const Vec3& b) { return Vec3(simd::Max(a.Load(), b.Load())); }
+    // a + (b - a) * t
+    static Vec3 Lerp(const Vec3& a, const Vec3& b, float t) {
+        return Vec3(simd::MulAdd(simd::Sub(b.Load(), a.Load()), simd::Splat(t), a.Load()));
+    }
+};
+
+inline Vec3 operator*(float s, const Vec3& v) { return v * s; }
+
+struct alignas(16) Vec4 {
+    float x, y, z, w;
+
+    Vec4(float x = 0, float y = 0, float z = 0, float w = 0) { simd::Store(&this->x, simd::Set(x, y, z, w)); }
+    Vec4(const Vec3& v, float w) { simd::Store(&x, simd::Set(v.x, v.y, v.z, w)); }
+    explicit Vec4(simd::Float4 v) { simd::Store(&x, v); }
+
+    simd::Float4 Load() const { return simd::Load(&x); }
+    Vec3 XYZ() const { return Vec3(x, y, z); }
+
+    Vec4 operator+(const Vec4& o) const { return Vec4(simd::Add(Load(), o.Load())); }
+    Vec4 operator-(const Vec4& o) const { return Vec4(simd::Sub(Load(), o.Load())); }
+    Vec4 operator*(const Vec4& o) const { return Vec4(simd::Mul(Load(), o.Load())); }
+    Vec4 operator*(float s) const { return Vec4(simd::Mul(Load(), simd::Splat(s))); }
+
+    float Dot(const Vec4& o) const { return simd::GetX(simd::Dot4(Load(), o.Load())); }
+    float LengthSquared() const { return Dot(*this); }
+    float Length() const { return simd::GetX(simd::Sqrt(simd::Dot4(Load(), Load()))); }
+};
+
+// Кватернион (x, y, z, w), w - скалярная часть; порядок полей как у PxQuat
+struct alignas(16) Quat {
+    float x, y, z, w;
+
+    Quat(float x = 0, float y = 0, float z = 0, float w = 1) { simd::Store(&this->x, simd::Set(x, y, z, w)); }
+    explicit Quat(simd::Float4 v) { simd::Store(&x, v); }
+
+    simd::Float4 Load() const { return simd::Load(&x); }
+
+    static Quat Identity() { return Quat(0, 0, 0, 1); }
+
+    // Ось должна быть единичной, угол - в радианах
+    static Quat FromAxisAngle(const Vec3& axis, float angle) {
+        float s = std::sin(angle * 0.5f);
+        return Quat(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+    }
+
+    // Произведение Гамильтона: сначала поворот o, затем this
+    Quat operator*(const Quat& o) const {
+        simd::Float4 a = Load();
+        simd::Float4 b = o.Load();
+        simd::Float4 aw = simd::SplatLane<3>(a);
+        simd::Float4 bw = simd::SplatLane<3>(b);
+        // xyz: a.w*b.xyz + b.w*a.xyz + a.xyz x b.xyz; w: a.w*b.w - dot(a.xyz, b.xyz)
+        simd::Float4 xyz = simd::Add(simd::Add(simd::Mul(aw, b), simd::Mul(bw, a)), simd::Cross3(a, b));
+        float w = simd::GetX(aw) * simd::GetX(bw) - simd::GetX(simd::Dot3(a, b));
+        Quat r(xyz);
+        r.w = w;
+        return r;
+    }
+
+    Quat Conjugate() const { return Quat(-x, -y, -z, w); }
+    float Dot(const Quat& o) const { return simd::GetX(simd::Dot4(Load(), o.Load())); }
+
+    // Нулевой кватернион даёт единичный, без ветвления
+    Quat Normalize() const {
+        simd::Float4 v = Load();
+        simd::Float4 lenSq = simd::Dot4(v, v);
+        simd::Float4 ok = simd::CmpGe(lenSq, simd::Splat(1e-12f));
+        simd::Float4 len = simd::Select(ok, simd::Sqrt(lenSq), simd::Splat(1.0f));
+        return Quat(simd::Select(ok, simd::Div(v, len), simd::Set(0.0f, 0.0f, 0.0f, 1.0f)));
+    }
+
+    // Поворот вектора единичным кватернионом: v + 2w(q x v) + 2 q x (q x v)
+    Vec3 Rotate(const Vec3& v) const {
+        simd::Float4 q = Load();
+        simd::Float4 p = v.Load();
+        simd::Float4 t = simd::Mul(simd::Cross3(q, p), simd::Splat(2.0f));
+        simd::Float4 r = simd::Add(simd::Add(p, simd::Mul(simd::SplatLane<3>(q), t)), simd::Cross3(q, t));
+        return Vec3(r);
+    }
+};
+
+// Матрица 4x4 по столбцам - та же раскладка в памяти, что у glm::mat4 и physx::PxMat44
+struct alignas(16) Mat4 {
+    Vec4 columns[4];
+
+    Mat4() : columns{Vec4(1, 0, 0, 0), Vec4(0, 1, 0, 0), Vec4(0, 0, 1, 0), Vec4(0, 0, 0, 1)} {}
+    Mat4(const Vec4& c0, const Vec4& c1, const Vec4& c2, const Vec4& c3) : columns{c0, c1, c2, c3} {}
+
+    static Mat4 Identity() { return Mat4(); }
+    static Mat4 Translation(const Vec3& t) {
+        Mat4 m;
+        m.columns[3] = Vec4(t, 1.0f);
+        return m;
+    }
+    static Mat4 Scale(const Vec3& s) {
+        return Mat4(Vec4(s.x, 0, 0, 0), Vec4(0, s.y, 0, 0), Vec4(0, 0, s.z, 0), Vec4(0, 0, 0, 1));
+    }
+    // Кватернион должен быть единичным
+    static Mat4 FromQuat(const Quat& q) {
+        float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        return Mat4(Vec4(1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0),
+                    Vec4(2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0),
+                    Vec4(2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0),
+                    Vec4(0, 0, 0, 1));
+    }
+    // Translation * Rotation * Scale - порядок, в котором RenderSystem собирает матрицу модели
+    static Mat4 TRS(const Vec3& t, const Quat& r, const Vec3& s) {
+        Mat4 m = FromQuat(r);
+        simd::Float4 scale = s.Load();
+        m.columns[0] = Vec4(simd::Mul(m.columns[0].Load(), simd::SplatLane<0>(scale)));
+        m.columns[1] = Vec4(simd::Mul(m.columns[1].Load(), simd::SplatLane<1>(scale)));
+        m.columns[2] = Vec4(simd::Mul(m.columns[2].Load(), simd::SplatLane<2>(scale)));
+        m.columns[3] = Vec4(t, 1.0f);
+        return m;
+    }
+
+    // Линейная комбинация столбцов: M * (v.x, v.y, v.z, v.w)
+    simd::Float4 Transform(simd::Float4 v) const {
+        simd::Float4 r = simd::Mul(columns[0].Load(), simd::SplatLane<0>(v));
+        r = simd::MulAdd(columns[1].Load(), simd::SplatLane<1>(v), r);
+        r = simd::MulAdd(columns[2].Load(), simd::SplatLane<2>(v), r);
+        return simd::MulAdd(columns[3].Load(), simd::SplatLane<3>(v), r);
+    }
+
+    Vec4 operator*(const Vec4& v) const { return Vec4(Transform(v.Load())); }
+    Mat4 operator*(const Mat4& o) const {
+        return Mat4(Vec4(Transform(o.columns[0].Load())), Vec4(Transform(o.columns[1].Load())),
+                    Vec4(Transform(o.columns[2].Load())), Vec4(Transform(o.columns[3].Load())));
+    }
+
+    // Точка (w = 1) и направление (w = 0); проективное деление не выполняется
+    Vec3 TransformPoint(const Vec3& p) const {
+        simd::Float4 v = p.Load();
+        simd::Float4 r = simd::Mul(columns[0].Load(), simd::SplatLane<0>(v));
+        r = simd::MulAdd(columns[1].Load(), simd::SplatLane<1>(v), r);
+        r = simd::MulAdd(columns[2].Load(), simd::SplatLane<2>(v), r);
+        return Vec3(simd::Add(columns[3].Load(), r));
+    }
+    Vec3 TransformVector(const Vec3& d) const {
+        simd::Float4 v = d.Load();
+        simd::Float4 r = simd::Mul(columns[0].Load(), simd::SplatLane<0>(v));
+        r = simd::MulAdd(columns[1].Load(), simd::SplatLane<1>(v), r);
+        return Vec3(simd::MulAdd(columns[2].Load(), simd::SplatLane<2>(v), r));
+    }
+};
+
+static_assert(sizeof(Vec3) == 16 && alignof(Vec3) == 16, "Vec3 - один SIMD-регистр");
+static_assert(sizeof(Vec4) == 16 && sizeof(Quat) == 16, "Vec4/Quat - один SIMD-регистр");
+static_assert(sizeof(Mat4) == 64, "Mat4 - четыре столбца без заполнения");
@@ -0,0 +1,234 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Четыре float в регистре: SSE2 на x86/x64, NEON на ARM, иначе скалярная замена.
+// Основа для Vec3/Vec4/Quat/Mat4 (MathTypes.hpp) и пакетных функций (MathBatch.hpp).
+// Сравнения дают маску (все биты дорожки 1 или 0), выбор по маске - Select, без ветвлений.
+// RTGC_SIMD_SCALAR - принудительно скалярная реализация (сверка результатов, отладка).
+#if defined(RTGC_SIMD_SCALAR)
+#define RTGC_SIMD_SSE 0
+#define RTGC_SIMD_NEON 0
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RTGC_SIMD_SSE 1
+#define RTGC_SIMD_NEON 0
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define RTGC_SIMD_SSE 0
+#define RTGC_SIMD_NEON 1
+#else
+#define RTGC_SIMD_SSE 0
+#define RTGC_SIMD_NEON 0
+#endif
+
+namespace simd {
+
+#if RTGC_SIMD_SSE
+    using Float4 = __m128;
+
+    inline Float4 Load(const float* p) { return _mm_load_ps(p); }          // p выровнен на 16
+    inline Float4 LoadUnaligned(const float* p) { return _mm_loadu_ps(p); }
+    inline void Store(float* p, Float4 v) { _mm_store_ps(p, v); }
+    inline void StoreUnaligned(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+    inline Float4 Set(float x, float y, float z, float w) { return _mm_set_ps(w, z, y, x); }
+    inline Float4 Splat(float f) { return _mm_set1_ps(f); }
+    inline Float4 Zero() { return _mm_setzero_ps(); }
+
+    inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+    inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+    inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+    inline Float4 Div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+    inline Float4 Min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+    inline Float4 Max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+    inline Float4 Sqrt(Float4 a) { return _mm_sqrt_ps(a); }
+    // a * b + c; отдельными операциями, чтобы результат не зависел от наличия FMA
+    inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+    inline Float4 CmpGe(Float4 a, Float4 b) { return _mm_cmpge_ps(a, b); }
+    inline Float4 CmpEq(Float4 a, Float4 b) { return _mm_cmpeq_ps(a, b); }
+    inline Float4 And(Float4 a, Float4 b) { return _mm_and_ps(a, b); }
+    // Дорожки mask - из a, остальные - из b
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+    // Битовая маска дорожек: бит i - дорожка i
+    inline int MoveMask(Float4 mask) { return _mm_movemask_ps(mask); }
+
+    // Дорожка 0..3 во все четыре
+    template<int Lane>
+    inline Float4 SplatLane(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+    inline float GetX(Float4 v) { return _mm_cvtss_f32(v); }
+    inline Float4 ClearW(Float4 v) { return _mm_and_ps(v, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1))); }
+
+    // (y, z, x, w) и (z, x, y, w) - для векторного произведения
+    inline Float4 SwizzleYZXW(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)); }
+    inline Float4 SwizzleZXYW(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2)); }
+
+    // Сумма дорожек 0..2 во всех дорожках
+    inline Float4 HorizontalSum3(Float4 v) {
+        Float4 y = SplatLane<1>(v);
+        Float4 z = SplatLane<2>(v);
+        return _mm_add_ps(_mm_add_ps(SplatLane<0>(v), y), z);
+    }
+    inline Float4 HorizontalSum4(Float4 v) {
+        Float4 s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+#elif RTGC_SIMD_NEON
+    using Float4 = float32x4_t;
+
+    inline Float4 Load(const float* p) { return vld1q_f32(p); }
+    inline Float4 LoadUnaligned(const float* p) { return vld1q_f32(p); }
+    inline void Store(float* p, Float4 v) { vst1q_f32(p, v); }
+    inline void StoreUnaligned(float* p, Float4 v) { vst1q_f32(p, v); }
+    inline Float4 Set(float x, float y, float z, float w) {
+        const float values[4] = {x, y, z, w};
+        return vld1q_f32(values);
+    }
+    inline Float4 Splat(float f) { return vdupq_n_f32(f); }
+    inline Float4 Zero() { return vdupq_n_f32(0.0f); }
+
+    inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+    inline Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+    inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+#if defined(__aarch64__) || defined(_M_ARM64)
+    inline Float4 Div(Float4 a, Float4 b) { return vdivq_f32(a, b); }
+    inline Float4 Sqrt(Float4 a) { return vsqrtq_f32(a); }
+#else
+    // ARMv7 без деления: обратная величина с двумя шагами Ньютона
+    inline Float4 Div(Float4 a, Float4 b) {
+        Float4 r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+    }
+    inline Float4 Sqrt(Float4 a) {
+        Float4 r = vrsqrteq_f32(a);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+        // sqrt(0) = 0, а не 0 * inf
+        uint32x4_t zero = vceqq_f32(a, vdupq_n_f32(0.0f));
+        return vbslq_f32(zero, a, vmulq_f32(a, r));
+    }
+#endif
+    inline Float4 Min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+    inline Float4 Max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+    inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return vaddq_f32(vmulq_f32(a, b), c); }
+
+    inline Float4 CmpGe(Float4 a, Float4 b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+    inline Float4 CmpEq(Float4 a, Float4 b) { return vreinterpretq_f32_u32(vceqq_f32(a, b)); }
+    inline Float4 And(Float4 a, Float4 b) {
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+    }
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+    inline int MoveMask(Float4 mask) {
+        uint32x4_t m = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+        return static_cast<int>(vgetq_lane_u32(m, 0) | (vgetq_lane_u32(m, 1) << 1) |
+                                (vgetq_lane_u32(m, 2) << 2) | (vgetq_lane_u32(m, 3) << 3));
+    }
+
+    template<int Lane>
+    inline Float4 SplatLane(Float4 v) { return vdupq_n_f32(vgetq_lane_f32(v, Lane)); }
+    inline float GetX(Float4 v) { return vgetq_lane_f32(v, 0); }
+    inline Float4 ClearW(Float4 v) { return vsetq_lane_f32(0.0f, v, 3); }
+
+    inline Float4 SwizzleYZXW(Float4 v) {
+        float32x4_t yzwx = vextq_f32(v, v, 1);                 // y z w x
+        return vsetq_lane_f32(vgetq_lane_f32(v, 3), vsetq_lane_f32(vgetq_lane_f32(v, 0), yzwx, 2), 3);
+    }
+    inline Float4 SwizzleZXYW(Float4 v) {
+        float32x4_t zwxy = vextq_f32(v, v, 2);                 // z w x y
+        float32x4_t r = vsetq_lane_f32(vgetq_lane_f32(v, 0), zwxy, 1);
+        r = vsetq_lane_f32(vgetq_lane_f32(v, 1), r, 2);
+        return vsetq_lane_f32(vgetq_lane_f32(v, 3), r, 3);
+    }
+
+    inline Float4 HorizontalSum3(Float4 v) {
+        return vdupq_n_f32(vgetq_lane_f32(v, 0) + vgetq_lane_f32(v, 1) + vgetq_lane_f32(v, 2));
+    }
+    inline Float4 HorizontalSum4(Float4 v) {
+        float32x2_t s = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+        return vdupq_n_f32(vget_lane_f32(vpadd_f32(s, s), 0));
+    }
+#else
+    struct Float4 {
+        float v[4];
+    };
+
+    inline Float4 Load(const float* p) { Float4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    inline Float4 LoadUnaligned(const float* p) { return Load(p); }
+    inline void Store(float* p, Float4 v) { std::memcpy(p, v.v, sizeof(v.v)); }
+    inline void StoreUnaligned(float* p, Float4 v) { Store(p, v); }
+    inline Float4 Set(float x, float y, float z, float w) { return Float4{{x, y, z, w}}; }
+    inline Float4 Splat(float f) { return Float4{{f, f, f, f}}; }
+    inline Float4 Zero() { return Splat(0.0f); }
+
+    template<typename Op>
+    inline Float4 PerLane(Float4 a, Float4 b, Op op) {
+        return Float4{{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+    }
+
+    inline Float4 Add(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x + y; }); }
+    inline Float4 Sub(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x - y; }); }
+    inline Float4 Mul(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x * y; }); }
+    inline Float4 Div(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return x / y; }); }
+    inline Float4 Min(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return y < x ? y : x; }); }
+    inline Float4 Max(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return y > x ? y : x; }); }
+    inline Float4 Sqrt(Float4 a) { return Float4{{std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3])}}; }
+    inline Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Add(Mul(a, b), c); }
+
+    inline float MaskLane(bool on) {
+        uint32_t bits = on ? 0xFFFFFFFFu : 0u;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+    inline uint32_t Bits(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+    inline float FromBits(uint32_t bits) {
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    inline Float4 CmpGe(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return MaskLane(x >= y); }); }
+    inline Float4 CmpEq(Float4 a, Float4 b) { return PerLane(a, b, [](float x, float y) { return MaskLane(x == y); }); }
+    inline Float4 And(Float4 a, Float4 b) {
+        return PerLane(a, b, [](float x, float y) { return FromBits(Bits(x) & Bits(y)); });
+    }
+    inline Float4 Select(Float4 mask, Float4 a, Float4 b) {
+        Float4 r;
+        for (int i = 0; i < 4; ++i) r.v[i] = FromBits((Bits(mask.v[i]) & Bits(a.v[i])) | (~Bits(mask.v[i]) & Bits(b.v[i])));
+        return r;
+    }
+    inline int MoveMask(Float4 mask) {
+        return static_cast<int>((Bits(mask.v[0]) >> 31) | ((Bits(mask.v[1]) >> 31) << 1) |
+                                ((Bits(mask.v[2]) >> 31) << 2) | ((Bits(mask.v[3]) >> 31) << 3));
+    }
+
+    template<int Lane>
+    inline Float4 SplatLane(Float4 v) { return Splat(v.v[Lane]); }
+    inline float GetX(Float4 v) { return v.v[0]; }
+    inline Float4 ClearW(Float4 v) { v.v[3] = 0.0f; return v; }
+
+    inline Float4 SwizzleYZXW(Float4 v) { return Float4{{v.v[1], v.v[2], v.v[0], v.v[3]}}; }
+    inline Float4 SwizzleZXYW(Float4 v) { return Float4{{v.v[2], v.v[0], v.v[1], v.v[3]}}; }
+
+    inline Float4 HorizontalSum3(Float4 v) { return Splat(v.v[0] + v.v[1] + v.v[2]); }
+    inline Float4 HorizontalSum4(Float4 v) { return Splat(v.v[0] + v.v[1] + v.v[2] + v.v[3]); }
+#endif
+
+    inline Float4 Dot3(Float4 a, Float4 b) { return HorizontalSum3(Mul(a, b)); }
+    inline Float4 Dot4(Float4 a, Float4 b) { return HorizontalSum4(Mul(a, b)); }
+
+    // Векторное произведение по дорожкам 0..2; дорожка 3 - разность произведений w, при w = 0 равна 0
+    inline Float4 Cross3(Float4 a, Float4 b) {
+        Float4 t = Sub(Mul(a, SwizzleYZXW(b)), Mul(SwizzleYZXW(a), b)); // (z, x, y) компоненты результата
+        return SwizzleYZXW(t);
+    }
+}
@@ -12,10 +12,17 @@ public:
         return std::sqrt(x*x + y*y + z*z);
     }
 
+    float LengthSquared() const {
+        return x*x + y*y + z*z;
+    }
+
+    // Короче 1e-4 - нулевой вектор. Без ветвления: вызывается в циклах по тысячам тел,
+    // где непредсказуемый переход дороже лишнего умножения
     Vector3 Normalize() const {
         float len = Length();
-        if (len < 0.0001f) return Vector3(0.0f, 0.0f, 0.0f);
-        return Vector3(x/len, y/len, z/len);
+        float valid = static_cast<float>(len >= 0.0001f);
+        float safeLen = len + (1.0f - valid);
+        return Vector3(x / safeLen * valid, y / safeLen * valid, z / safeLen * valid);
     }
 
     Vector3 operator+(const Vector3& other) const {
@@ -30,11 +37,11 @@ public:
         return Vector3(x * scalar, y * scalar, z * scalar);
     }
 
+    // Делитель меньше 1e-4 по модулю даёт нулевой вектор, как и Normalize - без ветвления
     Vector3 operator/(float scalar) const {
-        if (std::abs(scalar) < 0.0001f) {
-            return Vector3(0.0f, 0.0f, 0.0f);
-        }
-        return Vector3(x / scalar, y / scalar, z / scalar);
+        float valid = static_cast<float>(std::abs(scalar) >= 0.0001f);
+        float safe = scalar + (1.0f - valid);
+        return Vector3(x / safe * valid, y / safe * valid, z / safe * valid);
     }
 
     Vector3& operator+=(const Vector3& other) {
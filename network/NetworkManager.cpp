@@ -1,47 +1,93 @@
 #include "NetworkManager.hpp"
+#include "../core/Metrics.hpp"
+#include "../core/Replay.hpp"
 #include <cstring> // for memcpy
 
+namespace {
+    struct NetworkMetrics {
+        MetricCounter& packetsSent = Metrics::GetCounter("rtgc_net_packets_sent_total", "Пакетов отправлено");
+        MetricCounter& bytesSent = Metrics::GetCounter("rtgc_net_bytes_sent_total", "Байт отправлено");
+        MetricCounter& packetsReceived = Metrics::GetCounter("rtgc_net_packets_received_total", "Пакетов получено");
+        MetricCounter& bytesReceived = Metrics::GetCounter("rtgc_net_bytes_received_total", "Байт получено");
+        MetricCounter& packetsRejected = Metrics::GetCounter("rtgc_net_packets_rejected_total",
+                                                             "Пакетов отброшено: неверный размер или игрок");
+    };
+
+    NetworkMetrics& GetMetrics() {
+        static NetworkMetrics metrics;
+        return metrics;
+    }
+}
+
 NetworkManager::NetworkManager() {
     std::fill(playerStates.begin(), playerStates.end(), PlayerState{});
 }
 
 bool NetworkManager::StartServer(unsigned short port, int maxClients) {
+    if (Replay::IsReplaying()) {
+        LOG_INFO(Network, "Воспроизведение сессии: пакеты из записи, сервер не запускается");
+        return true;
+    }
     enet_initialize();
     ENetAddress addr;
     addr.host = ENET_HOST_ANY;
     addr.port = port;
     server = enet_host_create(&addr, maxClients, 2, 0, 0);
     if (!server) {
-        ERROR(L"Сервер не запущен");
+        LOG_ERROR(Network, "Сервер не запущен");
         return false;
     }
-    LOG(L"Сетевой сервер запущен");
+    LOG_INFO(Network, "Сетевой сервер запущен");
     return true;
 }
 
 void NetworkManager::SendPlayerState(const PlayerState& state) {
+    if (!server) return;
     ENetPacket* packet = enet_packet_create(&state, sizeof(state), ENET_PACKET_FLAG_RELIABLE);
     if (packet) {
         enet_host_broadcast(server, 0, packet);
+        NetworkMetrics& metrics = GetMetrics();
+        metrics.packetsSent.Add();
+        metrics.bytesSent.Add(sizeof(state));
     }
 }
 
 void NetworkManager::Update() {
+    // При воспроизведении сессии пакеты тика берутся из записи, сокет не опрашивается
+    if (Replay::IsReplaying()) {
+        for (const std::string& packet : Replay::TakeTickPackets()) {
+            HandlePacket(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
+        }
+        return;
+    }
+    if (!server) return;
+
     ENetEvent event;
     while (enet_host_service(server, &event, 0) > 0) {
         if (event.type == ENET_EVENT_TYPE_RECEIVE) {
-            if (event.packet->dataLength == sizeof(PlayerState)) {
-                PlayerState s;
-                std::memcpy(&s, event.packet->data, sizeof(PlayerState));
-                if (s.playerId < playerStates.size()) {
-                    playerStates[s.playerId] = s;
-                }
-            }
+            Replay::RecordPacket(event.packet->data, event.packet->dataLength);
+            HandlePacket(event.packet->data, event.packet->dataLength);
             enet_packet_destroy(event.packet);
         }
     }
 }
 
+void NetworkManager::HandlePacket(const uint8_t* data, size_t size) {
+    NetworkMetrics& metrics = GetMetrics();
+    metrics.packetsReceived.Add();
+    metrics.bytesReceived.Add(size);
+    bool accepted = false;
+    if (size == sizeof(PlayerState)) {
+        PlayerState s;
+        std::memcpy(&s, data, sizeof(PlayerState));
+        if (s.playerId < playerStates.size()) {
+            playerStates[s.playerId] = s;
+            accepted = true;
+        }
+    }
+    if (!accepted) metrics.packetsRejected.Add();
+}
+
 const std::array<PlayerState, 8>& NetworkManager::GetPlayerStates() const {
     return playerStates;
 }
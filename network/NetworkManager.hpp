@@ -2,11 +2,15 @@
 #include <enet/enet.h>
 #include "PlayerState.hpp"
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include "../core/Logger.hpp"
 
 class NetworkManager {
     ENetHost* server = nullptr;
     std::array<PlayerState, 8> playerStates;
+
+    void HandlePacket(const uint8_t* data, size_t size);
 public:
     NetworkManager();
     ~NetworkManager();
@@ -50,7 +50,7 @@ void NetworkServer::Stop() {
     if (running) {
         running = false;
         for (auto client : clients) {
-            delete client;
+            MemoryTracker::Delete(MemoryTag::Network, client);
         }
         clients.clear();
         Logger::Log("Сервер остановлен");
@@ -79,14 +79,14 @@ NetworkSystem::~NetworkSystem() {
 bool NetworkSystem::StartServer(int port) {
     if (server) return false;
     
-    server = new NetworkServer(port);
+    server = MemoryTracker::New<NetworkServer>(MemoryTag::Network, port);
     if (server->Start()) {
         isServer = true;
         enabled = true;
         Logger::Log("NetworkSystem запущен как сервер");
         return true;
     } else {
-        delete server;
+        MemoryTracker::Delete(MemoryTag::Network, server);
         server = nullptr;
         return false;
     }
@@ -95,14 +95,14 @@ bool NetworkSystem::StartServer(int port) {
 bool NetworkSystem::ConnectToServer(const std::string& address, int port) {
     if (client) return false;
     
-    client = new NetworkClient(address, port);
+    client = MemoryTracker::New<NetworkClient>(MemoryTag::Network, address, port);
     if (client->Connect()) {
         isServer = false;
         enabled = true;
         Logger::Log("NetworkSystem подключен к серверу");
         return true;
     } else {
-        delete client;
+        MemoryTracker::Delete(MemoryTag::Network, client);
         client = nullptr;
         return false;
     }
@@ -111,13 +111,13 @@ bool NetworkSystem::ConnectToServer(const std::string& address, int port) {
 void NetworkSystem::Disconnect() {
     if (server) {
         server->Stop();
-        delete server;
+        MemoryTracker::Delete(MemoryTag::Network, server);
         server = nullptr;
     }
     
     if (client) {
         client->Disconnect();
-        delete client;
+        MemoryTracker::Delete(MemoryTag::Network, client);
         client = nullptr;
     }
     
@@ -1,5 +1,6 @@
 #pragma once
 #include "../math/Vector3.hpp"
+#include "../core/MemoryTracker.hpp"
 #include <vector>
 #include <string>
 #include <functional>
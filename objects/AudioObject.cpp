@@ -1,14 +1,15 @@
 #include "AudioObject.hpp"
 #include "../core/Logger.hpp"
+#include "../math/MathInterop.hpp"
 
 AudioObject::AudioObject(const std::string& name, const Vector3& pos, const std::string& sound, AudioSystem* sys)
     : GameObject(name, pos), soundName(sound), audioSystem(sys), isPlaying(false) {
-    LOG(L"Создан AudioObject: " + std::wstring(name.begin(), name.end()));
+    LOG_DEBUG(World, "Создан AudioObject: ", name);
 }
 
 void AudioObject::Play(bool loop) {
     if (audioSystem) {
-        audioSystem->PlayAt(soundName, position.ToGLM(), loop);
+        audioSystem->PlayAt(soundName, ToGLM(position), loop);
         isPlaying = true;
     }
 }
@@ -22,7 +23,7 @@ void AudioObject::Update(float dt) {
     GameObject::Update(dt);
     // Здесь можно обновлять позицию звука при движении объекта
     if (audioSystem && isPlaying) {
-        audioSystem->PlayAt(soundName, position.ToGLM(), true);
+        audioSystem->PlayAt(soundName, ToGLM(position), true);
     }
 }
 
@@ -3,7 +3,7 @@
 
 GameObject::GameObject(const std::string& n, const Vector3& pos)
     : name(n), position(pos), rotation(1,0,0,0), scale(1,1,1), isActive(true) {
-    LOG(L"Создан GameObject: " + std::wstring(name.begin(), name.end()));
+    LOG_DEBUG(World, "Создан GameObject: ", name);
 }
 
 void GameObject::AddComponent(std::unique_ptr<Component> comp) {
@@ -1,12 +1,13 @@
 #include "PhysicsObject.hpp"
 #include "../core/Logger.hpp"
+#include "../math/MathInterop.hpp"
 
 PhysicsObject::PhysicsObject(const std::string& name, const Vector3& pos, float m, physx::PxMaterial* mat)
     : GameObject(name, pos), mass(m), material(mat), rigidBody(nullptr) {
 
     // Создание физического тела
     rigidBody = PhysXInitializer::gPhysics->createRigidDynamic(
-        physx::PxTransform(pos.ToPxVec3())
+        physx::PxTransform(ToPhysX(pos))
     );
 
     if (rigidBody) {
@@ -19,9 +20,9 @@ PhysicsObject::PhysicsObject(const std::string& name, const Vector3& pos, float
         shape->release();
 
         PhysXInitializer::gScene->addActor(*rigidBody);
-        LOG(L"Создан PhysicsObject: " + std::wstring(name.begin(), name.end()));
+        LOG_DEBUG(World, "Создан PhysicsObject: ", name);
     } else {
-        ERROR(L"Не удалось создать PhysicsObject: " + std::wstring(name.begin(), name.end()));
+        LOG_ERROR(World, "Не удалось создать PhysicsObject: ", name);
     }
 }
 
@@ -38,13 +39,13 @@ void PhysicsObject::Update(float dt) {
 
 void PhysicsObject::ApplyForce(const Vector3& force) {
     if (rigidBody) {
-        rigidBody->addForce(force.ToPxVec3(), physx::PxForceMode::eFORCE);
+        rigidBody->addForce(ToPhysX(force), physx::PxForceMode::eFORCE);
     }
 }
 
 void PhysicsObject::ApplyImpulse(const Vector3& impulse) {
     if (rigidBody) {
-        rigidBody->addForce(impulse.ToPxVec3(), physx::PxForceMode::eIMPULSE);
+        rigidBody->addForce(ToPhysX(impulse), physx::PxForceMode::eIMPULSE);
     }
 }
 
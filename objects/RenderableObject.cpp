@@ -1,9 +1,10 @@
 #include "RenderableObject.hpp"
 #include "../core/Logger.hpp"
+#include "../math/MathInterop.hpp"
 
 RenderableObject::RenderableObject(const std::string& name, const Vector3& pos, Shader* sh)
     : GameObject(name, pos), shader(sh) {
-    LOG(L"Создан RenderableObject: " + std::wstring(name.begin(), name.end()));
+    LOG_DEBUG(World, "Создан RenderableObject: ", name);
 }
 
 void RenderableObject::AddMesh(Mesh* mesh) {
@@ -13,9 +14,9 @@ void RenderableObject::AddMesh(Mesh* mesh) {
 void RenderableObject::Update(float dt) {
     GameObject::Update(dt);
     // Обновление модели матрицы на основе позиции, вращения и масштаба
-    modelMatrix = glm::translate(glm::mat4(1.0f), position.ToGLM());
+    modelMatrix = glm::translate(glm::mat4(1.0f), ToGLM(position));
     modelMatrix *= glm::toMat4(rotation);
-    modelMatrix = glm::scale(modelMatrix, scale.ToGLM());
+    modelMatrix = glm::scale(modelMatrix, ToGLM(scale));
 }
 
 void RenderableObject::Render() {
@@ -1,9 +1,11 @@
 #include "CharacterController.hpp"
 #include "../math/Vector3.hpp"
+#include "../world/Terrain.hpp"
 #include <iostream>
+#include <cmath>
 
 CharacterController::CharacterController()
-    : position(0.0f, 10.0f, 0.0f), velocity(0.0f, 0.0f, 0.0f), onGround(true)
+    : position(0.0f, 10.0f, 0.0f), velocity(0.0f, 0.0f, 0.0f), groundNormal(0.0f, 1.0f, 0.0f), onGround(true)
 {
 }
 
@@ -14,16 +16,54 @@ void CharacterController::Initialize() {
     std::cout << "CharacterController initialized" << std::endl;
 }
 
+float CharacterController::GetGroundHeight(float x, float z) const {
+    return terrain ? terrain->GetHeightAt(x, z) : 0.0f;
+}
+
+Vector3 CharacterController::GetGroundNormal(float x, float z) const {
+    return terrain ? terrain->GetNormalAt(x, z) : Vector3(0.0f, 1.0f, 0.0f);
+}
+
+bool CharacterController::IsWalkable(const Vector3& normal) const {
+    // Нормаль единичная, поэтому её y - косинус угла наклона
+    return normal.y >= std::cos(maxSlopeAngle * 3.14159265f / 180.0f);
+}
+
 void CharacterController::Update(float dt) {
+    float ground = GetGroundHeight(position.x, position.z);
+
+    if (onGround) {
+        groundNormal = GetGroundNormal(position.x, position.z);
+
+        if (position.y - ground > stepHeight) {
+            // Сошли с уступа
+            onGround = false;
+        } else if (!IsWalkable(groundNormal)) {
+            // Слишком крутой склон: соскальзываем вдоль поверхности
+            Vector3 gravity(0.0f, -9.81f, 0.0f);
+            Vector3 slide = gravity - groundNormal * gravity.Dot(groundNormal);
+            velocity += slide * dt;
+            position.x += velocity.x * dt;
+            position.z += velocity.z * dt;
+            position.y = GetGroundHeight(position.x, position.z);
+            return;
+        } else {
+            position.y = ground;
+            velocity.y = 0.0f;
+        }
+    }
+
     // Простая гравитация
     if (!onGround) {
         velocity.y -= 9.81f * dt;
         position.y += velocity.y * dt;
 
         // Проверка приземления
-        if (position.y <= 0.0f) {
-            position.y = 0.0f;
+        ground = GetGroundHeight(position.x, position.z);
+        if (position.y <= ground) {
+            position.y = ground;
             velocity.y = 0.0f;
+            groundNormal = GetGroundNormal(position.x, position.z);
             onGround = true;
         }
     }
@@ -40,8 +80,21 @@ void CharacterController::Move(const Vector3& direction, float dt) {
     velocity.x = direction.x * 5.0f;
     velocity.z = direction.z * 5.0f;
 
-    position.x += velocity.x * dt;
-    position.z += velocity.z * dt;
+    float nextX = position.x + velocity.x * dt;
+    float nextZ = position.z + velocity.z * dt;
+
+    if (onGround) {
+        // Не даём подниматься по склону круче допустимого
+        float rise = GetGroundHeight(nextX, nextZ) - position.y;
+        if (rise > 0.0f && !IsWalkable(GetGroundNormal(nextX, nextZ))) {
+            velocity.x = 0.0f;
+            velocity.z = 0.0f;
+            return;
+        }
+    }
+
+    position.x = nextX;
+    position.z = nextZ;
 }
 
 void CharacterController::Jump() {
@@ -58,5 +111,5 @@ Vector3 CharacterController::GetPosition() const {
 void CharacterController::SetPosition(const Vector3& pos) {
     position = pos;
     velocity = Vector3(0.0f, 0.0f, 0.0f);
-    onGround = (position.y <= 0.01f);
-}
\ No newline at end of file
+    onGround = (position.y <= GetGroundHeight(position.x, position.z) + 0.01f);
+}
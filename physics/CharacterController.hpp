@@ -4,13 +4,23 @@
 
 using namespace std;
 
+class Terrain;
+
 class CharacterController {
 private:
     Vector3 position;
     Vector3 velocity;
+    Vector3 groundNormal;
     float height = 1.8f;
     float radius = 0.4f;
+    float maxSlopeAngle = 45.0f; // градусы
+    float stepHeight = 0.3f;
     bool onGround = true;
+    const Terrain* terrain = nullptr;
+
+    float GetGroundHeight(float x, float z) const;
+    Vector3 GetGroundNormal(float x, float z) const;
+    bool IsWalkable(const Vector3& normal) const;
 
 public:
     CharacterController();
@@ -24,7 +34,15 @@ public:
     void Jump();
     Vector3 GetPosition() const;
     void SetPosition(const Vector3& pos);
+    // Перенос начала координат (WorldOrigin): позиция смещается, скорость и контакт с землёй сохраняются
+    void ShiftOrigin(const Vector3& shift) { position -= shift; }
+
+    // Без ландшафта землёй считается плоскость y=0
+    void SetTerrain(const Terrain* t) { terrain = t; }
+    void SetMaxSlopeAngle(float degrees) { maxSlopeAngle = degrees; }
+    float GetMaxSlopeAngle() const { return maxSlopeAngle; }
+    Vector3 GetGroundNormal() const { return groundNormal; }
 
     void* GetPxController() const { return nullptr; } // Заглушка для PhysX
     bool IsOnGround() const { return onGround; }
-};
\ No newline at end of file
+};
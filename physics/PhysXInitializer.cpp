@@ -1,4 +1,5 @@
 #include "PhysXInitializer.hpp"
+#include <thread>
 
 PxFoundation* PhysXInitializer::gFoundation = nullptr;
 PxPhysics* PhysXInitializer::gPhysics = nullptr;
@@ -8,11 +9,12 @@ PxMaterial* PhysXInitializer::gMaterial = nullptr;
 PxPvd* PhysXInitializer::gPvd = nullptr;
 PxDefaultAllocator PhysXInitializer::gAllocator;
 PxDefaultErrorCallback PhysXInitializer::gErrorCallback;
+uint32_t PhysXInitializer::gDispatcherThreads = 0;
 
-bool PhysXInitializer::Init() {
+bool PhysXInitializer::Init(uint32_t dispatcherThreads) {
     gFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
     if (!gFoundation) {
-        ERROR(L"Не удалось создать PxFoundation");
+        LOG_ERROR(Physics, "Не удалось создать PxFoundation");
         return false;
     }
     gPvd = PxCreatePvd(*gFoundation);
@@ -20,21 +22,26 @@ bool PhysXInitializer::Init() {
     gPvd->connect(*transport, PxPvdInstrumentationFlag::eALL);
     gPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *gFoundation, PxTolerancesScale(), true, gPvd);
     if (!gPhysics) {
-        ERROR(L"Не удалось создать PxPhysics");
+        LOG_ERROR(Physics, "Не удалось создать PxPhysics");
         return false;
     }
     gMaterial = gPhysics->createMaterial(0.5f, 0.5f, 0.6f);
     if (!gMaterial) {
-        ERROR(L"Не удалось создать материал");
+        LOG_ERROR(Physics, "Не удалось создать материал");
         return false;
     }
     if (!PxInitExtensions(*gPhysics, gPvd)) {
-        ERROR(L"PxInitExtensions failed");
+        LOG_ERROR(Physics, "PxInitExtensions failed");
         return false;
     }
-    gCpuDispatcher = PxDefaultCpuDispatcherCreate(4);
+    if (dispatcherThreads == 0) {
+        unsigned int cores = std::thread::hardware_concurrency();
+        dispatcherThreads = cores > 1 ? cores - 1 : 1;
+    }
+    gDispatcherThreads = dispatcherThreads;
+    gCpuDispatcher = PxDefaultCpuDispatcherCreate(gDispatcherThreads);
     if (!gCpuDispatcher) {
-        ERROR(L"Не удалось создать CpuDispatcher");
+        LOG_ERROR(Physics, "Не удалось создать CpuDispatcher");
         return false;
     }
     PxSceneDesc sceneDesc(gPhysics->getTolerancesScale());
@@ -48,12 +55,12 @@ bool PhysXInitializer::Init() {
     sceneDesc.maxNbContactDataBlocksPerFrame = 512;
     gScene = gPhysics->createScene(sceneDesc);
     if (!gScene) {
-        ERROR(L"Не удалось создать сцену");
+        LOG_ERROR(Physics, "Не удалось создать сцену");
         return false;
     }
     PxInitVehicleSDK(*gPhysics);
     PxVehicleSetUpdateMode(PxVehicleUpdateMode::eVELOCITY_CHANGE);
-    LOG(L"PhysX успешно инициализирован");
+    LOG_INFO(Physics, "PhysX успешно инициализирован, потоков диспетчера: ", gDispatcherThreads);
     return true;
 }
 
@@ -6,6 +6,7 @@
 #include <vehicle/PxVehicleAPI.h>
 #include <extensions/PxDefaultSimulationFilterShader.h>
 #include "../core/Logger.hpp"
+#include <cstdint>
 using namespace physx;
 
 class PhysXInitializer {
@@ -16,9 +17,12 @@ public:
     static PxScene* gScene;
     static PxMaterial* gMaterial;
     static PxPvd* gPvd;
-    static bool Init();
+    // dispatcherThreads = 0: по числу ядер минус поток игры
+    static bool Init(uint32_t dispatcherThreads = 0);
+    static uint32_t GetDispatcherThreadCount() { return gDispatcherThreads; }
     static void Shutdown();
 private:
     static PxDefaultAllocator gAllocator;
     static PxDefaultErrorCallback gErrorCallback;
+    static uint32_t gDispatcherThreads;
 };
\ No newline at end of file
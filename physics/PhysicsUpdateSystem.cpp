@@ -1,23 +1,89 @@
 #include "PhysicsUpdateSystem.hpp"
 #include "PhysXInitializer.hpp"
 #include "../game/Vehicle.hpp" // Для доступа к VehicleComponent
+#include "../game/VehicleManager.hpp"
 #include <thread>
 #include <mutex>
 
 std::mutex PhysicsUpdateSystem::mMutex;
 std::mutex PhysicsUpdateSystem::ecsMutex;
+bool PhysicsUpdateSystem::simulating = false;
+std::chrono::steady_clock::time_point PhysicsUpdateSystem::simulateStart;
+VehicleManager* PhysicsUpdateSystem::vehicleManager = nullptr;
+PhysicsUpdateSystem::StepStats PhysicsUpdateSystem::lastStats;
+double PhysicsUpdateSystem::overlapAccumMs = 0.0;
+double PhysicsUpdateSystem::waitAccumMs = 0.0;
+int PhysicsUpdateSystem::statsSteps = 0;
 
-void PhysicsUpdateSystem::Update(float dt, entt::registry& registry) {
-    auto vehicles = registry.view<VehicleComponent>();
-    for (auto entity : vehicles) {
-        auto& vcomp = vehicles.get<VehicleComponent>(entity);
-        if (vcomp.vehicle) {
-            vcomp.vehicle->Update(dt);
+static constexpr int STATS_REPORT_INTERVAL = 600; // шагов между отчётами в лог
+
+void PhysicsUpdateSystem::BeginSimulation(float dt, entt::registry& registry) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (simulating) {
+        // Предыдущий шаг не забрали - забираем, иначе PhysX откажет в simulate()
+        PhysXInitializer::gScene->fetchResults(true);
+        simulating = false;
+    }
+
+    if (vehicleManager) {
+        vehicleManager->Update(dt);
+    } else {
+        auto vehicles = registry.view<VehicleComponent>();
+        for (auto entity : vehicles) {
+            auto& vcomp = vehicles.get<VehicleComponent>(entity);
+            if (vcomp.vehicle) {
+                vcomp.vehicle->Update(dt);
+            }
         }
     }
-    std::lock_guard<std::mutex> lock(mMutex);
+
+    simulateStart = std::chrono::steady_clock::now();
     PhysXInitializer::gScene->simulate(dt);
-    while (!PhysXInitializer::gScene->fetchResults()) {
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    simulating = true;
+}
+
+void PhysicsUpdateSystem::FetchResults() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!simulating) return;
+
+    auto fetchStart = std::chrono::steady_clock::now();
+    lastStats.readyOnFetch = PhysXInitializer::gScene->checkResults(false);
+    // Блокирующее ожидание на событии PhysX вместо опроса со sleep
+    PhysXInitializer::gScene->fetchResults(true);
+    simulating = false;
+    auto fetchEnd = std::chrono::steady_clock::now();
+
+    lastStats.overlapMs = std::chrono::duration<float, std::milli>(fetchStart - simulateStart).count();
+    lastStats.waitMs = std::chrono::duration<float, std::milli>(fetchEnd - fetchStart).count();
+    lastStats.totalMs = std::chrono::duration<float, std::milli>(fetchEnd - simulateStart).count();
+
+    overlapAccumMs += lastStats.overlapMs;
+    waitAccumMs += lastStats.waitMs;
+    if (++statsSteps >= STATS_REPORT_INTERVAL) {
+        LOG_DEBUG(Physics, "PhysX: перекрытие ", GetAverageOverlapMs(), " мс, ожидание ", GetAverageWaitMs(),
+                  " мс (среднее за ", statsSteps, " шагов)");
+        overlapAccumMs = 0.0;
+        waitAccumMs = 0.0;
+        statsSteps = 0;
     }
-}
\ No newline at end of file
+}
+
+void PhysicsUpdateSystem::Update(float dt, entt::registry& registry) {
+    BeginSimulation(dt, registry);
+    FetchResults();
+}
+
+void PhysicsUpdateSystem::ShiftOrigin(const Vector3& shift) {
+    FetchResults();
+    std::lock_guard<std::mutex> lock(mMutex);
+    // PhysX сдвигает все актёры, контроллеры и кэши контактов на -shift
+    PhysXInitializer::gScene->shiftOrigin(physx::PxVec3(shift.x, shift.y, shift.z));
+}
+
+float PhysicsUpdateSystem::GetAverageOverlapMs() {
+    return statsSteps > 0 ? static_cast<float>(overlapAccumMs / statsSteps) : lastStats.overlapMs;
+}
+
+float PhysicsUpdateSystem::GetAverageWaitMs() {
+    return statsSteps > 0 ? static_cast<float>(waitAccumMs / statsSteps) : lastStats.waitMs;
+}
@@ -1,11 +1,51 @@
 #pragma once
 #include <entt/entt.hpp>
+#include "../math/Vector3.hpp"
 #include <thread>
 #include <mutex>
+#include <chrono>
 
+class VehicleManager;
+
+// Шаг PhysX разделён на две фазы, чтобы симуляция шла параллельно с логикой кадра:
+//   BeginSimulation() - в начале кадра (ввод транспорта + simulate)
+//   ... ИИ, сеть, звук, погода ...
+//   FetchResults()    - перед рендером
 class PhysicsUpdateSystem {
     static std::mutex mMutex;
     static std::mutex ecsMutex;
+    static bool simulating;
+    static std::chrono::steady_clock::time_point simulateStart;
+    static VehicleManager* vehicleManager;
+
 public:
+    struct StepStats {
+        float overlapMs = 0.0f;   // от simulate() до вызова FetchResults (полезная работа кадра)
+        float waitMs = 0.0f;      // сколько FetchResults ждал PhysX
+        float totalMs = 0.0f;     // полное время шага от simulate() до результатов
+        bool readyOnFetch = false; // результаты были готовы к моменту FetchResults
+    };
+
+    static void BeginSimulation(float dt, entt::registry& registry);
+    static void FetchResults();
+    static bool IsSimulating() { return simulating; }
+
+    // С менеджером транспорт обновляется пакетно, без него - по сущностям реестра
+    static void SetVehicleManager(VehicleManager* manager) { vehicleManager = manager; }
+
+    // Синхронный шаг для кода, которому не нужно перекрытие
     static void Update(float dt, entt::registry& registry);
-};
\ No newline at end of file
+
+    // Перенос начала координат (WorldOrigin) в сцене PhysX; незабранный шаг сначала забирается
+    static void ShiftOrigin(const Vector3& shift);
+
+    static const StepStats& GetLastStats() { return lastStats; }
+    static float GetAverageOverlapMs();
+    static float GetAverageWaitMs();
+
+private:
+    static StepStats lastStats;
+    static double overlapAccumMs;
+    static double waitAccumMs;
+    static int statsSteps;
+};
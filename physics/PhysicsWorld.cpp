@@ -1,6 +1,17 @@
 #include "PhysicsWorld.hpp"
 #include "../core/Logger.hpp"
+#include "../core/Metrics.hpp"
+#include "../world/Terrain.hpp"
 #include <algorithm>
+#include <cmath>
+
+namespace {
+    // Сумма по всем мирам: меняется при создании и удалении тел
+    MetricGauge& BodyCountGauge() {
+        static MetricGauge& gauge = Metrics::GetGauge("rtgc_physics_bodies", "Тел во всех PhysicsWorld");
+        return gauge;
+    }
+}
 
 PhysicsBody::PhysicsBody(const Vector3& pos, float m, bool staticBody) 
     : position(pos), mass(m), isStatic(staticBody) {
@@ -21,14 +32,48 @@ void PhysicsBody::Update(float dt) {
 
 void PhysicsBody::ApplyForce(const Vector3& force) {
     if (isStatic || mass <= 0.0f) return;
+    Wake();
     acceleration += force / mass;
 }
 
 void PhysicsBody::ApplyImpulse(const Vector3& impulse) {
     if (isStatic || mass <= 0.0f) return;
+    Wake();
     velocity += impulse / mass;
 }
 
+void PhysicsBody::Wake() {
+    if (!sleeping) return;
+    if (world) {
+        world->WakeBody(this);
+    } else {
+        sleeping = false;
+        sleepTimer = 0.0f;
+    }
+}
+
+void PhysicsBody::SetPosition(const Vector3& pos) {
+    if (isStatic && world) {
+        // Статика лежит в сетке покоя по позиции - перекладываем
+        world->RemoveResting(this);
+        position = pos;
+        world->AddResting(this);
+        return;
+    }
+    Wake();
+    position = pos;
+}
+
+void PhysicsBody::SetVelocity(const Vector3& vel) {
+    Wake();
+    velocity = vel;
+}
+
+void PhysicsBody::SetRadius(float r) {
+    radius = r;
+    if (world) world->OnBodyRadiusChanged(this);
+}
+
 float PhysicsBody::GetKineticEnergy() const {
     return 0.5f * mass * velocity.LengthSquared();
 }
@@ -41,50 +86,312 @@ PhysicsWorld::PhysicsWorld(const Vector3& grav) : gravity(grav), enabled(true) {
     Logger::Log("PhysicsWorld создан с гравитацией: (", gravity.x, ", ", gravity.y, ", ", gravity.z, ")");
 }
 
+PhysicsWorld::~PhysicsWorld() {
+    BodyCountGauge().Add(-static_cast<int64_t>(bodies.size()));
+    for (PhysicsBody* body : bodies) bodyPool.Delete(body);
+}
+
+int64_t PhysicsWorld::CellKey(const Vector3& pos) const {
+    // По 21 биту на ось: достаточно для ±1M ячеек
+    int64_t cx = static_cast<int64_t>(std::floor(pos.x / cellSize)) & 0x1FFFFF;
+    int64_t cy = static_cast<int64_t>(std::floor(pos.y / cellSize)) & 0x1FFFFF;
+    int64_t cz = static_cast<int64_t>(std::floor(pos.z / cellSize)) & 0x1FFFFF;
+    return (cx << 42) | (cy << 21) | cz;
+}
+
+void PhysicsWorld::AddResting(PhysicsBody* body) {
+    restingGrid[CellKey(body->position)].push_back(body);
+}
+
+void PhysicsWorld::RemoveResting(PhysicsBody* body) {
+    auto it = restingGrid.find(CellKey(body->position));
+    if (it == restingGrid.end()) return;
+    auto& cell = it->second;
+    cell.erase(std::remove(cell.begin(), cell.end(), body), cell.end());
+    if (cell.empty()) restingGrid.erase(it);
+}
+
+void PhysicsWorld::WakeBody(PhysicsBody* body) {
+    if (!body->sleeping) return;
+    RemoveResting(body);
+    body->sleeping = false;
+    body->sleepTimer = 0.0f;
+    awakeBodies.push_back(body);
+}
+
+void PhysicsWorld::SleepBody(PhysicsBody* body) {
+    body->sleeping = true;
+    body->velocity = Vector3(0, 0, 0);
+    body->acceleration = Vector3(0, 0, 0);
+    AddResting(body);
+}
+
+void PhysicsWorld::OnBodyRadiusChanged(PhysicsBody* body) {
+    if (body->radius * 2.0f <= cellSize) return;
+    
+    // Ячейка должна вмещать самое крупное тело: пересобираем сетку покоя
+    cellSize = body->radius * 2.0f;
+    restingGrid.clear();
+    for (PhysicsBody* b : bodies) {
+        if (b->isStatic || b->sleeping) AddResting(b);
+    }
+}
+
 void PhysicsWorld::Update(float dt) {
     if (!enabled) return;
     
-    for (auto& body : bodies) {
-        if (body && !body->IsStatic()) {
-            // Применяем гравитацию
-            body->ApplyForce(gravity * body->GetMass());
-            body->Update(dt);
+    activeBodies.clear();
+    queryX.clear();
+    queryZ.clear();
+    
+    // Спящие тела в шаге не участвуют вовсе
+    for (PhysicsBody* body : awakeBodies) {
+        // Применяем гравитацию
+        body->acceleration += gravity;
+        body->Update(dt);
+        
+        activeBodies.push_back(body);
+        queryX.push_back(body->position.x);
+        queryZ.push_back(body->position.z);
+    }
+    
+    ResolveGroundContacts();
+    FindContacts();
+    ResolveContacts();
+    UpdateIslands(dt);
+}
+
+void PhysicsWorld::ResolveGroundContacts() {
+    size_t count = activeBodies.size();
+    groundHeights.resize(count);
+    
+    // Один пакетный запрос высот на все тела вместо вызова на каждое
+    if (terrain) {
+        terrain->GetHeightsAt(queryX.data(), queryZ.data(), groundHeights.data(), count);
+    } else {
+        std::fill(groundHeights.begin(), groundHeights.end(), 0.0f);
+    }
+    
+    // Нормаль нужна только для тел в контакте: они собираются подряд, queryX/queryZ
+    // переписываются на месте (индекс контакта не больше индекса тела)
+    groundContacts.clear();
+    for (size_t i = 0; i < count; ++i) {
+        PhysicsBody* body = activeBodies[i];
+        if (body->position.y >= groundHeights[i]) continue;
+        body->position.y = groundHeights[i];
+        queryX[groundContacts.size()] = queryX[i];
+        queryZ[groundContacts.size()] = queryZ[i];
+        groundContacts.push_back(body);
+    }
+    
+    size_t contactCount = groundContacts.size();
+    groundNormals.resize(contactCount);
+    if (terrain) {
+        terrain->GetNormalsAt(queryX.data(), queryZ.data(), groundNormals.data(), contactCount);
+    } else {
+        std::fill(groundNormals.begin(), groundNormals.end(), Vector3(0, 1, 0));
+    }
+    
+    for (size_t i = 0; i < contactCount; ++i) {
+        PhysicsBody* body = groundContacts[i];
+        const Vector3& normal = groundNormals[i];
+        Vector3& vel = body->velocity;
+        float vn = vel.Dot(normal);
+        if (vn < 0.0f) {
+            // Отскок с затуханием вдоль нормали, касательная скорость сохраняется
+            float bounce = (-vn > bounceThreshold) ? restitution : 0.0f;
+            vel -= normal * (vn * (1.0f + bounce));
             
-            // Простая проверка земли
-            Vector3 pos = body->GetPosition();
-            if (pos.y < 0.0f) {
-                pos.y = 0.0f;
-                body->SetPosition(pos);
-                
-                // Гасим вертикальную скорость при столкновении с землей
-                Vector3 vel = body->GetVelocity();
-                if (vel.y < 0) {
-                    vel.y = -vel.y * 0.3f; // Отскок с затуханием
-                    body->SetVelocity(vel);
+            // Кулоново трение: тело на пологом склоне останавливается и может уснуть
+            Vector3 tangent = vel - normal * vel.Dot(normal);
+            float vt = tangent.Length();
+            float maxFriction = friction * -vn;
+            if (vt <= maxFriction) {
+                vel -= tangent;
+            } else {
+                vel -= tangent * (maxFriction / vt);
+            }
+        }
+    }
+}
+
+void PhysicsWorld::FindContacts() {
+    contacts.clear();
+    // Ячейки прошлого шага очищаются с сохранением памяти (тела обычно остаются в тех же ячейках),
+    // а пустовавшие весь прошлый шаг удаляются: карта не растёт со всеми ячейками, где бывали тела
+    for (auto it = awakeGrid.begin(); it != awakeGrid.end();) {
+        if (it->second.empty()) {
+            it = awakeGrid.erase(it);
+        } else {
+            it->second.clear();
+            ++it;
+        }
+    }
+    
+    for (size_t i = 0; i < activeBodies.size(); ++i) {
+        activeBodies[i]->islandIndex = static_cast<int>(i);
+        awakeGrid[CellKey(activeBodies[i]->position)].push_back(activeBodies[i]);
+    }
+    
+    // Проверяем соседние ячейки 3x3x3; cellSize не меньше диаметра самого крупного тела
+    for (PhysicsBody* a : activeBodies) {
+        Vector3 base = a->position;
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    Vector3 probe(base.x + dx * cellSize, base.y + dy * cellSize, base.z + dz * cellSize);
+                    int64_t key = CellKey(probe);
+                    
+                    auto awakeIt = awakeGrid.find(key);
+                    if (awakeIt != awakeGrid.end()) {
+                        for (PhysicsBody* b : awakeIt->second) {
+                            // Каждую пару активных тел учитываем один раз
+                            if (b->islandIndex <= a->islandIndex) continue;
+                            float r = a->radius + b->radius;
+                            if ((b->position - a->position).LengthSquared() < r * r) {
+                                contacts.push_back({a, b});
+                            }
+                        }
+                    }
+                    
+                    auto restIt = restingGrid.find(key);
+                    if (restIt != restingGrid.end()) {
+                        for (PhysicsBody* b : restIt->second) {
+                            float r = a->radius + b->radius;
+                            if ((b->position - a->position).LengthSquared() < r * r) {
+                                contacts.push_back({a, b});
+                            }
+                        }
+                    }
                 }
             }
         }
     }
+    
+    // Будим спящих, которых коснулось активное тело; они присоединяются к острову
+    for (auto& c : contacts) {
+        if (c.b->sleeping) {
+            WakeBody(c.b);
+            c.b->islandIndex = static_cast<int>(activeBodies.size());
+            activeBodies.push_back(c.b);
+        }
+    }
+}
+
+void PhysicsWorld::ResolveContacts() {
+    for (auto& c : contacts) {
+        PhysicsBody* a = c.a;
+        PhysicsBody* b = c.b;
+        Vector3 delta = b->position - a->position;
+        float dist = delta.Length();
+        float penetration = a->radius + b->radius - dist;
+        if (penetration <= 0.0f) continue;
+        
+        Vector3 normal = dist > 0.0001f ? delta / dist : Vector3(0, 1, 0);
+        float invA = (a->isStatic || a->mass <= 0.0f) ? 0.0f : 1.0f / a->mass;
+        float invB = (b->isStatic || b->mass <= 0.0f) ? 0.0f : 1.0f / b->mass;
+        float invSum = invA + invB;
+        if (invSum <= 0.0f) continue;
+        
+        // Разводим тела пропорционально обратным массам
+        a->position -= normal * (penetration * invA / invSum);
+        b->position += normal * (penetration * invB / invSum);
+        
+        float vn = (b->velocity - a->velocity).Dot(normal);
+        if (vn >= 0.0f) continue;
+        float bounce = (-vn > bounceThreshold) ? restitution : 0.0f;
+        float j = -(1.0f + bounce) * vn / invSum;
+        a->velocity -= normal * (j * invA);
+        b->velocity += normal * (j * invB);
+    }
+}
+
+int PhysicsWorld::FindIsland(int i) {
+    while (islandParent[i] != i) {
+        islandParent[i] = islandParent[islandParent[i]];
+        i = islandParent[i];
+    }
+    return i;
+}
+
+void PhysicsWorld::UpdateIslands(float dt) {
+    size_t count = activeBodies.size();
+    islandParent.resize(count);
+    islandMinTimer.assign(count, timeToSleep);
+    for (size_t i = 0; i < count; ++i) {
+        islandParent[i] = static_cast<int>(i);
+    }
+    
+    // Острова строятся только по контактам двух динамических тел: статика их не связывает
+    for (auto& c : contacts) {
+        if (c.a->isStatic || c.b->isStatic) continue;
+        int ra = FindIsland(c.a->islandIndex);
+        int rb = FindIsland(c.b->islandIndex);
+        if (ra != rb) islandParent[ra] = rb;
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        PhysicsBody* body = activeBodies[i];
+        float limit = body->sleepThreshold;
+        if (body->velocity.LengthSquared() < limit * limit) {
+            body->sleepTimer += dt;
+        } else {
+            body->sleepTimer = 0.0f;
+        }
+        int root = FindIsland(static_cast<int>(i));
+        islandMinTimer[root] = std::min(islandMinTimer[root], body->sleepTimer);
+    }
+    
+    // Остров засыпает целиком, только если покоится каждое его тело
+    size_t write = 0;
+    for (size_t i = 0; i < awakeBodies.size(); ++i) {
+        PhysicsBody* body = awakeBodies[i];
+        int idx = body->islandIndex;
+        if (idx >= 0 && idx < static_cast<int>(count) && activeBodies[idx] == body &&
+            islandMinTimer[FindIsland(idx)] >= timeToSleep) {
+            SleepBody(body);
+        } else {
+            awakeBodies[write++] = body;
+        }
+    }
+    awakeBodies.resize(write);
 }
 
 PhysicsBody* PhysicsWorld::CreateBody(const Vector3& pos, float mass, bool isStatic) {
-    auto body = std::make_unique<PhysicsBody>(pos, mass, isStatic);
-    PhysicsBody* ptr = body.get();
-    bodies.push_back(std::move(body));
-    Logger::Log("PhysicsBody создан: масса=", mass, ", статический=", isStatic);
+    PhysicsBody* ptr = bodyPool.New(pos, mass, isStatic);
+    ptr->world = this;
+    cellSize = std::max(cellSize, ptr->radius * 2.0f);
+    if (isStatic) {
+        AddResting(ptr);
+    } else {
+        awakeBodies.push_back(ptr);
+    }
+    bodies.push_back(ptr);
+    BodyCountGauge().Add(1);
+    LOG_DEBUG(Physics, "PhysicsBody создан: масса=", mass, ", статический=", isStatic);
     return ptr;
 }
 
 void PhysicsWorld::DestroyBody(PhysicsBody* body) {
-    bodies.erase(
-        std::remove_if(bodies.begin(), bodies.end(),
-            [body](const std::unique_ptr<PhysicsBody>& ptr) { return ptr.get() == body; }
-        ),
-        bodies.end()
-    );
+    if (!body) return;
+    if (body->isStatic || body->sleeping) {
+        RemoveResting(body);
+    } else {
+        awakeBodies.erase(std::remove(awakeBodies.begin(), awakeBodies.end(), body), awakeBodies.end());
+    }
+    auto it = std::find(bodies.begin(), bodies.end(), body);
+    if (it == bodies.end()) return;
+    bodies.erase(it);
+    bodyPool.Delete(body);
+    BodyCountGauge().Add(-1);
 }
 
 void PhysicsWorld::Clear() {
+    awakeBodies.clear();
+    restingGrid.clear();
+    awakeGrid.clear();
+    BodyCountGauge().Add(-static_cast<int64_t>(bodies.size()));
+    for (PhysicsBody* body : bodies) bodyPool.Delete(body);
     bodies.clear();
     Logger::Log("PhysicsWorld очищен");
-}
\ No newline at end of file
+}
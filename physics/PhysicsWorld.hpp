@@ -1,15 +1,30 @@
 #pragma once
 #include "../math/Vector3.hpp"
+#include "../core/Allocators.hpp"
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+class Terrain;
+class PhysicsWorld;
 
 class PhysicsBody {
+    friend class PhysicsWorld;
 private:
     Vector3 position;
     Vector3 velocity;
     Vector3 acceleration;
     float mass;
     bool isStatic;
+    float radius = 0.5f;
+    
+    // Сон: тело, покоившееся timeToSleep секунд вместе со всем островом, не обновляется
+    PhysicsWorld* world = nullptr;
+    bool sleeping = false;
+    float sleepTimer = 0.0f;
+    float sleepThreshold = 0.05f; // м/с
+    int islandIndex = -1;         // индекс в списке активных тел на время шага
     
 public:
     PhysicsBody(const Vector3& pos = Vector3(0,0,0), float m = 1.0f, bool staticBody = false);
@@ -17,14 +32,21 @@ public:
     void Update(float dt);
     void ApplyForce(const Vector3& force);
     void ApplyImpulse(const Vector3& impulse);
+    void Wake();
     
     // Getters/Setters
     Vector3 GetPosition() const { return position; }
-    void SetPosition(const Vector3& pos) { position = pos; }
+    void SetPosition(const Vector3& pos);
     Vector3 GetVelocity() const { return velocity; }
-    void SetVelocity(const Vector3& vel) { velocity = vel; }
+    void SetVelocity(const Vector3& vel);
     float GetMass() const { return mass; }
     bool IsStatic() const { return isStatic; }
+    float GetRadius() const { return radius; }
+    void SetRadius(float r);
+    
+    bool IsSleeping() const { return sleeping; }
+    void SetSleepThreshold(float linearSpeed) { sleepThreshold = linearSpeed; }
+    float GetSleepThreshold() const { return sleepThreshold; }
     
     // Physics queries
     float GetKineticEnergy() const;
@@ -32,13 +54,60 @@ public:
 };
 
 class PhysicsWorld {
+    friend class PhysicsBody;
 private:
-    std::vector<std::unique_ptr<PhysicsBody>> bodies;
+    // Тела лежат в пуле с тегом Physics (rtgc_memory_physics_*), указатели стабильны до DestroyBody
+    ObjectPool<PhysicsBody> bodyPool{MemoryTag::Physics};
+    std::vector<PhysicsBody*> bodies;
     Vector3 gravity;
     bool enabled;
+    const Terrain* terrain = nullptr;
+    float restitution = 0.3f;
+    float friction = 0.6f;
+    float bounceThreshold = 1.0f; // ниже этой скорости удара отскока нет (покоящийся контакт)
+    float timeToSleep = 0.5f;
+    float cellSize = 2.0f;
+    
+    // Только бодрствующие динамические тела участвуют в шаге
+    std::vector<PhysicsBody*> awakeBodies;
+    
+    // Спящие и статические тела: сетка для поиска контактов с активными
+    std::unordered_map<int64_t, std::vector<PhysicsBody*>> restingGrid;
+    // Активные тела: сетка перестраивается каждый шаг
+    std::unordered_map<int64_t, std::vector<PhysicsBody*>> awakeGrid;
+    
+    // Буферы пакетного запроса высот (переиспользуются между тиками)
+    std::vector<PhysicsBody*> activeBodies;
+    std::vector<float> queryX;
+    std::vector<float> queryZ;
+    std::vector<float> groundHeights;
+    std::vector<PhysicsBody*> groundContacts;
+    std::vector<Vector3> groundNormals;
+    
+    struct ContactPair {
+        PhysicsBody* a;
+        PhysicsBody* b;
+    };
+    std::vector<ContactPair> contacts;
+    std::vector<int> islandParent;
+    std::vector<float> islandMinTimer;
+    
+    int64_t CellKey(const Vector3& pos) const;
+    void AddResting(PhysicsBody* body);
+    void RemoveResting(PhysicsBody* body);
+    void WakeBody(PhysicsBody* body);
+    void SleepBody(PhysicsBody* body);
+    void OnBodyRadiusChanged(PhysicsBody* body);
+    
+    void ResolveGroundContacts();
+    void FindContacts();
+    void ResolveContacts();
+    void UpdateIslands(float dt);
+    int FindIsland(int i);
     
 public:
     PhysicsWorld(const Vector3& grav = Vector3(0, -9.81f, 0));
+    ~PhysicsWorld();
     
     void Update(float dt);
     PhysicsBody* CreateBody(const Vector3& pos, float mass = 1.0f, bool isStatic = false);
@@ -47,6 +116,14 @@ public:
     void SetGravity(const Vector3& grav) { gravity = grav; }
     Vector3 GetGravity() const { return gravity; }
     
+    // Без ландшафта землёй считается плоскость y=0
+    void SetTerrain(const Terrain* t) { terrain = t; }
+    const Terrain* GetTerrain() const { return terrain; }
+    void SetRestitution(float r) { restitution = r; }
+    void SetFriction(float f) { friction = f; }
+    void SetTimeToSleep(float seconds) { timeToSleep = seconds; }
+    
     void Clear();
     size_t GetBodyCount() const { return bodies.size(); }
-};
\ No newline at end of file
+    size_t GetAwakeBodyCount() const { return awakeBodies.size(); }
+};
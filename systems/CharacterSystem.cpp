@@ -1,4 +1,5 @@
 #include "CharacterSystem.hpp"
+#include "../core/Logger.hpp"
 #include "../components/CharacterComponent.hpp"
 #include "../physics/CharacterController.hpp"
 #include "../game/Vehicle.hpp"
@@ -21,7 +22,7 @@ void CharacterSystem::Update(float dt, entt::registry& registry, CharacterContro
                 if (charComp.inVehicle) {
                     charComp.inVehicle = false;
                     charComp.currentVehicle = entt::null;
-                    LOG(L"Вышли из транспорта");
+                    LOG_INFO(Game, "Вышли из транспорта");
                 } else if (DistanceToVehicle(charCtrl, vehicle) < 5.0f) {
                     charComp.inVehicle = true;
                     // ИСПРАВЛЕНО: Ищем entity с VehicleComponent
@@ -29,7 +30,7 @@ void CharacterSystem::Update(float dt, entt::registry& registry, CharacterContro
                     if (!vehicle_view.empty()) {
                         charComp.currentVehicle = vehicle_view.front();
                     }
-                    LOG(L"Вошли в транспорт");
+                    LOG_INFO(Game, "Вошли в транспорт");
                 }
                 lastInteractTime = static_cast<float>(glfwGetTime());
             }
@@ -47,7 +48,7 @@ void CharacterSystem::Update(float dt, entt::registry& registry, CharacterContro
                 charComp.isAlive = true;
                 charComp.shouldRespawn = true;
                 charComp.respawnTimer = 0.0f;
-                LOG(L"Персонаж возродился");
+                LOG_INFO(Game, "Персонаж возродился");
             }
         }
     }
@@ -77,6 +78,6 @@ static void HandleMovement(float dt, CharacterController* ctrl) {
 static void HandleDamage(CharacterComponent& charComp) {
     if (charComp.health <= 0) {
         charComp.isAlive = false;
-        LOG(L"Персонаж погиб");
+        LOG_INFO(Game, "Персонаж погиб");
     }
 }
\ No newline at end of file
@@ -1,16 +1,26 @@
 #include "RenderSystem.hpp"
+#include "TransformSystem.hpp"
 
 void RenderSystem::Render(entt::registry& registry, const class Shader& shader, const glm::mat4& view, const glm::mat4& proj) {
-    auto viewable = registry.view<RenderableComponent, TransformComponent>(); // Ищем объекты с обоими компонентами
+    // Матрицы пересчитываются только для изменившихся трансформаций
+    TransformSystem::Update(registry);
+
+    // Расположение uniform одно на шейдер - не запрашиваем его для каждой сущности
+    const GLint modelLocation = glGetUniformLocation(shader.id, "uModel");
+    const TransformHierarchy& hierarchy = TransformSystem::GetHierarchy();
+    auto viewable = registry.view<RenderableComponent, TransformNodeComponent>();
     for (auto entity : viewable) {
-        auto& [r, t] = viewable.get<RenderableComponent, TransformComponent>(entity); // Получаем оба компонента
+        auto& [r, node] = viewable.get<RenderableComponent, TransformNodeComponent>(entity);
         if (r.renderable) {
-            // ИСПРАВЛЕНО: Устанавливаем матрицу модели из TransformComponent
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), t.position.ToGLM()); // Конвертируем Vector3 в glm
-            model = model * glm::toMat4(t.rotation);
-            model = glm::scale(model, t.scale.ToGLM()); // Конвертируем Vector3 в glm
-            glUniformMatrix4fv(glGetUniformLocation(shader.id, "uModel"), 1, GL_FALSE, &model[0][0]);
+            const Mat4& model = hierarchy.GetWorld(node.node); // по столбцам, как ждёт OpenGL
+            glUniformMatrix4fv(modelLocation, 1, GL_FALSE, &model.columns[0].x);
             r.renderable->Render(shader);
         }
     }
+}
+
+void RenderSystem::UploadInstanceMatrices(unsigned int buffer) {
+    const TransformHierarchy& hierarchy = TransformSystem::GetHierarchy();
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, hierarchy.GetMatrixCount() * sizeof(Mat4), hierarchy.GetMatrices(), GL_DYNAMIC_DRAW);
 }
\ No newline at end of file
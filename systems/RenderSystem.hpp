@@ -7,4 +7,7 @@ class RenderSystem {
 public:
     // ИСПРАВЛЕНО: Теперь использует TransformComponent для матрицы модели
     static void Render(entt::registry& registry, const class Shader& shader, const glm::mat4& view, const glm::mat4& proj);
+    // Мировые матрицы TransformSystem в буфер вершин для инстансинга (mat4 на экземпляр, по столбцам);
+    // индекс экземпляра сущности - TransformHierarchy::GetMatrixIndex
+    static void UploadInstanceMatrices(unsigned int buffer);
 };
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "TransformHierarchy.hpp"
+#include "../core/Logger.hpp"
+
+namespace {
+    bool SameVector(const Vector3& a, const Vector3& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+
+    bool SameQuat(const Quat& a, const Quat& b) {
+        return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+    }
+}
+
+uint32_t TransformHierarchy::Create(uint32_t parent) {
+    uint32_t handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<uint32_t>(denseIndex.size());
+        denseIndex.push_back(INVALID);
+    }
+
+    denseIndex[handle] = static_cast<uint32_t>(world.size());
+    locals.push_back(Local{});
+    parents.push_back(IsValid(parent) ? parent : INVALID);
+    handles.push_back(handle);
+    dirty.push_back(1);
+    changed.push_back(0);
+    world.push_back(Mat4::Identity());
+    orderDirty = true;
+    return handle;
+}
+
+void TransformHierarchy::Destroy(uint32_t node) {
+    if (!IsValid(node)) return;
+
+    // Дети становятся корневыми: их локальная трансформация с этого момента - мировая
+    for (size_t i = 0; i < parents.size(); ++i) {
+        if (parents[i] == node) {
+            parents[i] = INVALID;
+            dirty[i] = 1;
+        }
+    }
+
+    // Последний узел переезжает на место удалённого: буфер матриц остаётся без дыр
+    uint32_t index = denseIndex[node];
+    uint32_t last = static_cast<uint32_t>(world.size() - 1);
+    if (index != last) {
+        locals[index] = locals[last];
+        parents[index] = parents[last];
+        handles[index] = handles[last];
+        dirty[index] = dirty[last];
+        changed[index] = changed[last];
+        world[index] = world[last];
+        denseIndex[handles[index]] = index;
+    }
+    locals.pop_back();
+    parents.pop_back();
+    handles.pop_back();
+    dirty.pop_back();
+    changed.pop_back();
+    world.pop_back();
+
+    denseIndex[node] = INVALID;
+    freeHandles.push_back(node);
+    orderDirty = true;
+}
+
+bool TransformHierarchy::IsValid(uint32_t node) const {
+    return node < denseIndex.size() && denseIndex[node] != INVALID;
+}
+
+void TransformHierarchy::SetParent(uint32_t node, uint32_t parent) {
+    if (!IsValid(node)) return;
+    if (!IsValid(parent)) parent = INVALID;
+
+    uint32_t index = denseIndex[node];
+    if (parents[index] == parent) return;
+
+    for (uint32_t p = parent; p != INVALID; p = parents[denseIndex[p]]) {
+        if (p == node) {
+            LOG_WARNING(Core, "TransformHierarchy: узел ", node, " не может стать потомком самого себя");
+            return;
+        }
+    }
+
+    parents[index] = parent;
+    dirty[index] = 1;
+    orderDirty = true;
+}
+
+uint32_t TransformHierarchy::GetParent(uint32_t node) const {
+    return IsValid(node) ? parents[denseIndex[node]] : INVALID;
+}
+
+void TransformHierarchy::SetLocal(uint32_t node, const Vector3& position, const Quat& rotation, const Vector3& scale) {
+    if (!IsValid(node)) return;
+
+    Local& local = locals[denseIndex[node]];
+    if (SameVector(local.position, position) && SameQuat(local.rotation, rotation) && SameVector(local.scale, scale)) {
+        return;
+    }
+    local.position = position;
+    local.rotation = rotation;
+    local.scale = scale;
+    dirty[denseIndex[node]] = 1;
+}
+
+void TransformHierarchy::RebuildOrder() {
+    // Глубина каждого узла с запоминанием: путь до узла с известной глубиной проходится один раз
+    const uint32_t count = static_cast<uint32_t>(world.size());
+    std::vector<uint32_t> depth(count, INVALID);
+    std::vector<uint32_t> path;
+    uint32_t maxDepth = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t current = i;
+        while (depth[current] == INVALID) {
+            path.push_back(current);
+            uint32_t parent = parents[current];
+            if (parent == INVALID) break;
+            current = denseIndex[parent];
+        }
+        uint32_t d = depth[current] == INVALID ? 0 : depth[current] + 1;
+        while (!path.empty()) {
+            uint32_t node = path.back();
+            path.pop_back();
+            if (depth[node] == INVALID) depth[node] = d++;
+            else d = depth[node] + 1;
+        }
+        if (depth[i] > maxDepth) maxDepth = depth[i];
+    }
+
+    // Сортировка подсчётом по глубине: порядок внутри уровня - порядок в буфере
+    std::vector<uint32_t> offsets(maxDepth + 2, 0);
+    for (uint32_t i = 0; i < count; ++i) ++offsets[depth[i] + 1];
+    for (size_t d = 1; d < offsets.size(); ++d) offsets[d] += offsets[d - 1];
+    order.resize(count);
+    for (uint32_t i = 0; i < count; ++i) order[offsets[depth[i]]++] = i;
+    orderDirty = false;
+}
+
+size_t TransformHierarchy::Update() {
+    if (orderDirty) RebuildOrder();
+
+    size_t updated = 0;
+    for (uint32_t index : order) {
+        uint32_t parent = parents[index];
+        uint32_t parentIndex = parent == INVALID ? INVALID : denseIndex[parent];
+        bool parentChanged = parentIndex != INVALID && changed[parentIndex];
+        if (!dirty[index] && !parentChanged) {
+            changed[index] = 0;
+            continue;
+        }
+
+        const Local& local = locals[index];
+        Mat4 m = Mat4::TRS(Vec3(local.position), local.rotation, Vec3(local.scale));
+        world[index] = parentIndex == INVALID ? m : world[parentIndex] * m;
+        dirty[index] = 0;
+        changed[index] = 1;
+        ++updated;
+    }
+    lastUpdated = updated;
+    return updated;
+}
+
+const Mat4& TransformHierarchy::GetWorld(uint32_t node) const {
+    static const Mat4 identity;
+    return IsValid(node) ? world[denseIndex[node]] : identity;
+}
+
+uint32_t TransformHierarchy::GetMatrixIndex(uint32_t node) const {
+    return IsValid(node) ? denseIndex[node] : INVALID;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "../math/MathTypes.hpp"
+#include "../core/MemoryTracker.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Иерархия трансформаций без зависимости от ECS и графики: узлы с локальными TRS и родителем,
+// мировые матрицы пересчитываются только для изменённых узлов и их потомков.
+// Мировые матрицы лежат подряд (GetMatrices) - буфер готов для glBufferData под инстансинг.
+// Дескриптор узла стабилен; индекс матрицы в буфере (GetMatrixIndex) меняется при Destroy.
+//     TransformHierarchy h;
+//     uint32_t body = h.Create();
+//     uint32_t wheel = h.Create(body);
+//     h.SetLocal(wheel, Vector3(1, 0, 2), Quat(), Vector3(1, 1, 1));
+//     h.Update();
+//     const Mat4& m = h.GetWorld(wheel);
+class TransformHierarchy {
+public:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    // Новый узел с единичной трансформацией
+    uint32_t Create(uint32_t parent = INVALID);
+    // Дети уничтоженного узла становятся корневыми
+    void Destroy(uint32_t node);
+    bool IsValid(uint32_t node) const;
+
+    // Циклы не допускаются: узел не может стать потомком самого себя (такой вызов игнорируется)
+    void SetParent(uint32_t node, uint32_t parent);
+    uint32_t GetParent(uint32_t node) const;
+
+    // Узел помечается изменённым, только если значения отличаются от прежних
+    void SetLocal(uint32_t node, const Vector3& position, const Quat& rotation, const Vector3& scale);
+
+    // Пересчёт мировых матриц: родители раньше детей; возвращает число пересчитанных узлов
+    size_t Update();
+
+    const Mat4& GetWorld(uint32_t node) const;
+    uint32_t GetMatrixIndex(uint32_t node) const;
+    const Mat4* GetMatrices() const { return world.data(); }
+    size_t GetMatrixCount() const { return world.size(); }
+    size_t GetLastUpdatedCount() const { return lastUpdated; }
+
+private:
+    struct Local {
+        Vector3 position;
+        Quat rotation;
+        Vector3 scale{1.0f, 1.0f, 1.0f};
+    };
+
+    // Память иерархии идёт в rtgc_memory_ecs_*
+    template<typename T>
+    using EcsVector = std::vector<T, TaggedAllocator<T, MemoryTag::ECS>>;
+
+    // Плотные массивы, индекс - позиция матрицы в буфере
+    EcsVector<Local> locals;
+    EcsVector<uint32_t> parents;   // дескриптор родителя или INVALID
+    EcsVector<uint32_t> handles;   // дескриптор узла по плотному индексу
+    EcsVector<uint8_t> dirty;
+    EcsVector<uint8_t> changed;    // мировая матрица изменилась в текущем Update
+    EcsVector<Mat4> world;
+
+    // Дескриптор -> плотный индекс; свободные дескрипторы - в freeHandles
+    EcsVector<uint32_t> denseIndex;
+    EcsVector<uint32_t> freeHandles;
+
+    // Плотные индексы в порядке глубины; перестраивается после изменений структуры
+    EcsVector<uint32_t> order;
+    bool orderDirty = false;
+    size_t lastUpdated = 0;
+
+    void RebuildOrder();
+};
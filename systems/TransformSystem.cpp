@@ -0,0 +1,73 @@
+#include "TransformSystem.hpp"
+#include <vector>
+
+TransformHierarchy TransformSystem::hierarchy;
+entt::registry* TransformSystem::attachedRegistry = nullptr;
+
+void TransformSystem::OnNodeDestroyed(entt::registry& registry, entt::entity entity) {
+    hierarchy.Destroy(registry.get<TransformNodeComponent>(entity).node);
+}
+
+size_t TransformSystem::Update(entt::registry& registry) {
+    if (attachedRegistry != &registry) {
+        // Прежний реестр мог быть уже уничтожен - к нему не обращаемся
+        hierarchy = TransformHierarchy();
+        registry.clear<TransformNodeComponent>();
+        // Узел освобождается вместе с компонентом, в том числе при уничтожении сущности
+        registry.on_destroy<TransformNodeComponent>().connect<&TransformSystem::OnNodeDestroyed>();
+        attachedRegistry = &registry;
+    }
+
+    // Структурные изменения - вне обхода видов, которые они бы инвалидировали
+    std::vector<entt::entity> pending;
+    auto orphaned = registry.view<TransformNodeComponent>(entt::exclude<TransformComponent>);
+    pending.assign(orphaned.begin(), orphaned.end());
+    for (entt::entity entity : pending) registry.remove<TransformNodeComponent>(entity);
+
+    auto added = registry.view<TransformComponent>(entt::exclude<TransformNodeComponent>);
+    pending.assign(added.begin(), added.end());
+    for (entt::entity entity : pending) {
+        registry.emplace<TransformNodeComponent>(entity, TransformNodeComponent{hierarchy.Create()});
+    }
+
+    auto nodes = registry.view<TransformComponent, TransformNodeComponent>();
+    for (auto entity : nodes) {
+        const auto& t = nodes.get<TransformComponent>(entity);
+        uint32_t node = nodes.get<TransformNodeComponent>(entity).node;
+        hierarchy.SetLocal(node, t.position, t.rotation, t.scale);
+
+        uint32_t parentNode = TransformHierarchy::INVALID;
+        if (const auto* link = registry.try_get<TransformParentComponent>(entity)) {
+            if (registry.valid(link->parent)) {
+                if (const auto* parent = registry.try_get<TransformNodeComponent>(link->parent)) parentNode = parent->node;
+            }
+        }
+        hierarchy.SetParent(node, parentNode);
+    }
+
+    return hierarchy.Update();
+}
+
+void TransformSystem::ShiftOrigin(entt::registry& registry, const Vector3& shift) {
+    auto transforms = registry.view<TransformComponent>();
+    for (auto entity : transforms) {
+        if (const auto* link = registry.try_get<TransformParentComponent>(entity)) {
+            if (registry.valid(link->parent) && registry.try_get<TransformComponent>(link->parent)) continue;
+        }
+        transforms.get<TransformComponent>(entity).position -= shift;
+    }
+}
+
+const Mat4& TransformSystem::GetWorldMatrix(const entt::registry& registry, entt::entity entity) {
+    const auto* node = registry.try_get<TransformNodeComponent>(entity);
+    return hierarchy.GetWorld(node ? node->node : TransformHierarchy::INVALID);
+}
+
+void TransformSystem::Reset() {
+    if (attachedRegistry) {
+        attachedRegistry->on_destroy<TransformNodeComponent>().disconnect<&TransformSystem::OnNodeDestroyed>();
+        attachedRegistry->clear<TransformNodeComponent>();
+        attachedRegistry = nullptr;
+    }
+    hierarchy = TransformHierarchy();
+}
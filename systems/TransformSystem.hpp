@@ -0,0 +1,37 @@
+#pragma once
+#include <entt/entt.hpp>
+#include "../components/TransformComponent.hpp"
+#include "../components/TransformParentComponent.hpp"
+#include "TransformHierarchy.hpp"
+
+// Узел иерархии сущности; создаётся и удаляется TransformSystem
+struct TransformNodeComponent {
+    uint32_t node = TransformHierarchy::INVALID;
+};
+
+// Мировые матрицы сущностей с TransformComponent (и TransformParentComponent для вложенных).
+// Update сверяет компоненты с иерархией и пересчитывает только изменившиеся трансформации и их потомков;
+// статичные сущности после первого кадра матрицы не пересчитывают.
+// Без OpenGL: шаг обновления проверяется и замеряется на CPU.
+class TransformSystem {
+    static TransformHierarchy hierarchy;
+    static entt::registry* attachedRegistry;
+
+    static void OnNodeDestroyed(entt::registry& registry, entt::entity entity);
+
+public:
+    // Возвращает число пересчитанных матриц
+    static size_t Update(entt::registry& registry);
+
+    // Единичная матрица, если у сущности ещё нет узла (Update не вызывался)
+    static const Mat4& GetWorldMatrix(const entt::registry& registry, entt::entity entity);
+    // Перенос начала координат (WorldOrigin): сдвигаются только корневые сущности,
+    // вложенные заданы относительно родителя и следуют за ним
+    static void ShiftOrigin(entt::registry& registry, const Vector3& shift);
+
+    // Все мировые матрицы подряд - для загрузки в буфер инстансинга
+    static const TransformHierarchy& GetHierarchy() { return hierarchy; }
+
+    // Отключает реестр и очищает иерархию; вызывать, пока реестр ещё жив (смена уровня, выход)
+    static void Reset();
+};
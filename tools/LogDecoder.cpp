@@ -0,0 +1,53 @@
+// Восстанавливает текстовый лог из бинарного (.rtlog).
+// Вывод совпадает с тем, что записал бы текстовый логгер.
+// Запуск: LogDecoder log_XXXX.rtlog [выход.txt]
+#include "../core/LogFormat.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Использование: %s <лог.rtlog> [выход.txt]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "Не удалось открыть %s\n", argv[1]);
+        return 1;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::FILE* out = stdout;
+    if (argc > 2) {
+        out = std::fopen(argv[2], "wb");
+        if (!out) {
+            std::fprintf(stderr, "Не удалось создать %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    BinaryLogDecoder decoder;
+    LogTextFormatter formatter;
+    std::string line;
+    size_t textBytes = 0;
+    bool ok = decoder.Decode(data.data(), data.size(), [&](const BinaryLogDecoder::Message& m) {
+        line.clear();
+        formatter.AppendLine(line, m.timeUs, m.threadId, m.level, m.category, m.args, m.argsSize);
+        std::fwrite(line.data(), 1, line.size(), out);
+        textBytes += line.size();
+    });
+
+    if (out != stdout) std::fclose(out);
+
+    double ratio = data.empty() ? 0.0 : static_cast<double>(textBytes) / static_cast<double>(data.size());
+    std::fprintf(stderr, "Сообщений: %zu, бинарный размер: %zu байт, текст: %zu байт (x%.1f)\n",
+                 decoder.GetDecodedCount(), data.size(), textBytes, ratio);
+    if (!ok) {
+        std::fprintf(stderr, "Файл повреждён или обрезан после сообщения %zu\n", decoder.GetDecodedCount());
+        return 2;
+    }
+    return 0;
+}
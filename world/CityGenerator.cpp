@@ -21,5 +21,5 @@ void CityGenerator::Generate() {
         b.type = (type == 0) ? "house" : (type == 1) ? "shop" : "factory";
         buildings.push_back(b);
     }
-    LOG(L"Город сгенерирован: " + std::to_wstring(buildings.size()) + L" зданий");
+    LOG_INFO(World, "Город сгенерирован: ", buildings.size(), " зданий");
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "OSMParser.hpp"
+#include "WorldOrigin.hpp"
 #include <sstream>
 #include <string>
 #include <cmath> // для cos
@@ -19,7 +20,7 @@ std::vector<std::pair<glm::vec3, glm::vec3>> OSMParser::ParseRoadsFromXML(const
         if (latPos == std::string::npos || lonPos == std::string::npos) break;
         double lat = std::stod(xmlData.substr(latPos + 5));
         double lon = std::stod(xmlData.substr(lonPos + 5));
-        nodes[id] = {lat, lon, static_cast<float>(lonToX(lon)), static_cast<float>(latToY(lat))};
+        nodes[id] = {lat, lon, lonToX(lon), latToY(lat)};
         pos += 20;
     }
 
@@ -43,14 +44,14 @@ std::vector<std::pair<glm::vec3, glm::vec3>> OSMParser::ParseRoadsFromXML(const
             auto it1 = nodes.find(refs[i]);
             auto it2 = nodes.find(refs[i + 1]);
             if (it1 != nodes.end() && it2 != nodes.end()) {
-                roads.emplace_back(
-                    glm::vec3(it1->second.x, 0, it1->second.z),
-                    glm::vec3(it2->second.x, 0, it2->second.z)
-                );
+                // Перевод в float только после вычитания начала координат
+                Vector3 a = WorldOrigin::ToLocal(WorldPosition(it1->second.x, 0.0, it1->second.z));
+                Vector3 b = WorldOrigin::ToLocal(WorldPosition(it2->second.x, 0.0, it2->second.z));
+                roads.emplace_back(glm::vec3(a.x, 0, a.z), glm::vec3(b.x, 0, b.z));
             }
         }
         pos = endWay;
     }
-    LOG(L"Дороги из OSM загружены");
+    LOG_INFO(World, "Дороги из OSM загружены");
     return roads;
 }
\ No newline at end of file
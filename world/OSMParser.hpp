@@ -7,12 +7,13 @@
 
 struct OSMNode {
     double lat, lon;
-    float x, z;
+    double x, z; // метры в мире: на широтах Сибири это миллионы, float здесь теряет метры
 };
 
 class OSMParser {
     static double latToY(double lat);
     static double lonToX(double lon);
 public:
+    // Отрезки дорог в локальных координатах относительно текущего WorldOrigin
     static std::vector<std::pair<glm::vec3, glm::vec3>> ParseRoadsFromXML(const std::string& xmlData);
 };
\ No newline at end of file
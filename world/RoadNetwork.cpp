@@ -4,7 +4,7 @@ RoadNetwork::RoadNetwork(float width) : roadWidth(width) {}
 
 void RoadNetwork::Generate(const std::vector<std::pair<glm::vec3, glm::vec3>>& inputRoads) {
     roads = inputRoads; // Просто сохраняем переданные дороги
-    LOG(L"Сеть дорог сгенерирована: " + std::to_wstring(roads.size()) + L" сегментов");
+    LOG_INFO(World, "Сеть дорог сгенерирована: ", roads.size(), " сегментов");
 }
 
 void RoadNetwork::Render() {
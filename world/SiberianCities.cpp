@@ -15,21 +15,21 @@ SiberianCities::~SiberianCities() {
 void SiberianCities::InitializeDefaultCities() {
     m_cities.clear();
     
-    m_cities.push_back({"Novosibirsk", Vector3(100.0f, 100.0f, 0.0f), 1600000.0f, -5.0f});
-    m_cities.push_back({"Krasnoyarsk", Vector3(80.0f, 80.0f, 0.0f), 1100000.0f, -8.0f});
-    m_cities.push_back({"Irkutsk", Vector3(60.0f, 120.0f, 0.0f), 620000.0f, -10.0f});
-    m_cities.push_back({"Tomsk", Vector3(40.0f, 140.0f, 0.0f), 580000.0f, -6.0f});
-    m_cities.push_back({"Omsk", Vector3(20.0f, 160.0f, 0.0f), 1200000.0f, -7.0f});
-    m_cities.push_back({"Barnaul", Vector3(20.0f, 200.0f, 0.0f), 630000.0f, -5.0f});
-    m_cities.push_back({"Kemerovo", Vector3(40.0f, 220.0f, 0.0f), 550000.0f, -6.0f});
-    m_cities.push_back({"Novokuznetsk", Vector3(60.0f, 240.0f, 0.0f), 520000.0f, -7.0f});
-    m_cities.push_back({"Norilsk", Vector3(80.0f, 280.0f, 0.0f), 180000.0f, -15.0f});
-    m_cities.push_back({"Chita", Vector3(100.0f, 260.0f, 0.0f), 350000.0f, -12.0f});
-    m_cities.push_back({"Abakan", Vector3(120.0f, 300.0f, 0.0f), 170000.0f, -4.0f});
-    m_cities.push_back({"Dudinka", Vector3(140.0f, 320.0f, 0.0f), 25000.0f, -18.0f});
-    m_cities.push_back({"Nazarovosibirsk", Vector3(120.0f, 340.0f, 0.0f), 120000.0f, -5.0f});
-    m_cities.push_back({"Tayshet", Vector3(160.0f, 360.0f, 0.0f), 38000.0f, -9.0f});
-    m_cities.push_back({"Ulan-Ude", Vector3(180.0f, 380.0f, 0.0f), 440000.0f, -11.0f});
+    m_cities.push_back({"Novosibirsk", WorldPosition(100.0, 100.0, 0.0), 1600000.0f, -5.0f});
+    m_cities.push_back({"Krasnoyarsk", WorldPosition(80.0, 80.0, 0.0), 1100000.0f, -8.0f});
+    m_cities.push_back({"Irkutsk", WorldPosition(60.0, 120.0, 0.0), 620000.0f, -10.0f});
+    m_cities.push_back({"Tomsk", WorldPosition(40.0, 140.0, 0.0), 580000.0f, -6.0f});
+    m_cities.push_back({"Omsk", WorldPosition(20.0, 160.0, 0.0), 1200000.0f, -7.0f});
+    m_cities.push_back({"Barnaul", WorldPosition(20.0, 200.0, 0.0), 630000.0f, -5.0f});
+    m_cities.push_back({"Kemerovo", WorldPosition(40.0, 220.0, 0.0), 550000.0f, -6.0f});
+    m_cities.push_back({"Novokuznetsk", WorldPosition(60.0, 240.0, 0.0), 520000.0f, -7.0f});
+    m_cities.push_back({"Norilsk", WorldPosition(80.0, 280.0, 0.0), 180000.0f, -15.0f});
+    m_cities.push_back({"Chita", WorldPosition(100.0, 260.0, 0.0), 350000.0f, -12.0f});
+    m_cities.push_back({"Abakan", WorldPosition(120.0, 300.0, 0.0), 170000.0f, -4.0f});
+    m_cities.push_back({"Dudinka", WorldPosition(140.0, 320.0, 0.0), 25000.0f, -18.0f});
+    m_cities.push_back({"Nazarovosibirsk", WorldPosition(120.0, 340.0, 0.0), 120000.0f, -5.0f});
+    m_cities.push_back({"Tayshet", WorldPosition(160.0, 360.0, 0.0), 38000.0f, -9.0f});
+    m_cities.push_back({"Ulan-Ude", WorldPosition(180.0, 380.0, 0.0), 440000.0f, -11.0f});
     
     Logger::Log("Initialized ", m_cities.size(), " Siberian cities");
     m_loaded = true;
@@ -45,7 +45,7 @@ void SiberianCities::Update(float dt) {
 }
 
 const City& SiberianCities::GetCity(int index) const {
-    static const City emptyCity = {"Unknown", Vector3(0, 0, 0), 0.0f, 0.0f};
+    static const City emptyCity = {"Unknown", WorldPosition(), 0.0f, 0.0f};
     
     if (index < 0 || index >= static_cast<int>(m_cities.size())) {
         return emptyCity;
@@ -74,7 +74,7 @@ float SiberianCities::GetDistanceBetweenCities(int cityA, int cityB) const {
         return 0.0f;
     }
     
-    return m_cities[cityA].position.Distance(m_cities[cityB].position);
+    return static_cast<float>(m_cities[cityA].position.Distance(m_cities[cityB].position));
 }
 
 void SiberianCities::PrintCityList() const {
@@ -1,11 +1,11 @@
 #pragma once
-#include "../math/Vector3.hpp"
+#include "WorldOrigin.hpp"
 #include <vector>
 #include <string>
 
 struct City {
     std::string name;
-    Vector3 position;
+    WorldPosition position; // в масштабе всей карты float не хватает точности
     float population;
     float temperature;
 };
@@ -1,14 +1,15 @@
 #include "Terrain.hpp"
 #include "../core/Logger.hpp"
 #include <random>
+#include <cmath>
 
 Terrain::Terrain() {
     heights.resize(width * depth, 0.0f);
 }
 
-void Terrain::Initialize() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
+void Terrain::Initialize(uint32_t seed) {
+    if (seed == 0) seed = std::random_device{}();
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<> dis(0.0, 1.0);
     
     for (int z = 0; z < depth; ++z) {
@@ -31,49 +32,106 @@ void Terrain::Update(float dt) {
     // Static terrain doesn't need updates
 }
 
+size_t Terrain::GetVertexFloatCount() const {
+    if (width < 2 || depth < 2) return 0;
+    return static_cast<size_t>(width - 1) * static_cast<size_t>(depth - 1) * 18;
+}
+
 void Terrain::GetVertices(std::vector<float>& vertices) const {
-    vertices.clear();
-    
+    vertices.resize(GetVertexFloatCount());
+    WriteVertices(vertices.data());
+}
+
+void Terrain::GetVertices(std::pmr::vector<float>& vertices) const {
+    vertices.resize(GetVertexFloatCount());
+    WriteVertices(vertices.data());
+}
+
+void Terrain::WriteVertices(float* out) const {
     for (int z = 0; z < depth - 1; ++z) {
         for (int x = 0; x < width - 1; ++x) {
-            float x1 = static_cast<float>(x) - width / 2.0f;
-            float z1 = static_cast<float>(z) - depth / 2.0f;
-            float y1 = heights[z * width + x] * 2.0f;
+            float x1 = static_cast<float>(x) - width / 2.0f + originX;
+            float z1 = static_cast<float>(z) - depth / 2.0f + originZ;
+            float y1 = heights[z * width + x] * heightScale;
             
-            float x2 = static_cast<float>(x + 1) - width / 2.0f;
-            float z2 = static_cast<float>(z) - depth / 2.0f;
-            float y2 = heights[z * width + (x + 1)] * 2.0f;
+            float x2 = static_cast<float>(x + 1) - width / 2.0f + originX;
+            float z2 = static_cast<float>(z) - depth / 2.0f + originZ;
+            float y2 = heights[z * width + (x + 1)] * heightScale;
             
-            float x3 = static_cast<float>(x) - width / 2.0f;
-            float z3 = static_cast<float>(z + 1) - depth / 2.0f;
-            float y3 = heights[(z + 1) * width + x] * 2.0f;
+            float x3 = static_cast<float>(x) - width / 2.0f + originX;
+            float z3 = static_cast<float>(z + 1) - depth / 2.0f + originZ;
+            float y3 = heights[(z + 1) * width + x] * heightScale;
             
-            float x4 = static_cast<float>(x + 1) - width / 2.0f;
-            float z4 = static_cast<float>(z + 1) - depth / 2.0f;
-            float y4 = heights[(z + 1) * width + (x + 1)] * 2.0f;
+            float x4 = static_cast<float>(x + 1) - width / 2.0f + originX;
+            float z4 = static_cast<float>(z + 1) - depth / 2.0f + originZ;
+            float y4 = heights[(z + 1) * width + (x + 1)] * heightScale;
             
             // Triangle 1
-            vertices.push_back(x1); vertices.push_back(y1); vertices.push_back(z1);
-            vertices.push_back(x2); vertices.push_back(y2); vertices.push_back(z2);
-            vertices.push_back(x3); vertices.push_back(y3); vertices.push_back(z3);
+            *out++ = x1; *out++ = y1; *out++ = z1;
+            *out++ = x2; *out++ = y2; *out++ = z2;
+            *out++ = x3; *out++ = y3; *out++ = z3;
             
             // Triangle 2
-            vertices.push_back(x2); vertices.push_back(y2); vertices.push_back(z2);
-            vertices.push_back(x4); vertices.push_back(y4); vertices.push_back(z4);
-            vertices.push_back(x3); vertices.push_back(y3); vertices.push_back(z3);
+            *out++ = x2; *out++ = y2; *out++ = z2;
+            *out++ = x4; *out++ = y4; *out++ = z4;
+            *out++ = x3; *out++ = y3; *out++ = z3;
         }
     }
 }
 
-float Terrain::GetHeightAt(float x, float z) const {
-    int gridX = static_cast<int>(x + width / 2.0f);
-    int gridZ = static_cast<int>(z + depth / 2.0f);
+inline float Terrain::SampleHeight(float x, float z) const {
+    float gx = (x - originX) + width / 2.0f;
+    float gz = (z - originZ) + depth / 2.0f;
     
-    if (gridX < 0 || gridX >= width || gridZ < 0 || gridZ >= depth) {
+    if (gx < 0.0f || gz < 0.0f || gx > static_cast<float>(width - 1) || gz > static_cast<float>(depth - 1)) {
         return 0.0f;
     }
     
-    return heights[gridZ * width + gridX] * 2.0f;
+    int x0 = static_cast<int>(gx);
+    int z0 = static_cast<int>(gz);
+    int x1 = x0 + 1 < width ? x0 + 1 : x0;
+    int z1 = z0 + 1 < depth ? z0 + 1 : z0;
+    float fx = gx - static_cast<float>(x0);
+    float fz = gz - static_cast<float>(z0);
+    
+    float h00 = heights[z0 * width + x0];
+    float h10 = heights[z0 * width + x1];
+    float h01 = heights[z1 * width + x0];
+    float h11 = heights[z1 * width + x1];
+    
+    float h0 = h00 + (h10 - h00) * fx;
+    float h1 = h01 + (h11 - h01) * fx;
+    return (h0 + (h1 - h0) * fz) * heightScale;
+}
+
+float Terrain::GetHeightAt(float x, float z) const {
+    return SampleHeight(x, z);
+}
+
+Vector3 Terrain::GetNormalAt(float x, float z) const {
+    // Центральные разности с шагом в одну ячейку сетки
+    float dx = SampleHeight(x + 1.0f, z) - SampleHeight(x - 1.0f, z);
+    float dz = SampleHeight(x, z + 1.0f) - SampleHeight(x, z - 1.0f);
+    return Vector3(-dx * 0.5f, 1.0f, -dz * 0.5f).Normalize();
+}
+
+void Terrain::GetHeightsAt(const float* xs, const float* zs, float* outHeights, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        outHeights[i] = SampleHeight(xs[i], zs[i]);
+    }
+}
+
+void Terrain::GetNormalsAt(const float* xs, const float* zs, Vector3* outNormals, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        float dx = SampleHeight(xs[i] + 1.0f, zs[i]) - SampleHeight(xs[i] - 1.0f, zs[i]);
+        float dz = SampleHeight(xs[i], zs[i] + 1.0f) - SampleHeight(xs[i], zs[i] - 1.0f);
+        outNormals[i] = Vector3(-dx * 0.5f, 1.0f, -dz * 0.5f).Normalize();
+    }
+}
+
+void Terrain::ShiftOrigin(const Vector3& shift) {
+    originX -= shift.x;
+    originZ -= shift.z;
 }
 
 Terrain::~Terrain() {
@@ -1,18 +1,45 @@
 #pragma once
 #include "../math/Vector3.hpp"
+#include "../core/MemoryTracker.hpp"
 #include <vector>
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
 
 class Terrain {
 private:
-    std::vector<float> heights;
+    std::vector<float, TaggedAllocator<float, MemoryTag::Terrain>> heights;
     int width = 64;
     int depth = 64;
+    float heightScale = 2.0f;
+    // Центр карты в локальных координатах (WorldOrigin). Сдвиги кратны WorldOrigin::REBASE_STEP
+    // и точно представимы во float, поэтому смещение не копит ошибку.
+    float originX = 0.0f;
+    float originZ = 0.0f;
+
+    // Билинейная выборка высоты; вне карты - плоскость y=0
+    float SampleHeight(float x, float z) const;
+    // Два треугольника на клетку, по 3 float на вершину
+    size_t GetVertexFloatCount() const;
+    void WriteVertices(float* out) const;
     
 public:
     Terrain();
-    void Initialize();
+    // Одинаковое зерно - одинаковый рельеф (воспроизведение сессий, Replay::GetSeed); 0 - случайный
+    void Initialize(uint32_t seed = 0);
     void Update(float dt);
+    // Размер известен заранее: один resize без роста по ходу заполнения.
+    // pmr-вариант - для временной памяти кадра (FrameArena::GetResource()).
     void GetVertices(std::vector<float>& vertices) const;
+    void GetVertices(std::pmr::vector<float>& vertices) const;
     float GetHeightAt(float x, float z) const;
+    Vector3 GetNormalAt(float x, float z) const;
+
+    // Пакетные запросы для физики: один вызов на все тела за тик
+    void GetHeightsAt(const float* xs, const float* zs, float* outHeights, size_t count) const;
+    void GetNormalsAt(const float* xs, const float* zs, Vector3* outNormals, size_t count) const;
+
+    // Перенос начала координат: карта остаётся на своём месте в мире
+    void ShiftOrigin(const Vector3& shift);
     ~Terrain();
 };
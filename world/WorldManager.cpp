@@ -1,11 +1,18 @@
 #include "WorldManager.hpp"
 #include "../core/Logger.hpp"
+#include "../core/Metrics.hpp"
 #include <sstream>
 #include <algorithm>
 #include <cstdint>
 
 static uint32_t nextObjectID = 1;
 
+// Объекты во всех мирах
+static MetricGauge& ObjectCountGauge() {
+    static MetricGauge& gauge = Metrics::GetGauge("rtgc_world_objects", "GameObject во всех мирах");
+    return gauge;
+}
+
 GameObject::GameObject(const std::string& objName) 
     : name(objName), active(true), id(nextObjectID++) {
     position = Vector3(0, 0, 0);
@@ -35,6 +42,10 @@ World::World(const std::string& worldName) : name(worldName), active(true) {
     Logger::Log("World создан: ", name);
 }
 
+World::~World() {
+    ObjectCountGauge().Add(-static_cast<int64_t>(objects.size()));
+}
+
 void World::Update(float dt) {
     if (!active) return;
     
@@ -59,20 +70,24 @@ GameObject* World::CreateObject(const std::string& objName) {
     auto obj = std::make_unique<GameObject>(objName);
     GameObject* ptr = obj.get();
     objects.push_back(std::move(obj));
-    Logger::Log("GameObject создан в мире '", name, "': ", objName);
+    ObjectCountGauge().Add(1);
+    LOG_DEBUG(World, "GameObject создан в мире '", name, "': ", objName);
     return ptr;
 }
 
 void World::DestroyObject(GameObject* obj) {
     if (!obj) return;
     
+    std::string objName = obj->GetName();
+    size_t before = objects.size();
     objects.erase(
         std::remove_if(objects.begin(), objects.end(),
             [obj](const std::unique_ptr<GameObject>& ptr) { return ptr.get() == obj; }
         ),
         objects.end()
     );
-    Logger::Log("GameObject уничтожен в мире '", name, "': ", obj->GetName());
+    ObjectCountGauge().Add(-static_cast<int64_t>(before - objects.size()));
+    LOG_DEBUG(World, "GameObject уничтожен в мире '", name, "': ", objName);
 }
 
 void World::DestroyObject(uint32_t objId) {
@@ -97,13 +112,18 @@ GameObject* World::FindObject(uint32_t objId) {
     return nullptr;
 }
 
-std::vector<GameObject*> World::FindObjectsByTag(const std::string& tag) {
-    std::vector<GameObject*> result;
-    // В реальной реализации здесь был бы поиск по тегам
+std::pmr::vector<GameObject*> World::FindObjectsByTag(std::string_view tag, std::pmr::memory_resource* memory) {
+    std::pmr::vector<GameObject*> result(memory);
+    for (auto& obj : objects) {
+        if (obj && obj->GetTag() == tag) {
+            result.push_back(obj.get());
+        }
+    }
     return result;
 }
 
 void World::Clear() {
+    ObjectCountGauge().Add(-static_cast<int64_t>(objects.size()));
     objects.clear();
     Logger::Log("World '", name, "' очищен");
 }
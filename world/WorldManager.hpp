@@ -2,7 +2,9 @@
 #include "../math/Vector3.hpp"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
 #include <cstdint>
 
 class GameObject {
@@ -11,6 +13,7 @@ private:
     Vector3 rotation;
     Vector3 scale;
     std::string name;
+    std::string tag;
     bool active;
     uint32_t id;
     
@@ -32,6 +35,8 @@ public:
     // Properties
     std::string GetName() const { return name; }
     void SetName(const std::string& objName) { name = objName; }
+    const std::string& GetTag() const { return tag; }
+    void SetTag(const std::string& objTag) { tag = objTag; }
     bool IsActive() const { return active; }
     void SetActive(bool act) { active = act; }
     uint32_t GetID() const { return id; }
@@ -48,7 +53,7 @@ private:
     
 public:
     World(const std::string& worldName = "World");
-    ~World() = default;
+    ~World();
     
     void Update(float dt);
     void Render();
@@ -59,7 +64,9 @@ public:
     
     GameObject* FindObject(const std::string& name);
     GameObject* FindObject(uint32_t id);
-    std::vector<GameObject*> FindObjectsByTag(const std::string& tag);
+    // Результат в памяти memory; для временного списка на кадр - FrameArena::GetResource()
+    std::pmr::vector<GameObject*> FindObjectsByTag(std::string_view tag,
+                                                   std::pmr::memory_resource* memory = std::pmr::get_default_resource());
     
     void Clear();
     size_t GetObjectCount() const { return objects.size(); }
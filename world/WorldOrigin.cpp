@@ -0,0 +1,94 @@
+#include "WorldOrigin.hpp"
+#include "../core/Logger.hpp"
+#include <utility>
+#include <vector>
+
+namespace {
+    struct OriginState {
+        WorldPosition origin;
+        double rebaseDistance = WorldOrigin::DEFAULT_REBASE_DISTANCE;
+        std::vector<std::pair<int, WorldOrigin::Listener>> listeners;
+        int nextListenerId = 1;
+        uint64_t rebaseCount = 0;
+    };
+
+    OriginState& GetState() {
+        static OriginState state;
+        return state;
+    }
+
+    double SnapToStep(double value) {
+        return std::round(value / WorldOrigin::REBASE_STEP) * WorldOrigin::REBASE_STEP;
+    }
+}
+
+const WorldPosition& WorldOrigin::Get() {
+    return GetState().origin;
+}
+
+Vector3 WorldOrigin::ToLocal(const WorldPosition& position) {
+    const WorldPosition& origin = GetState().origin;
+    // Разность в double: точность теряется только у далёких от начала точек, где она не нужна
+    return Vector3(static_cast<float>(position.x - origin.x),
+                   static_cast<float>(position.y - origin.y),
+                   static_cast<float>(position.z - origin.z));
+}
+
+WorldPosition WorldOrigin::ToWorld(const Vector3& local) {
+    const WorldPosition& origin = GetState().origin;
+    return WorldPosition(origin.x + local.x, origin.y + local.y, origin.z + local.z);
+}
+
+void WorldOrigin::SetRebaseDistance(double meters) {
+    GetState().rebaseDistance = meters > REBASE_STEP ? meters : REBASE_STEP;
+}
+
+double WorldOrigin::GetRebaseDistance() {
+    return GetState().rebaseDistance;
+}
+
+int WorldOrigin::AddListener(Listener listener) {
+    OriginState& s = GetState();
+    int id = s.nextListenerId++;
+    s.listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void WorldOrigin::RemoveListener(int id) {
+    auto& listeners = GetState().listeners;
+    for (auto it = listeners.begin(); it != listeners.end(); ++it) {
+        if (it->first == id) {
+            listeners.erase(it);
+            return;
+        }
+    }
+}
+
+bool WorldOrigin::Update(const Vector3& focus) {
+    double limit = GetState().rebaseDistance;
+    if (std::fabs(focus.x) <= limit && std::fabs(focus.z) <= limit) return false;
+    RebaseTo(ToWorld(focus));
+    return true;
+}
+
+void WorldOrigin::RebaseTo(const WorldPosition& position) {
+    OriginState& s = GetState();
+    WorldPosition target(SnapToStep(position.x), s.origin.y, SnapToStep(position.z));
+    Vector3 shift(static_cast<float>(target.x - s.origin.x), 0.0f, static_cast<float>(target.z - s.origin.z));
+    if (shift.x == 0.0f && shift.z == 0.0f) return;
+
+    s.origin = target;
+    ++s.rebaseCount;
+    LOG_DEBUG(World, "Начало координат перенесено в (", target.x, ", ", target.z, "), сдвиг ", shift.x, ", ", shift.z);
+    for (auto& listener : s.listeners) listener.second(shift);
+}
+
+void WorldOrigin::Reset(const WorldPosition& origin) {
+    OriginState& s = GetState();
+    s.origin = origin;
+    s.rebaseCount = 0;
+}
+
+uint64_t WorldOrigin::GetRebaseCount() {
+    return GetState().rebaseCount;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "../math/Vector3.hpp"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+// Позиция в мире с двойной точностью: карты Сибири - тысячи километров,
+// а у float на 10 км шаг уже около миллиметра, на 1000 км - шесть сантиметров.
+struct WorldPosition {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+
+    WorldPosition() = default;
+    WorldPosition(double x, double y, double z) : x(x), y(y), z(z) {}
+
+    double Distance(const WorldPosition& other) const {
+        double dx = x - other.x;
+        double dy = y - other.y;
+        double dz = z - other.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+};
+
+// Плавающее начало координат. Симуляция и рендер работают во float относительно начала (локальные
+// координаты); когда фокус (игрок, камера) уходит от начала дальше порога, начало переносится к нему,
+// и все подписчики сдвигают свои локальные координаты на одну и ту же величину:
+//     int id = WorldOrigin::AddListener([&](const Vector3& shift) { terrain.ShiftOrigin(shift); });
+//     ...
+//     WorldOrigin::Update(character.GetPosition()); // раз за тик, после симуляции
+// Сдвиг кратен REBASE_STEP: он точно представим во float, поэтому вычитание не копит ошибку,
+// а сетки (ландшафт, пространственные хэши) остаются выровненными. По вертикали начало не сдвигается.
+// Вызывать из главного потока.
+class WorldOrigin {
+public:
+    // Смещение локальных координат: новая локальная позиция = старая - shift
+    using Listener = std::function<void(const Vector3& shift)>;
+
+    static constexpr double DEFAULT_REBASE_DISTANCE = 2048.0; // м по горизонтали
+    static constexpr double REBASE_STEP = 256.0;              // м
+
+    static const WorldPosition& Get();
+    static Vector3 ToLocal(const WorldPosition& position);
+    static WorldPosition ToWorld(const Vector3& local);
+
+    static void SetRebaseDistance(double meters);
+    static double GetRebaseDistance();
+
+    static int AddListener(Listener listener);
+    static void RemoveListener(int id);
+
+    // Переносит начало, если фокус (в локальных координатах) дальше порога. true - перенос был
+    static bool Update(const Vector3& focus);
+    // Перенос в заданную точку (телепорт на другой конец карты); точка округляется до REBASE_STEP
+    static void RebaseTo(const WorldPosition& position);
+    // Начало в точку без уведомлений - до создания объектов (новая сессия, загрузка мира)
+    static void Reset(const WorldPosition& origin = WorldPosition());
+
+    static uint64_t GetRebaseCount();
+};
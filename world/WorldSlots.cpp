@@ -1,8 +1,12 @@
 #include "WorldSlots.hpp"
+#include "../core/BinaryStream.hpp"
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
+#include <ctime>
+#include <filesystem>
 
 #if defined(_WIN32)
 #include <direct.h>
@@ -12,74 +16,251 @@
 #define MKDIR(x) mkdir(x, 0777)
 #endif
 
+namespace {
+    const char* CATALOG_FILE = "save/world_slots.bin";
+    const char* LEGACY_FILE = "save/world_slots.txt";
+    const char* THUMBS_FILE = "save/world_thumbs.bin";
+
+    constexpr uint32_t CATALOG_MAGIC = 0x53575452; // "RTWS"
+    constexpr uint16_t CATALOG_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 16;
+    constexpr size_t RECORD_SIZE = 256;
+    constexpr size_t NAME_BYTES = 127;
+    constexpr size_t REGION_BYTES = 31;
+
+    // Header: magic, version, record size, slot count, reserved
+    void WriteHeader(ByteWriter& w, uint32_t count) {
+        w.Write<uint32_t>(CATALOG_MAGIC);
+        w.Write<uint16_t>(CATALOG_VERSION);
+        w.Write<uint16_t>(static_cast<uint16_t>(RECORD_SIZE));
+        w.Write<uint32_t>(count);
+        w.Write<uint32_t>(0);
+    }
+
+    // Fixed-size string field: length byte + bytes, cut on a UTF-8 character boundary
+    void WriteFixedString(ByteWriter& w, const std::string& s, size_t capacity) {
+        size_t len = s.size() < capacity ? s.size() : capacity;
+        while (len > 0 && len < s.size() && (static_cast<uint8_t>(s[len]) & 0xC0) == 0x80) --len;
+        char buffer[256] = {};
+        std::memcpy(buffer, s.data(), len);
+        w.Write<uint8_t>(static_cast<uint8_t>(len));
+        w.WriteBytes(buffer, capacity);
+    }
+
+    std::string ReadFixedString(ByteReader& r, size_t capacity) {
+        uint8_t len = r.Read<uint8_t>();
+        char buffer[256] = {};
+        r.ReadBytes(buffer, capacity);
+        if (len > capacity) len = static_cast<uint8_t>(capacity);
+        return std::string(buffer, len);
+    }
+
+    template<typename E>
+    E ReadEnum(ByteReader& r, E maxValue, E fallback) {
+        uint8_t v = r.Read<uint8_t>();
+        return v <= static_cast<uint8_t>(maxValue) ? static_cast<E>(v) : fallback;
+    }
+
+    void EncodeRecord(std::vector<uint8_t>& out, const WorldSlotsManager::WorldSlot& s) {
+        size_t start = out.size();
+        ByteWriter w(out);
+        const WorldConfig::WorldSettings& ws = s.settings;
+        w.Write<uint8_t>(static_cast<uint8_t>((s.used ? 1 : 0) | (s.procedural ? 2 : 0) | (s.isRealWorld ? 4 : 0)));
+        w.Write<uint8_t>(static_cast<uint8_t>(ws.mapSize));
+        w.Write<uint8_t>(static_cast<uint8_t>(ws.terrainType));
+        w.Write<uint8_t>(static_cast<uint8_t>(ws.climateType));
+        w.Write<uint8_t>(static_cast<uint8_t>(ws.season));
+        w.Write<uint8_t>(ws.generateRoads ? 1 : 0);
+        w.Write<uint8_t>(ws.generateVegetation ? 1 : 0);
+        w.Write<uint8_t>(0);
+        w.Write<int32_t>(ws.seed);
+        w.Write<float>(ws.scale);
+        w.Write<float>(ws.cityDensity);
+        w.Write<float>(ws.waterLevel);
+        w.Write<float>(ws.mountainHeight);
+        w.Write<uint64_t>(s.cacheHash);
+        w.Write<uint64_t>(s.thumbnailOffset);
+        w.Write<uint32_t>(s.thumbnailSize);
+        w.Write<int64_t>(s.createdTime);
+        w.Write<int64_t>(s.modifiedTime);
+        WriteFixedString(w, ws.worldName, NAME_BYTES);
+        WriteFixedString(w, s.regionCode, REGION_BYTES);
+        out.resize(start + RECORD_SIZE, 0);
+    }
+
+    WorldSlotsManager::WorldSlot DecodeRecord(const uint8_t* data) {
+        using namespace WorldConfig;
+        ByteReader r(data, RECORD_SIZE);
+        WorldSlotsManager::WorldSlot s;
+        WorldSettings& ws = s.settings;
+        uint8_t flags = r.Read<uint8_t>();
+        s.used = (flags & 1) != 0;
+        s.procedural = (flags & 2) != 0;
+        s.isRealWorld = (flags & 4) != 0;
+        ws.mapSize = ReadEnum(r, MapSize::HUGE, MapSize::MEDIUM);
+        ws.terrainType = ReadEnum(r, TerrainType::MIXED, TerrainType::MIXED);
+        ws.climateType = ReadEnum(r, ClimateType::HOT, ClimateType::COLD);
+        ws.season = ReadEnum(r, Season::AUTUMN, Season::WINTER);
+        ws.generateRoads = r.Read<uint8_t>() != 0;
+        ws.generateVegetation = r.Read<uint8_t>() != 0;
+        r.Skip(1);
+        ws.seed = r.Read<int32_t>();
+        ws.scale = r.Read<float>();
+        ws.cityDensity = r.Read<float>();
+        ws.waterLevel = r.Read<float>();
+        ws.mountainHeight = r.Read<float>();
+        s.cacheHash = r.Read<uint64_t>();
+        s.thumbnailOffset = r.Read<uint64_t>();
+        s.thumbnailSize = r.Read<uint32_t>();
+        s.createdTime = r.Read<int64_t>();
+        s.modifiedTime = r.Read<int64_t>();
+        ws.worldName = ReadFixedString(r, NAME_BYTES);
+        s.regionCode = ReadFixedString(r, REGION_BYTES);
+        return s;
+    }
+
+    int64_t Now() {
+        return static_cast<int64_t>(std::time(nullptr));
+    }
+
+    WorldSlotsManager::WorldSlot MakeEmptySlot(int idx) {
+        WorldSlotsManager::WorldSlot slot;
+        slot.settings.worldName = "World " + std::to_string(idx + 1);
+        return slot;
+    }
+}
+
 WorldSlotsManager::WorldSlotsManager() {
     LoadFromDisk();
 }
 
 void WorldSlotsManager::LoadFromDisk() {
     MKDIR("save");
-    std::ifstream fin("save/world_slots.txt");
-    if (!fin) {
-        for (int i = 0; i < SLOT_COUNT; ++i) {
-            m_slots[i] = WorldSlot();
-            m_slots[i].worldName = "World " + std::to_string(i + 1);
-            m_slots[i].used = false;
-            m_slots[i].procedural = true;
-            m_slots[i].seed = 0;
-            m_slots[i].scale = 1.0f;
-            m_slots[i].regionCode = "";
-            m_slots[i].isRealWorld = false;
-        }
-        SaveToDisk();
-        return;
+    if (LoadCatalog()) return;
+
+    // One-time migration from the old pipe-delimited format
+    if (!ImportLegacyText()) ResetToDefaults();
+    SaveToDisk();
+}
+
+bool WorldSlotsManager::LoadCatalog() {
+    std::ifstream fin(CATALOG_FILE, std::ios::binary);
+    if (!fin) return false;
+
+    uint8_t headerBytes[HEADER_SIZE];
+    if (!fin.read(reinterpret_cast<char*>(headerBytes), HEADER_SIZE)) return false;
+    ByteReader header(headerBytes, HEADER_SIZE);
+    uint32_t magic = header.Read<uint32_t>();
+    uint16_t version = header.Read<uint16_t>();
+    uint16_t recordSize = header.Read<uint16_t>();
+    uint32_t count = header.Read<uint32_t>();
+    if (magic != CATALOG_MAGIC || version != CATALOG_VERSION || recordSize != RECORD_SIZE ||
+        count > static_cast<uint32_t>(MAX_SLOT_COUNT)) {
+        return false;
+    }
+
+    // Whole index is read in one go: count * 256 bytes, no per-world files opened
+    std::vector<uint8_t> records(count * RECORD_SIZE);
+    if (count > 0 && !fin.read(reinterpret_cast<char*>(records.data()), records.size())) return false;
+
+    m_slots.clear();
+    m_slots.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        m_slots.push_back(DecodeRecord(records.data() + i * RECORD_SIZE));
     }
+    return true;
+}
 
+bool WorldSlotsManager::ImportLegacyText() {
+    std::ifstream fin(LEGACY_FILE);
+    if (!fin) return false;
+
+    m_slots.clear();
     std::string line;
-    int idx = 0;
-    while (std::getline(fin, line) && idx < SLOT_COUNT) {
+    while (std::getline(fin, line) && m_slots.size() < static_cast<size_t>(MAX_SLOT_COUNT)) {
         if (line.empty()) continue;
         if (line.find("Slot") != 0) continue;
         std::vector<std::string> parts;
         std::stringstream ss(line);
         std::string token;
         while (std::getline(ss, token, '|')) parts.push_back(token);
-        WorldSlot slot;
+        WorldSlot slot = MakeEmptySlot(static_cast<int>(m_slots.size()));
         if (parts.size() >= 8) {
-            slot.worldName = parts[1];
+            try {
+                slot.settings.seed = std::stoi(parts[4]);
+                slot.settings.scale = std::stof(parts[5]);
+            } catch (...) {
+                slot.settings.seed = 0;
+                slot.settings.scale = 1.0f;
+            }
+            slot.settings.worldName = parts[1];
             slot.used = (parts[2] == "1");
             slot.procedural = (parts[3] == "1");
-            slot.seed = std::stoi(parts[4]);
-            slot.scale = std::stof(parts[5]);
             slot.regionCode = parts[6];
             slot.isRealWorld = (parts[7] == "1");
         }
-        m_slots[idx++] = slot;
+        m_slots.push_back(slot);
     }
 
-    for (; idx < SLOT_COUNT; ++idx) {
-        WorldSlot slot;
-        slot.worldName = "World " + std::to_string(idx + 1);
-        slot.used = false;
-        slot.procedural = true;
-        slot.seed = 0;
-        slot.scale = 1.0f;
-        slot.regionCode = "";
-        slot.isRealWorld = false;
-        m_slots[idx] = slot;
+    while (m_slots.size() < static_cast<size_t>(DEFAULT_SLOT_COUNT)) {
+        m_slots.push_back(MakeEmptySlot(static_cast<int>(m_slots.size())));
+    }
+    return true;
+}
+
+void WorldSlotsManager::ResetToDefaults() {
+    m_slots.clear();
+    for (int i = 0; i < DEFAULT_SLOT_COUNT; ++i) {
+        m_slots.push_back(MakeEmptySlot(i));
     }
 }
 
 void WorldSlotsManager::SaveToDisk() const {
     MKDIR("save");
-    std::ofstream fout("save/world_slots.txt");
-    if (!fout) return;
+    std::vector<uint8_t> buffer;
+    buffer.reserve(HEADER_SIZE + m_slots.size() * RECORD_SIZE);
+    ByteWriter w(buffer);
+    WriteHeader(w, static_cast<uint32_t>(m_slots.size()));
+    for (const WorldSlot& s : m_slots) EncodeRecord(buffer, s);
+
+    // Write to a temp file and rename, so a crash never leaves a half-written catalog
+    std::string tempName = std::string(CATALOG_FILE) + ".tmp";
+    {
+        std::ofstream fout(tempName, std::ios::binary | std::ios::trunc);
+        if (!fout) return;
+        fout.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+        if (!fout) return;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempName, CATALOG_FILE, ec);
+    if (ec) std::filesystem::remove(tempName, ec);
+}
+
+void WorldSlotsManager::SaveSlot(int idx) const {
+    if (idx < 0 || idx >= GetSlotCount()) return;
 
-    for (int i = 0; i < SLOT_COUNT; ++i) {
-        const WorldSlot& s = m_slots[i];
-        fout << "Slot" << (i + 1) << "|" << s.worldName << "|" << (s.used ? "1" : "0")
-             << "|" << (s.procedural ? "1" : "0") << "|" << s.seed << "|" << s.scale
-             << "|" << s.regionCode << "|" << (s.isRealWorld ? "1" : "0") << "\n";
+    std::fstream file(CATALOG_FILE, std::ios::binary | std::ios::in | std::ios::out);
+    uint8_t headerBytes[HEADER_SIZE];
+    if (!file || !file.read(reinterpret_cast<char*>(headerBytes), HEADER_SIZE)) {
+        SaveToDisk();
+        return;
     }
+    ByteReader header(headerBytes, HEADER_SIZE);
+    uint32_t magic = header.Read<uint32_t>();
+    uint16_t version = header.Read<uint16_t>();
+    uint16_t recordSize = header.Read<uint16_t>();
+    uint32_t count = header.Read<uint32_t>();
+    if (magic != CATALOG_MAGIC || version != CATALOG_VERSION || recordSize != RECORD_SIZE ||
+        count != static_cast<uint32_t>(m_slots.size())) {
+        file.close();
+        SaveToDisk();
+        return;
+    }
+
+    std::vector<uint8_t> record;
+    EncodeRecord(record, m_slots[idx]);
+    file.seekp(static_cast<std::streamoff>(HEADER_SIZE + static_cast<size_t>(idx) * RECORD_SIZE));
+    file.write(reinterpret_cast<const char*>(record.data()), record.size());
 }
 
 const WorldSlotsManager::WorldSlot& WorldSlotsManager::GetSlot(int idx) const {
@@ -91,20 +272,88 @@ WorldSlotsManager::WorldSlot& WorldSlotsManager::GetSlot(int idx) {
 }
 
 void WorldSlotsManager::CreateSlot(int idx, const std::string& name) {
-    if (idx < 0 || idx >= SLOT_COUNT) return;
+    if (idx < 0 || idx >= MAX_SLOT_COUNT) return;
+    bool grown = idx >= GetSlotCount();
+    while (idx >= GetSlotCount()) m_slots.push_back(MakeEmptySlot(GetSlotCount()));
+
     WorldSlot& s = m_slots[idx];
+    s = WorldSlot();
     s.used = true;
-    s.worldName = name;
-    s.procedural = true;
-    s.seed = idx * 1337; // simple default seed per slot
-    s.scale = 1.0f;
-    s.isRealWorld = false;
-    s.regionCode = "";
-    SaveToDisk();
+    s.settings.worldName = name;
+    s.settings.seed = idx * 1337; // simple default seed per slot
+    s.settings.scale = 1.0f;
+    s.createdTime = Now();
+    s.modifiedTime = s.createdTime;
+    if (grown) SaveToDisk();
+    else SaveSlot(idx);
+}
+
+int WorldSlotsManager::AddSlot(const std::string& name) {
+    // Reuse the first free slot before growing the catalog
+    for (int i = 0; i < GetSlotCount(); ++i) {
+        if (!m_slots[i].used) {
+            CreateSlot(i, name);
+            return i;
+        }
+    }
+    int idx = GetSlotCount();
+    if (idx >= MAX_SLOT_COUNT) return -1;
+    CreateSlot(idx, name);
+    return idx;
+}
+
+void WorldSlotsManager::ClearSlot(int idx) {
+    if (idx < 0 || idx >= GetSlotCount()) return;
+    m_slots[idx] = MakeEmptySlot(idx);
+    SaveSlot(idx);
 }
 
 std::string WorldSlotsManager::GetSlotDisplay(int idx) const {
     const WorldSlot& s = m_slots[idx];
     if (!s.used) return "Slot " + std::to_string(idx + 1) + ": (Empty)";
-    return "Slot " + std::to_string(idx + 1) + ": " + s.worldName;
+    return "Slot " + std::to_string(idx + 1) + ": " + s.settings.worldName;
+}
+
+void WorldSlotsManager::SetGenerated(int idx, const WorldConfig::WorldSettings& settings, uint64_t cacheHash) {
+    if (idx < 0 || idx >= GetSlotCount()) return;
+    WorldSlot& s = m_slots[idx];
+    s.used = true;
+    s.settings = settings;
+    s.cacheHash = cacheHash;
+    s.modifiedTime = Now();
+    SaveSlot(idx);
+}
+
+bool WorldSlotsManager::SetThumbnail(int idx, const void* data, uint32_t size) {
+    if (idx < 0 || idx >= GetSlotCount() || !data || size == 0) return false;
+    MKDIR("save");
+
+    // Append-only blob: the old thumbnail stays as garbage, the record points to the new one
+    std::ofstream fout(THUMBS_FILE, std::ios::binary | std::ios::app);
+    if (!fout) return false;
+    fout.seekp(0, std::ios::end);
+    std::streamoff offset = fout.tellp();
+    fout.write(static_cast<const char*>(data), size);
+    if (!fout || offset < 0) return false;
+    fout.close();
+
+    m_slots[idx].thumbnailOffset = static_cast<uint64_t>(offset);
+    m_slots[idx].thumbnailSize = size;
+    m_slots[idx].modifiedTime = Now();
+    SaveSlot(idx);
+    return true;
+}
+
+bool WorldSlotsManager::LoadThumbnail(int idx, std::vector<uint8_t>& out) const {
+    out.clear();
+    if (!HasThumbnail(idx)) return false;
+    std::ifstream fin(THUMBS_FILE, std::ios::binary);
+    if (!fin) return false;
+    fin.seekg(static_cast<std::streamoff>(m_slots[idx].thumbnailOffset));
+    out.resize(m_slots[idx].thumbnailSize);
+    if (!fin.read(reinterpret_cast<char*>(out.data()), out.size())) {
+        out.clear();
+        return false;
+    }
+    return true;
 }
@@ -1,41 +1,67 @@
 #pragma once
 #include <string>
-#include <array>
+#include <vector>
+#include <cstdint>
+#include "WorldConfig.hpp"
 
-// Lightweight storage for up to 5 world slots (MVP warmup).
-// Each slot can be either empty or hold a world definition (name + minimal meta).
+// Catalog of world slots stored in save/world_slots.bin.
+// The file is a small header followed by fixed-size records, one per slot, so the menu
+// can list every slot (and a single slot can be rewritten in place) without touching
+// any world data. Thumbnails live in a separate append-only blob, referenced by offset.
 
 class WorldSlotsManager {
 public:
     struct WorldSlot {
-        std::string worldName;
         bool used;
         bool procedural; // whether this world is procedurally generated
-        int seed;
-        float scale; // 1.0f means 1 unit == 1 meter
         bool isRealWorld; // placeholder flag for real-world data source
         std::string regionCode; // e.g., OSM region code, used for future real data
+        WorldConfig::WorldSettings settings; // full creation settings (name, seed, scale, ...)
+        uint64_t cacheHash; // hash of the generated cities, roads and vegetation, 0 = not generated yet
+        uint64_t thumbnailOffset; // offset in save/world_thumbs.bin
+        uint32_t thumbnailSize; // 0 = no thumbnail
+        int64_t createdTime; // unix seconds
+        int64_t modifiedTime;
 
-        WorldSlot() : worldName(""), used(false), procedural(true), seed(0), scale(1.0f), isRealWorld(false), regionCode("") {}
+        WorldSlot() : used(false), procedural(true), isRealWorld(false), regionCode(""),
+                      cacheHash(0), thumbnailOffset(0), thumbnailSize(0), createdTime(0), modifiedTime(0) {}
     };
 
-    static constexpr int SLOT_COUNT = 5;
+    static constexpr int DEFAULT_SLOT_COUNT = 5;
+    static constexpr int MAX_SLOT_COUNT = 4096;
 
     WorldSlotsManager();
 
     void LoadFromDisk();
     void SaveToDisk() const;
+    // Rewrites one record in place; falls back to SaveToDisk if the catalog layout changed
+    void SaveSlot(int idx) const;
 
     const WorldSlot& GetSlot(int idx) const;
     WorldSlot& GetSlot(int idx);
 
-    bool IsSlotUsed(int idx) const { return (idx >= 0 && idx < SLOT_COUNT) ? m_slots[idx].used : false; }
+    bool IsSlotUsed(int idx) const { return (idx >= 0 && idx < GetSlotCount()) ? m_slots[idx].used : false; }
     void CreateSlot(int idx, const std::string& name);
+    int AddSlot(const std::string& name);
+    void ClearSlot(int idx);
 
-    int GetSlotCount() const { return SLOT_COUNT; }
+    int GetSlotCount() const { return static_cast<int>(m_slots.size()); }
 
     std::string GetSlotDisplay(int idx) const;
 
+    // Stores the settings the world was actually generated with (seed included) and its hash
+    void SetGenerated(int idx, const WorldConfig::WorldSettings& settings, uint64_t cacheHash);
+
+    // Preview image bytes (format is up to the caller); the menu checks HasThumbnail
+    // from the catalog alone and reads the blob only for slots it actually shows
+    bool SetThumbnail(int idx, const void* data, uint32_t size);
+    bool HasThumbnail(int idx) const { return (idx >= 0 && idx < GetSlotCount()) && m_slots[idx].thumbnailSize != 0; }
+    bool LoadThumbnail(int idx, std::vector<uint8_t>& out) const;
+
 private:
-    std::array<WorldSlot, SLOT_COUNT> m_slots;
+    std::vector<WorldSlot> m_slots;
+
+    bool LoadCatalog();
+    bool ImportLegacyText();
+    void ResetToDefaults();
 };